@@ -6,11 +6,16 @@
 #include <cmath>
 #include <expected>
 #include <chrono>
+#include <concepts>
 #include <iostream>
+#include <iterator>
+#include <array>
+#include <cstddef>
 #include <unordered_set>
 #include <climits>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <unordered_map>
 #include <utility>
 
@@ -45,6 +50,18 @@ struct Edge {
 
 using Graph = vector<vector<Edge>>;
 
+/**
+ * Anything indexable by vertex whose adjacency lists iterate as Edges.
+ * Graph, CsrGraph and SymmetricGraph (graph_views.hpp) are instantiated in
+ * duan_sssp.cpp.
+ */
+template <typename G>
+concept GraphLike = requires(const G& g, int u) {
+    { g.size() } -> std::convertible_to<std::size_t>;
+    { *std::begin(g[u]) } -> std::convertible_to<const Edge&>;
+    std::end(g[u]);
+};
+
 struct Params {
     int k;
     int t;
@@ -115,53 +132,114 @@ inline bool try_relax(Labels& labels, int u, int v, long double new_dist) {
 
 using KeyValuePair = std::pair<int, long double>;
 
+/**
+ * Size-class free-list pool for small container nodes. Freed nodes go back on
+ * their class's list in O(1); chunks are only returned upstream by release().
+ */
+class NodePool : public std::pmr::memory_resource {
+public:
+    explicit NodePool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream) {}
+    ~NodePool() override { release(); }
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void release();
+
+private:
+    static constexpr std::size_t GRANULARITY = 16;
+    static constexpr std::size_t SMALL_LIMIT = 256;
+    static constexpr std::size_t SMALL_CLASSES = SMALL_LIMIT / GRANULARITY;
+    static constexpr std::size_t MAX_POOLED_SIZE = 16 * 1024;
+    static constexpr std::size_t SIZE_CLASSES = SMALL_CLASSES + 6;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    struct FreeNode { FreeNode* next; };
+    struct alignas(GRANULARITY) ChunkHeader { ChunkHeader* next; };
+
+    std::pmr::memory_resource* upstream_;
+    std::array<FreeNode*, SIZE_CLASSES> free_lists_{};
+    ChunkHeader* chunks_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* chunk_end_ = nullptr;
+
+    static std::size_t size_class_of(std::size_t bytes);
+    static std::size_t class_size(std::size_t size_class);
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 struct Block {
-    std::list<KeyValuePair> elements;
+    using allocator_type = std::pmr::polymorphic_allocator<KeyValuePair>;
+    std::pmr::vector<KeyValuePair> elements;
     long double upper_bound;
-    Block() : upper_bound(INF) {}
-    explicit Block(long double ub) : upper_bound(ub) {}
+    explicit Block(const allocator_type& alloc = {}) : elements(alloc), upper_bound(INF) {}
+    explicit Block(long double ub, const allocator_type& alloc = {}) : elements(alloc), upper_bound(ub) {}
+    Block(const Block& other, const allocator_type& alloc)
+        : elements(other.elements, alloc), upper_bound(other.upper_bound) {}
+    Block(Block&& other, const allocator_type& alloc)
+        : elements(std::move(other.elements), alloc), upper_bound(other.upper_bound) {}
+    Block(const Block&) = default;
+    Block(Block&&) = default;
+    Block& operator=(const Block&) = default;
+    Block& operator=(Block&&) = default;
     int size() const { return elements.size(); }
     bool empty() const { return elements.empty(); }
 };
 
+/**
+ * Block and element nodes are allocated from a per-instance pool by default, so
+ * Insert/BatchPrepend reuse freed nodes instead of hitting the global heap, and
+ * Initialize hands the whole pool back at once. Callers that keep one resource
+ * per recursion level (or want to count allocations) can pass their own.
+ */
 class PartialOrderDS {
 public:
-    PartialOrderDS() : M_(0), B_(INF), total_inserts_(0) {}
+    PartialOrderDS() : PartialOrderDS(nullptr) {}
+    explicit PartialOrderDS(std::pmr::memory_resource* resource);
+    PartialOrderDS(const PartialOrderDS&) = delete;
+    PartialOrderDS& operator=(const PartialOrderDS&) = delete;
     void Initialize(int M, long double B);
     void Insert(int key, long double value);
     void BatchPrepend(const vector<KeyValuePair>& L);
     std::pair<vector<int>, long double> Pull();
-    bool empty() const {
-        for (const auto& block : D0_) if (!block.empty()) return false;
-        for (const auto& block : D1_) if (!block.empty()) return false;
-        return true;
-    }
+    bool empty() const { return key_locations_.empty(); }
     int total_elements() const;
 private:
-    std::list<Block> D0_;
-    std::list<Block> D1_;
-    std::map<long double, std::list<Block>::iterator> D1_bounds_;
+    using ElementVector = std::pmr::vector<KeyValuePair>;
+    using BlockList = std::pmr::list<Block>;
+
+    NodePool pool_;
+    std::pmr::memory_resource* resource_;
+    BlockList D0_;
+    BlockList D1_;
+    std::pmr::map<long double, BlockList::iterator> D1_bounds_;
     struct ElementLocation {
         int sequence_id;
-        std::list<Block>::iterator block_it;
-        std::list<KeyValuePair>::iterator elem_it;
+        BlockList::iterator block_it;
+        size_t index;
     };
-    std::unordered_map<int, ElementLocation> key_locations_;
+    std::pmr::unordered_map<int, ElementLocation> key_locations_;
     int M_;
     long double B_;
     int total_inserts_;
 
+    void ReleaseStorage();
     void Delete(int key, const ElementLocation& loc);
-    void SplitBlock(std::list<Block>::iterator block_it);
-    long double FindMedian(std::list<KeyValuePair>& elements);
-    std::pair<Block, Block> PartitionByMedian(std::list<KeyValuePair>& elements, long double median);
-    std::list<Block> CreateBlocksFromList(vector<KeyValuePair>& L);
-    std::list<Block>::iterator FindBlockForValue(long double value);
-    void UpdateKeyLocation(int key, int seq_id, std::list<Block>::iterator block_it, std::list<KeyValuePair>::iterator elem_it);
+    void RemoveEmptyBlock(int sequence_id, BlockList::iterator block_it);
+    void SplitBlock(BlockList::iterator block_it);
+    ElementVector::iterator PartitionByMedian(ElementVector& elements);
+    BlockList CreateBlocksFromList(vector<KeyValuePair>& L);
+    void AppendBlocks(BlockList& blocks, vector<KeyValuePair>::iterator first,
+                      vector<KeyValuePair>::iterator last, size_t max_block_size);
+    BlockList::iterator FindBlockForValue(long double value);
+    void UpdateKeyLocation(int key, int seq_id, BlockList::iterator block_it, size_t index);
+    void UpdateBlockLocations(int seq_id, BlockList::iterator block_it);
     void RemoveKeyLocation(int key);
-    std::pair<vector<KeyValuePair>, std::list<Block>::iterator> CollectPrefix(std::list<Block>& sequence, int target_size);
-    void RebuildD1Bounds();
-    void RebuildKeyLocations();
+    std::pair<vector<KeyValuePair>, BlockList::iterator> CollectPrefix(BlockList& sequence, int target_size);
     long double ComputeMinRemainingValue() const;
 };
 
@@ -169,34 +247,38 @@ struct BaseCaseResult {
     long double b;
     vector<int> U;
 };
+template <GraphLike G>
 std::expected<BaseCaseResult, DuanError> execute_base_case(
-    const Graph& graph, Labels& labels, long double B, const vector<int>& S, int k);
+    const G& graph, Labels& labels, long double B, const vector<int>& S, int k);
 
 struct FindPivotsResult {
     vector<int> P;
     vector<int> W;
 };
+template <GraphLike G>
 FindPivotsResult execute_find_pivots(
-    const Graph& graph, Labels& labels, long double B, const vector<int>& S, int k);
+    const G& graph, Labels& labels, long double B, const vector<int>& S, int k);
 
 struct BMSSPResult {
     long double b;
     vector<int> U;
 };
+template <GraphLike G>
 BMSSPResult execute_bmssp(
-    const Graph& graph, Labels& labels, int l, long double B, const vector<int>& S, const Params& params);
+    const G& graph, Labels& labels, int l, long double B, const vector<int>& S, const Params& params);
 
 struct DuanStats {
     size_t edge_relaxations = 0;
     size_t ds_inserts = 0;
     size_t ds_batch_prepends = 0;
     size_t ds_pulls = 0;
+    size_t ds_pull_scanned = 0;
     size_t bmssp_calls = 0;
     size_t max_recursion_depth = 0;
     std::chrono::microseconds total_time{0};
     void reset() {
         edge_relaxations = 0; ds_inserts = 0; ds_batch_prepends = 0;
-        ds_pulls = 0; bmssp_calls = 0; max_recursion_depth = 0;
+        ds_pulls = 0; ds_pull_scanned = 0; bmssp_calls = 0; max_recursion_depth = 0;
         total_time = std::chrono::microseconds{0};
     }
     void print() const {
@@ -205,6 +287,7 @@ struct DuanStats {
         std::cout << "DS Inserts:           " << ds_inserts << "\n";
         std::cout << "DS BatchPrepends:     " << ds_batch_prepends << "\n";
         std::cout << "DS Pulls:             " << ds_pulls << "\n";
+        std::cout << "DS Pull scanned:      " << ds_pull_scanned << "\n";
         std::cout << "BMSSP calls:          " << bmssp_calls << "\n";
         std::cout << "Max recursion depth:  " << max_recursion_depth << "\n";
         std::cout << "Total time:           " << total_time.count() << " us\n";
@@ -220,8 +303,10 @@ struct DuanSSSPResult {
     DuanStats stats;
 };
 
-DuanSSSPResult compute_sssp(const Graph& graph, int source, bool collect_stats = false);
-vector<long double> compute_dijkstra_sssp(const Graph& graph, int source);
+template <GraphLike G>
+DuanSSSPResult compute_sssp(const G& graph, int source, bool collect_stats = false);
+template <GraphLike G>
+vector<long double> compute_dijkstra_sssp(const G& graph, int source);
 
 }
 #endif
@@ -0,0 +1,115 @@
+#ifndef GRAPH_VIEWS_HPP
+#define GRAPH_VIEWS_HPP
+
+#include "duan_sssp.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace duan {
+
+/**
+ * Compressed sparse row adjacency: one contiguous edge array plus offsets.
+ * Adjacency lists come back as spans, so it is a drop-in GraphLike.
+ */
+class CsrGraph {
+public:
+    CsrGraph() : offsets_(1, 0) {}
+
+    // Copies the forward adjacency into CSR form
+    static CsrGraph from_graph(const Graph& graph);
+    // In-edges of every vertex (edge.to is the original source), built with
+    // `threads` workers (0: hardware concurrency)
+    static CsrGraph reversed(const Graph& graph, int threads = 0);
+
+    std::size_t size() const { return offsets_.size() - 1; }
+    std::size_t edge_count() const { return edges_.size(); }
+    std::span<const Edge> operator[](int u) const {
+        return {edges_.data() + offsets_[u], edges_.data() + offsets_[u + 1]};
+    }
+
+private:
+    vector<std::size_t> offsets_;
+    vector<Edge> edges_;
+};
+
+/**
+ * Iterates two adjacency spans back to back without materialising them.
+ */
+class UnionAdjacency {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Edge;
+        using pointer = const Edge*;
+        using reference = const Edge&;
+
+        iterator() = default;
+        iterator(const Edge* current, const Edge* first_end, const Edge* second_begin)
+            : current_(current), first_end_(first_end), second_begin_(second_begin) {}
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return current_; }
+
+        iterator& operator++() {
+            if (++current_ == first_end_) current_ = second_begin_;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const { return current_ == other.current_; }
+
+    private:
+        const Edge* current_ = nullptr;
+        const Edge* first_end_ = nullptr;
+        const Edge* second_begin_ = nullptr;
+    };
+
+    UnionAdjacency(std::span<const Edge> first, std::span<const Edge> second)
+        : first_(first), second_(second) {}
+
+    iterator begin() const {
+        const Edge* start = first_.empty() ? second_.data() : first_.data();
+        return {start, first_.data() + first_.size(), second_.data()};
+    }
+    iterator end() const {
+        const Edge* stop = second_.data() + second_.size();
+        return {stop, nullptr, nullptr};
+    }
+    std::size_t size() const { return first_.size() + second_.size(); }
+
+private:
+    std::span<const Edge> first_;
+    std::span<const Edge> second_;
+};
+
+/**
+ * Undirected view: out-edges from the forward graph followed by in-edges
+ * from a reverse CSR. Neither is copied; both must outlive the view.
+ */
+class SymmetricGraph {
+public:
+    SymmetricGraph(const Graph& forward, const CsrGraph& reverse)
+        : forward_(&forward), reverse_(&reverse) {}
+
+    std::size_t size() const { return forward_->size(); }
+    UnionAdjacency operator[](int u) const {
+        return {std::span<const Edge>((*forward_)[u]), (*reverse_)[u]};
+    }
+
+private:
+    const Graph* forward_;
+    const CsrGraph* reverse_;
+};
+
+}
+#endif
@@ -0,0 +1,53 @@
+#ifndef NUMA_SSSP_HPP
+#define NUMA_SSSP_HPP
+
+#include "duan_sssp.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace duan {
+
+/**
+ * CPUs grouped by NUMA node, read from /sys/devices/system/node. Machines
+ * without that interface report a single node holding every CPU.
+ */
+struct NumaTopology {
+    vector<vector<int>> node_cpus;
+
+    int node_count() const { return static_cast<int>(node_cpus.size()); }
+
+    static NumaTopology detect();
+    // Splits the detected CPUs round-robin into `nodes` groups, for exercising
+    // the partitioned path on a single-node box (e.g. under numactl)
+    static NumaTopology simulate(int nodes);
+};
+
+struct NumaOptions {
+    int partitions = 0;          // 0: one partition per NUMA node
+    int simulated_nodes = 0;     // >0: use NumaTopology::simulate(simulated_nodes)
+    long double delta = 0.0L;    // bucket width; 0: mean edge weight
+    bool pin_threads = true;
+};
+
+struct NumaSSSPResult {
+    vector<long double> dist;
+    vector<int> pred;
+    int partitions = 0;
+    size_t edge_relaxations = 0;
+    size_t remote_messages = 0;
+    std::chrono::microseconds total_time{0};
+};
+
+/**
+ * Bulk-synchronous delta-stepping over a graph split into vertex ranges.
+ * Each partition owns a CSR slice plus the dist/pred labels for its range,
+ * built by its own thread after pinning so first-touch places the pages on
+ * that thread's node. Relaxations that cross into another range are queued
+ * per destination and delivered in batches at each round's barrier.
+ */
+NumaSSSPResult compute_numa_sssp(const Graph& graph, int source, const NumaOptions& options = {});
+
+}
+#endif
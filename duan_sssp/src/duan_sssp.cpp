@@ -1,9 +1,11 @@
 
 #include "../include/duan_sssp.hpp"
+#include "../include/graph_views.hpp"
 #include <queue>
 #include <algorithm>
 #include <cmath>
 #include <stack>
+#include <bit>
 
 namespace duan {
 
@@ -14,7 +16,12 @@ bool g_collect_stats = false;
 // Helper functions
 // ---------------------------------------------------------
 
-static void relax_layer(const Graph& graph, Labels& labels, long double B,
+static bool value_less(const KeyValuePair& a, const KeyValuePair& b) {
+    return a.second < b.second;
+}
+
+template <GraphLike G>
+static void relax_layer(const G& graph, Labels& labels, long double B,
                         const vector<int>& W_prev, std::unordered_set<int>& W_next) {
     for (int u : W_prev) {
         if (u < 0 || u >= (int)graph.size()) continue;
@@ -30,8 +37,9 @@ static void relax_layer(const Graph& graph, Labels& labels, long double B,
     }
 }
 
+template <GraphLike G>
 static std::unordered_map<int, vector<int>> build_forest(
-    const Graph& graph, const Labels& labels, const std::unordered_set<int>& W_set) {
+    const G& graph, const Labels& labels, const std::unordered_set<int>& W_set) {
     std::unordered_map<int, vector<int>> forest;
     for (int u : W_set) {
         if (u < 0 || u >= (int)graph.size()) continue;
@@ -91,8 +99,9 @@ static vector<int> identify_pivots(const vector<int>& S, const std::unordered_ma
     return pivots;
 }
 
+template <GraphLike G>
 static void relax_and_classify(
-    const Graph& graph, Labels& labels, const vector<int>& U_i, long double b_i,
+    const G& graph, Labels& labels, const vector<int>& U_i, long double b_i,
     long double B_i, long double B, PartialOrderDS& DS, vector<KeyValuePair>& K) {
     for (int u : U_i) {
         if (u < 0 || u >= (int)graph.size()) continue;
@@ -137,8 +146,9 @@ struct HeapElement {
     }
 };
 
+template <GraphLike G>
 std::expected<BaseCaseResult, DuanError> execute_base_case(
-    const Graph& graph, Labels& labels, long double B, const vector<int>& S, int k) {
+    const G& graph, Labels& labels, long double B, const vector<int>& S, int k) {
     
     if (S.size() != 1) return std::unexpected(DuanError::NonSingletonSourceSet);
     int x = S[0];
@@ -204,8 +214,9 @@ std::expected<BaseCaseResult, DuanError> execute_base_case(
 }
 
 
+template <GraphLike G>
 FindPivotsResult execute_find_pivots(
-    const Graph& graph, Labels& labels, long double B, const vector<int>& S, int k) {
+    const G& graph, Labels& labels, long double B, const vector<int>& S, int k) {
     
     FindPivotsResult result;
     if (S.empty()) return result;
@@ -236,8 +247,9 @@ FindPivotsResult execute_find_pivots(
 
 static thread_local int current_recursion_depth = 0;
 
+template <GraphLike G>
 BMSSPResult execute_bmssp(
-    const Graph& graph, Labels& labels, int l, long double B, const vector<int>& S, const Params& params) {
+    const G& graph, Labels& labels, int l, long double B, const vector<int>& S, const Params& params) {
     
     BMSSPResult result;
     if (S.empty()) return BMSSPResult{B, {}};
@@ -322,7 +334,8 @@ static int compute_initial_layer(int n, const Params& params) {
     return std::max(1, (int)std::ceil(log_n / (long double)params.t));
 }
 
-DuanSSSPResult compute_sssp(const Graph& graph, int source, bool collect_stats) {
+template <GraphLike G>
+DuanSSSPResult compute_sssp(const G& graph, int source, bool collect_stats) {
     DuanSSSPResult result;
     int n = graph.size();
 
@@ -356,7 +369,8 @@ DuanSSSPResult compute_sssp(const Graph& graph, int source, bool collect_stats)
     return result;
 }
 
-vector<long double> compute_dijkstra_sssp(const Graph& graph, int source) {
+template <GraphLike G>
+vector<long double> compute_dijkstra_sssp(const G& graph, int source) {
     int n = graph.size();
     vector<long double> dist(n, INF);
     vector<bool> visited(n, false);
@@ -384,6 +398,24 @@ vector<long double> compute_dijkstra_sssp(const Graph& graph, int source) {
     return dist;
 }
 
+// The algorithms are generic over GraphLike; these are the graph types the
+// library ships, so their code is emitted once here.
+#define DUAN_INSTANTIATE_FOR_GRAPH(G)                                                     \
+    template std::expected<BaseCaseResult, DuanError> execute_base_case<G>(               \
+        const G&, Labels&, long double, const vector<int>&, int);                         \
+    template FindPivotsResult execute_find_pivots<G>(                                     \
+        const G&, Labels&, long double, const vector<int>&, int);                         \
+    template BMSSPResult execute_bmssp<G>(                                                \
+        const G&, Labels&, int, long double, const vector<int>&, const Params&);          \
+    template DuanSSSPResult compute_sssp<G>(const G&, int, bool);                         \
+    template vector<long double> compute_dijkstra_sssp<G>(const G&, int);
+
+DUAN_INSTANTIATE_FOR_GRAPH(Graph)
+DUAN_INSTANTIATE_FOR_GRAPH(CsrGraph)
+DUAN_INSTANTIATE_FOR_GRAPH(SymmetricGraph)
+
+#undef DUAN_INSTANTIATE_FOR_GRAPH
+
 } // namespace duan
 
 namespace duan {
@@ -397,16 +429,87 @@ namespace duan {
 
 
 
+std::size_t NodePool::size_class_of(std::size_t bytes) {
+    // 16-byte steps for list/map nodes, then powers of two for block vectors
+    if (bytes <= SMALL_LIMIT) {
+        return (std::max<std::size_t>(bytes, 1) - 1) / GRANULARITY;
+    }
+    return SMALL_CLASSES + std::bit_width(bytes - 1) - std::bit_width(SMALL_LIMIT);
+}
+
+std::size_t NodePool::class_size(std::size_t size_class) {
+    if (size_class < SMALL_CLASSES) {
+        return (size_class + 1) * GRANULARITY;
+    }
+    return SMALL_LIMIT << (size_class - SMALL_CLASSES + 1);
+}
+
+void* NodePool::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_POOLED_SIZE || alignment > GRANULARITY) {
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    // Reuse a freed node of the same size class if there is one
+    std::size_t size_class = size_class_of(bytes);
+    if (FreeNode* node = free_lists_[size_class]) {
+        free_lists_[size_class] = node->next;
+        return node;
+    }
+
+    // Otherwise bump-allocate from the current chunk
+    std::size_t rounded = class_size(size_class);
+    if (cursor_ == nullptr || (std::size_t)(chunk_end_ - cursor_) < rounded) {
+        auto* chunk = static_cast<ChunkHeader*>(upstream_->allocate(CHUNK_SIZE, GRANULARITY));
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        cursor_ = reinterpret_cast<std::byte*>(chunk) + sizeof(ChunkHeader);
+        chunk_end_ = reinterpret_cast<std::byte*>(chunk) + CHUNK_SIZE;
+    }
+    void* result = cursor_;
+    cursor_ += rounded;
+    return result;
+}
+
+void NodePool::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_POOLED_SIZE || alignment > GRANULARITY) {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    std::size_t size_class = size_class_of(bytes);
+    auto* node = static_cast<FreeNode*>(p);
+    node->next = free_lists_[size_class];
+    free_lists_[size_class] = node;
+}
+
+void NodePool::release() {
+    while (chunks_ != nullptr) {
+        ChunkHeader* next = chunks_->next;
+        upstream_->deallocate(chunks_, CHUNK_SIZE, GRANULARITY);
+        chunks_ = next;
+    }
+    free_lists_.fill(nullptr);
+    cursor_ = nullptr;
+    chunk_end_ = nullptr;
+}
+
+PartialOrderDS::PartialOrderDS(std::pmr::memory_resource* resource)
+    : resource_(resource ? resource : &pool_),
+      D0_(resource_),
+      D1_(resource_),
+      D1_bounds_(resource_),
+      key_locations_(resource_),
+      M_(0),
+      B_(INF),
+      total_inserts_(0) {}
+
 void PartialOrderDS::Initialize(int M, long double B) {
     M_ = M;
     B_ = B;
     total_inserts_ = 0;
 
-    // Clear sequences
-    D0_.clear();
-    D1_.clear();
-    D1_bounds_.clear();
-    key_locations_.clear();
+    // Drop all blocks and hand the node memory back in one go
+    ReleaseStorage();
 
     // Initialize D1 with single empty block with upper bound B
     D1_.emplace_back(B);
@@ -419,7 +522,7 @@ void PartialOrderDS::Insert(int key, long double value) {
     if (loc_it != key_locations_.end()) {
         // Key exists - check if new value is better
         const auto& loc = loc_it->second;
-        long double old_value = loc.elem_it->second;
+        long double old_value = loc.block_it->elements[loc.index].second;
 
         if (value < old_value) {
             // Delete old entry and insert new one
@@ -435,12 +538,11 @@ void PartialOrderDS::Insert(int key, long double value) {
     // Find appropriate block in D1 for this value
     auto block_it = FindBlockForValue(value);
 
-    // Insert into block's linked list (O(1))
+    // Append to the block's contiguous storage (amortized O(1))
     block_it->elements.emplace_back(key, value);
-    auto elem_it = std::prev(block_it->elements.end());
 
     // Update key location
-    UpdateKeyLocation(key, 1, block_it, elem_it);
+    UpdateKeyLocation(key, 1, block_it, block_it->elements.size() - 1);
 
     // Check if block needs splitting
     if (block_it->elements.size() > (size_t)M_) {
@@ -470,7 +572,7 @@ void PartialOrderDS::BatchPrepend(const vector<KeyValuePair>& L) {
         auto loc_it = key_locations_.find(key);
         if (loc_it != key_locations_.end()) {
             const auto& loc = loc_it->second;
-            long double old_value = loc.elem_it->second;
+            long double old_value = loc.block_it->elements[loc.index].second;
             if (value < old_value) {
                 Delete(key, loc);
                 L_filtered.emplace_back(key, value);
@@ -484,42 +586,30 @@ void PartialOrderDS::BatchPrepend(const vector<KeyValuePair>& L) {
 
     int L_size = L_filtered.size();
 
+    // Build the new blocks directly in this instance's storage
+    BlockList new_blocks(resource_);
     if (L_size <= M_) {
-        // Create single block
-        Block new_block;
-        new_block.elements.assign(L_filtered.begin(), L_filtered.end());
-
-        // Add to front of D0
-        D0_.push_front(new_block);
-        auto block_it = D0_.begin();
-
-        // Update key locations
-        for (auto elem_it = block_it->elements.begin();
-             elem_it != block_it->elements.end(); ++elem_it) {
-            UpdateKeyLocation(elem_it->first, 0, block_it, elem_it);
-        }
+        new_blocks.emplace_back().elements.assign(L_filtered.begin(), L_filtered.end());
     } else {
         // Create O(L/M) blocks via median finding
-        auto new_blocks = CreateBlocksFromList(L_filtered);
+        new_blocks = CreateBlocksFromList(L_filtered);
+    }
 
-        // Prepend all blocks to D0
-        for (auto& block : new_blocks) {
-            D0_.push_front(block);
-            auto block_it = D0_.begin();
+    // Splice all blocks onto the front of D0 in ascending order (no copies)
+    auto new_end = D0_.begin();
+    D0_.splice(D0_.begin(), new_blocks);
 
-            // Update key locations
-            for (auto elem_it = block_it->elements.begin();
-                 elem_it != block_it->elements.end(); ++elem_it) {
-                UpdateKeyLocation(elem_it->first, 0, block_it, elem_it);
-            }
-        }
+    // Update key locations
+    for (auto block_it = D0_.begin(); block_it != new_end; ++block_it) {
+        UpdateBlockLocations(0, block_it);
     }
 }
 
 std::pair<vector<int>, long double> PartialOrderDS::Pull() {
     vector<int> result_keys;
 
-    // Collect prefix from D0 and D1 (up to M elements each)
+    // Collect whole blocks from the front of D0 and D1 until each yields >= M
+    // elements (or the sequence runs out)
     auto [S0, D0_remaining] = CollectPrefix(D0_, M_);
     auto [S1, D1_remaining] = CollectPrefix(D1_, M_);
 
@@ -528,19 +618,25 @@ std::pair<vector<int>, long double> PartialOrderDS::Pull() {
     S_combined.reserve(S0.size() + S1.size());
     S_combined.insert(S_combined.end(), S0.begin(), S0.end());
     S_combined.insert(S_combined.end(), S1.begin(), S1.end());
+    if (g_collect_stats) g_stats.ds_pull_scanned += S_combined.size();
 
     // Case 1: Total <= M, return all collected elements
     if (S_combined.size() <= (size_t)M_) {
+        result_keys.reserve(S_combined.size());
         for (const auto& [key, value] : S_combined) {
             result_keys.push_back(key);
             RemoveKeyLocation(key);
         }
 
-        // Remove collected blocks and rebuild data structures
+        // Every collected block was taken whole, so drop just those blocks;
+        // the rest of both sequences and their key locations stay valid
         D0_.erase(D0_.begin(), D0_remaining);
-        D1_.erase(D1_.begin(), D1_remaining);
-        RebuildD1Bounds();
-        RebuildKeyLocations();
+        for (auto block_it = D1_.begin(); block_it != D1_remaining;) {
+            auto next = std::next(block_it);
+            block_it->elements.clear();
+            RemoveEmptyBlock(1, block_it);
+            block_it = next;
+        }
 
         // Compute separator
         long double separator = empty() ? B_ : ComputeMinRemainingValue();
@@ -548,19 +644,15 @@ std::pair<vector<int>, long double> PartialOrderDS::Pull() {
     }
 
     // Case 2: Total > M, select M smallest elements
-    std::sort(S_combined.begin(), S_combined.end(),
-              [](const KeyValuePair& a, const KeyValuePair& b) {
-                  return a.second < b.second;
-              });
+    std::nth_element(S_combined.begin(), S_combined.begin() + M_, S_combined.end(), value_less);
 
     result_keys.reserve(M_);
-    for (int i = 0; i < M_ && i < (int)S_combined.size(); ++i) {
+    for (int i = 0; i < M_; ++i) {
         result_keys.push_back(S_combined[i].first);
     }
 
-    // Remove selected elements
-    std::unordered_set<int> selected_keys(result_keys.begin(), result_keys.end());
-    for (int key : selected_keys) {
+    // Remove selected elements (keys are unique within the structure)
+    for (int key : result_keys) {
         auto loc_it = key_locations_.find(key);
         if (loc_it != key_locations_.end()) {
             Delete(key, loc_it->second);
@@ -575,139 +667,120 @@ std::pair<vector<int>, long double> PartialOrderDS::Pull() {
 }
 
 int PartialOrderDS::total_elements() const {
-    int count = 0;
-    for (const auto& block : D0_) {
-        count += block.size();
-    }
-    for (const auto& block : D1_) {
-        count += block.size();
-    }
-    return count;
+    return key_locations_.size();
 }
 
 // Private methods
 
 void PartialOrderDS::Delete(int key, const ElementLocation& loc) {
-    auto& block = *loc.block_it;
-    block.elements.erase(loc.elem_it);
+    int sequence_id = loc.sequence_id;
+    auto block_it = loc.block_it;
+    size_t index = loc.index;
 
-    // If D1 block becomes empty, remove from BST
-    if (loc.sequence_id == 1 && block.empty()) {
-        D1_bounds_.erase(block.upper_bound);
+    // Swap-remove: the last element takes the freed slot
+    auto& elements = block_it->elements;
+    if (index + 1 != elements.size()) {
+        elements[index] = elements.back();
+        key_locations_[elements[index].first].index = index;
     }
-
+    elements.pop_back();
     RemoveKeyLocation(key);
-}
-
-void PartialOrderDS::SplitBlock(std::list<Block>::iterator block_it) {
-    auto& block = *block_it;
-
-    // Find median
-    long double median = FindMedian(block.elements);
-
-    // Partition into two blocks
-    auto [block1, block2] = PartitionByMedian(block.elements, median);
 
-    // Update upper bounds
-    block1.upper_bound = median;
-    block2.upper_bound = block.upper_bound;
-
-    // Remove old bound from BST
-    D1_bounds_.erase(block.upper_bound);
-
-    // Replace current block with block1
-    *block_it = block1;
-    D1_bounds_[block1.upper_bound] = block_it;
-
-    // Insert block2 after block1
-    auto block2_it = D1_.insert(std::next(block_it), block2);
-    D1_bounds_[block2.upper_bound] = block2_it;
-
-    // Update key locations
-    for (auto elem_it = block_it->elements.begin();
-         elem_it != block_it->elements.end(); ++elem_it) {
-        UpdateKeyLocation(elem_it->first, 1, block_it, elem_it);
-    }
-    for (auto elem_it = block2_it->elements.begin();
-         elem_it != block2_it->elements.end(); ++elem_it) {
-        UpdateKeyLocation(elem_it->first, 1, block2_it, elem_it);
+    if (block_it->empty()) {
+        RemoveEmptyBlock(sequence_id, block_it);
     }
 }
 
-long double PartialOrderDS::FindMedian(std::list<KeyValuePair>& elements) {
-    // Convert to vector for median finding
-    vector<long double> values;
-    values.reserve(elements.size());
-    for (const auto& [key, value] : elements) {
-        values.push_back(value);
+void PartialOrderDS::RemoveEmptyBlock(int sequence_id, BlockList::iterator block_it) {
+    if (sequence_id == 0) {
+        D0_.erase(block_it);
+        return;
     }
 
-    // Find median using nth_element
-    size_t mid = values.size() / 2;
-    std::nth_element(values.begin(), values.begin() + mid, values.end());
-    return values[mid];
-}
-
-std::pair<Block, Block> PartialOrderDS::PartitionByMedian(
-    std::list<KeyValuePair>& elements, long double median) {
-
-    Block block1, block2;
+    // The last D1 block (upper bound B) stays so inserts always have a home
+    if (std::next(block_it) == D1_.end()) {
+        return;
+    }
 
-    for (const auto& pair : elements) {
-        if (pair.second < median) {
-            block1.elements.push_back(pair);
+    // Blocks sharing a bound are adjacent and the map points at the first;
+    // hand the entry on to the next one of the group, if any
+    auto bound_it = D1_bounds_.find(block_it->upper_bound);
+    if (bound_it != D1_bounds_.end() && bound_it->second == block_it) {
+        auto next = std::next(block_it);
+        if (next->upper_bound == block_it->upper_bound) {
+            bound_it->second = next;
         } else {
-            block2.elements.push_back(pair);
+            D1_bounds_.erase(bound_it);
         }
     }
-
-    return {block1, block2};
+    D1_.erase(block_it);
 }
 
-std::list<Block> PartialOrderDS::CreateBlocksFromList(vector<KeyValuePair>& L) {
-    // Recursively partition L into blocks of size <= M/2
-    std::list<Block> blocks;
+void PartialOrderDS::SplitBlock(BlockList::iterator block_it) {
+    auto& block = *block_it;
 
-    if (L.size() <= (size_t)(M_ / 2)) {
-        // Base case: create single block
-        Block block;
-        block.elements.assign(L.begin(), L.end());
-        blocks.push_back(block);
-        return blocks;
-    }
+    // Select the median in place: [begin, mid) <= median <= [mid, end)
+    auto mid = PartitionByMedian(block.elements);
+    long double median = mid->second;
+
+    // Move the upper half into a new block after the current one
+    auto block2_it = D1_.emplace(std::next(block_it), block.upper_bound);
+    block2_it->elements.assign(std::make_move_iterator(mid),
+                               std::make_move_iterator(block.elements.end()));
+    block.elements.erase(mid, block.elements.end());
+
+    // With repeated values the median can equal a bound, so several adjacent
+    // blocks may share one. D1_bounds_ maps each bound to the first of them:
+    // that is where a smaller value must go, and the later ones hold only
+    // values equal to the bound.
+    if (median < block.upper_bound) {
+        // The block was first in its group (a later one would hold only
+        // values equal to the bound), so block2 takes over the entry
+        D1_bounds_[block.upper_bound] = block2_it;
+        block.upper_bound = median;
+        D1_bounds_.try_emplace(median, block_it);
+    }
+
+    // Selection reordered both halves, so every index is refreshed
+    UpdateBlockLocations(1, block_it);
+    UpdateBlockLocations(1, block2_it);
+}
 
-    // Find median and partition
-    vector<long double> values;
-    values.reserve(L.size());
-    for (const auto& [key, value] : L) {
-        values.push_back(value);
-    }
+PartialOrderDS::ElementVector::iterator PartialOrderDS::PartitionByMedian(ElementVector& elements) {
+    // One in-place selection pass over the contiguous pairs both finds the
+    // median and leaves the block partitioned around it
+    auto mid = elements.begin() + elements.size() / 2;
+    std::nth_element(elements.begin(), mid, elements.end(), value_less);
+    return mid;
+}
 
-    size_t mid = values.size() / 2;
-    std::nth_element(values.begin(), values.begin() + mid, values.end());
-    long double median = values[mid];
+PartialOrderDS::BlockList PartialOrderDS::CreateBlocksFromList(vector<KeyValuePair>& L) {
+    // Recursively partition L into blocks of size <= M/2
+    BlockList blocks(resource_);
+    AppendBlocks(blocks, L.begin(), L.end(), std::max(1, M_ / 2));
+    return blocks;
+}
 
-    // Partition L by median
-    vector<KeyValuePair> L_left, L_right;
-    for (const auto& pair : L) {
-        if (pair.second < median) {
-            L_left.push_back(pair);
-        } else {
-            L_right.push_back(pair);
-        }
-    }
+void PartialOrderDS::AppendBlocks(BlockList& blocks, vector<KeyValuePair>::iterator first,
+                                  vector<KeyValuePair>::iterator last, size_t max_block_size) {
+    if (first == last) return;
 
-    // Recursively create blocks
-    auto blocks_left = CreateBlocksFromList(L_left);
-    auto blocks_right = CreateBlocksFromList(L_right);
+    if ((size_t)(last - first) <= max_block_size) {
+        // Base case: create single block
+        blocks.emplace_back().elements.assign(first, last);
+        return;
+    }
 
-    blocks.splice(blocks.end(), blocks_left);
-    blocks.splice(blocks.end(), blocks_right);
+    // Partition the range in place around its median; both halves are
+    // strictly smaller, so this terminates even when values repeat
+    auto mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, value_less);
 
-    return blocks;
+    AppendBlocks(blocks, first, mid, max_block_size);
+    AppendBlocks(blocks, mid, last, max_block_size);
 }
 
-std::list<Block>::iterator PartialOrderDS::FindBlockForValue(long double value) {
+PartialOrderDS::BlockList::iterator PartialOrderDS::FindBlockForValue(long double value) {
     // Safety check: D1_ should never be empty after Initialize()
     // but guard against misuse
     if (D1_.empty()) {
@@ -728,66 +801,68 @@ std::list<Block>::iterator PartialOrderDS::FindBlockForValue(long double value)
 
 void PartialOrderDS::UpdateKeyLocation(
     int key, int seq_id,
-    std::list<Block>::iterator block_it,
-    std::list<KeyValuePair>::iterator elem_it) {
+    BlockList::iterator block_it,
+    size_t index) {
 
-    key_locations_[key] = {seq_id, block_it, elem_it};
+    key_locations_[key] = {seq_id, block_it, index};
+}
+
+void PartialOrderDS::UpdateBlockLocations(int seq_id, BlockList::iterator block_it) {
+    const auto& elements = block_it->elements;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        UpdateKeyLocation(elements[i].first, seq_id, block_it, i);
+    }
 }
 
 void PartialOrderDS::RemoveKeyLocation(int key) {
     key_locations_.erase(key);
 }
 
-std::pair<vector<KeyValuePair>, std::list<Block>::iterator>
-PartialOrderDS::CollectPrefix(std::list<Block>& sequence, int target_size) {
+std::pair<vector<KeyValuePair>, PartialOrderDS::BlockList::iterator>
+PartialOrderDS::CollectPrefix(BlockList& sequence, int target_size) {
 
     vector<KeyValuePair> collected;
     auto it = sequence.begin();
 
+    // Blocks are taken whole: a block's elements are unordered, so a partial
+    // block could leave smaller values behind
     while (it != sequence.end() && (int)collected.size() < target_size) {
-        for (const auto& pair : it->elements) {
-            collected.push_back(pair);
-            if ((int)collected.size() >= target_size) {
-                break;
-            }
-        }
+        collected.insert(collected.end(), it->elements.begin(), it->elements.end());
         ++it;
     }
 
     return {collected, it};
 }
 
-void PartialOrderDS::RebuildD1Bounds() {
+void PartialOrderDS::ReleaseStorage() {
+    D0_.clear();
+    D1_.clear();
     D1_bounds_.clear();
-    for (auto it = D1_.begin(); it != D1_.end(); ++it) {
-        D1_bounds_[it->upper_bound] = it;
-    }
-}
+    // clear() keeps the bucket array; swap in a fresh map so nothing is left
+    // pointing into the pool once it is released
+    key_locations_ = decltype(key_locations_)(resource_);
 
-void PartialOrderDS::RebuildKeyLocations() {
-    key_locations_.clear();
-    for (auto block_it = D0_.begin(); block_it != D0_.end(); ++block_it) {
-        for (auto elem_it = block_it->elements.begin();
-             elem_it != block_it->elements.end(); ++elem_it) {
-            key_locations_[elem_it->first] = {0, block_it, elem_it};
-        }
-    }
-    for (auto block_it = D1_.begin(); block_it != D1_.end(); ++block_it) {
-        for (auto elem_it = block_it->elements.begin();
-             elem_it != block_it->elements.end(); ++elem_it) {
-            key_locations_[elem_it->first] = {1, block_it, elem_it};
-        }
+    if (resource_ == &pool_) {
+        pool_.release();
     }
 }
 
 long double PartialOrderDS::ComputeMinRemainingValue() const {
+    // Blocks in each sequence are ordered and only the last D1 block may be
+    // empty, so the minimum lives in the first block of D0 or D1
     long double min_val = INF;
-    if (!D0_.empty() && !D0_.front().elements.empty()) {
-        min_val = std::min(min_val, D0_.front().elements.front().second);
-    }
-    if (!D1_.empty() && !D1_.front().elements.empty()) {
-        min_val = std::min(min_val, D1_.front().elements.front().second);
+    size_t scanned = 0;
+    for (const BlockList* sequence : {&D0_, &D1_}) {
+        for (const auto& block : *sequence) {
+            if (block.empty()) continue;
+            for (const auto& [key, value] : block.elements) {
+                min_val = std::min(min_val, value);
+            }
+            scanned += block.elements.size();
+            break;
+        }
     }
+    if (g_collect_stats) g_stats.ds_pull_scanned += scanned;
     return min_val;
 }
 
@@ -0,0 +1,133 @@
+
+#include "../include/graph_views.hpp"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace duan {
+
+// Runs body(t) for t in [0, threads), one std::jthread each
+template <typename Body>
+static void run_workers(int threads, Body body) {
+    if (threads <= 1) {
+        body(0);
+        return;
+    }
+    vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) workers.emplace_back(body, t);
+}
+
+// Worker t's share of the source vertices
+static std::pair<int, int> source_range(int n, int t, int threads) {
+    return {static_cast<int>((long long)n * t / threads),
+            static_cast<int>((long long)n * (t + 1) / threads)};
+}
+
+CsrGraph CsrGraph::from_graph(const Graph& graph) {
+    CsrGraph csr;
+    csr.offsets_.assign(graph.size() + 1, 0);
+    for (size_t u = 0; u < graph.size(); ++u) {
+        csr.offsets_[u + 1] = csr.offsets_[u] + graph[u].size();
+    }
+    csr.edges_.reserve(csr.offsets_.back());
+    for (const auto& adj : graph) {
+        csr.edges_.insert(csr.edges_.end(), adj.begin(), adj.end());
+    }
+    return csr;
+}
+
+CsrGraph CsrGraph::reversed(const Graph& graph, int threads) {
+    int n = graph.size();
+    if (n == 0) return CsrGraph();
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, n);
+
+    // Destinations are split into one contiguous range per thread; thread t
+    // reads sources in source_range(t) and later writes destinations in
+    // range t, so no thread needs a counter per vertex of the whole graph
+    const int width = (n + threads - 1) / threads;
+    auto range_of = [width](int v) { return v / width; };
+
+    // Thread r counting-sorts the in-edges of its destination range into
+    // place; visit(fn) calls fn(v, in-edge) for the range's edges in source
+    // order, so each in-edge list stays ordered by source
+    CsrGraph csr;
+    csr.offsets_.assign(n + 1, 0);
+    auto build_range = [&](int r, size_t range_begin, auto&& visit) {
+        const int first = std::min(n, r * width);
+        const int last = std::min(n, first + width);
+        vector<size_t> cursor(last - first, 0);
+        visit([&](int v, const Edge&) { ++cursor[v - first]; });
+
+        size_t offset = range_begin;
+        for (int v = first; v < last; ++v) {
+            size_t count = cursor[v - first];
+            cursor[v - first] = offset;
+            offset += count;
+            csr.offsets_[v + 1] = offset;
+        }
+        visit([&](int v, const Edge& edge) { csr.edges_[cursor[v - first]++] = edge; });
+    };
+
+    if (threads == 1) {
+        // One range: straight from the adjacency lists, nothing to stage
+        size_t m = 0;
+        for (const auto& adj : graph) m += adj.size();
+        csr.edges_.assign(m, Edge(0, 0.0L));
+        build_range(0, 0, [&](auto&& fn) {
+            for (int u = 0; u < n; ++u) {
+                for (const Edge& edge : graph[u]) fn(edge.to, Edge(u, edge.weight));
+            }
+        });
+        return csr;
+    }
+
+    // Pass 1: thread t counts its sources' edges into each destination range
+    vector<size_t> counts((size_t)threads * threads);  // [t * threads + range]
+    run_workers(threads, [&](int t) {
+        vector<size_t> local(threads, 0);
+        auto [begin, end] = source_range(n, t, threads);
+        for (int u = begin; u < end; ++u) {
+            for (const Edge& edge : graph[u]) ++local[range_of(edge.to)];
+        }
+        std::copy(local.begin(), local.end(), counts.begin() + (size_t)t * threads);
+    });
+
+    // Staging is grouped by destination range, then by source thread, so
+    // every range's edges sit in source order
+    vector<size_t> range_start(threads + 1, 0);
+    for (int r = 0; r < threads; ++r) {
+        size_t offset = range_start[r];
+        for (int t = 0; t < threads; ++t) {
+            size_t count = counts[(size_t)t * threads + r];
+            counts[(size_t)t * threads + r] = offset;
+            offset += count;
+        }
+        range_start[r + 1] = offset;
+    }
+    const size_t m = range_start[threads];
+
+    // Pass 2: each edge u -> v is staged as (v, u) in v's range
+    vector<std::pair<int, Edge>> staged(m, {0, Edge(0, 0.0L)});
+    run_workers(threads, [&](int t) {
+        size_t* cursor = counts.data() + (size_t)t * threads;
+        auto [begin, end] = source_range(n, t, threads);
+        for (int u = begin; u < end; ++u) {
+            for (const Edge& edge : graph[u]) {
+                staged[cursor[range_of(edge.to)]++] = {edge.to, Edge(u, edge.weight)};
+            }
+        }
+    });
+
+    // Pass 3: each thread sorts one destination range out of staging
+    csr.edges_.assign(m, Edge(0, 0.0L));
+    run_workers(threads, [&](int r) {
+        build_range(r, range_start[r], [&](auto&& fn) {
+            for (size_t i = range_start[r]; i < range_start[r + 1]; ++i) fn(staged[i].first, staged[i].second);
+        });
+    });
+    return csr;
+}
+
+} // namespace duan
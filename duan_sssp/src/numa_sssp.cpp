@@ -0,0 +1,336 @@
+
+#include "../include/numa_sssp.hpp"
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace duan {
+
+// ---------------------------------------------------------
+// Topology
+// ---------------------------------------------------------
+
+// Parses the kernel's cpulist format, e.g. "0-3,8,10-11"
+static vector<int> parse_cpu_list(const std::string& text) {
+    vector<int> cpus;
+    std::stringstream ranges(text);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty()) continue;
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+NumaTopology NumaTopology::detect() {
+    NumaTopology topology;
+    for (int node = 0;; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in) break;
+        std::string line;
+        std::getline(in, line);
+        auto cpus = parse_cpu_list(line);
+        if (!cpus.empty()) topology.node_cpus.push_back(std::move(cpus));
+    }
+
+    if (topology.node_cpus.empty()) {
+        int cpu_count = std::max(1u, std::thread::hardware_concurrency());
+        topology.node_cpus.emplace_back(cpu_count);
+        std::iota(topology.node_cpus[0].begin(), topology.node_cpus[0].end(), 0);
+    }
+    return topology;
+}
+
+NumaTopology NumaTopology::simulate(int nodes) {
+    vector<int> cpus;
+    for (const auto& node : detect().node_cpus) {
+        cpus.insert(cpus.end(), node.begin(), node.end());
+    }
+
+    NumaTopology topology;
+    topology.node_cpus.resize(std::max(1, nodes));
+    for (size_t i = 0; i < std::max(cpus.size(), topology.node_cpus.size()); ++i) {
+        // With fewer CPUs than nodes, nodes share CPUs
+        topology.node_cpus[i % topology.node_cpus.size()].push_back(cpus[i % cpus.size()]);
+    }
+    return topology;
+}
+
+static bool pin_to_cpus(const vector<int>& cpus) {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &cpuset);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+// ---------------------------------------------------------
+// Partitioned delta-stepping
+// ---------------------------------------------------------
+
+namespace {
+
+constexpr size_t NO_BUCKET = SIZE_MAX;
+
+struct RelaxMessage {
+    int vertex;
+    int pred;
+    long double dist;
+};
+
+// Everything a partition's thread writes lives here, allocated by that thread
+struct alignas(128) Partition {
+    int begin = 0;
+    int end = 0;
+    vector<int> offsets;
+    vector<int> targets;
+    vector<long double> weights;
+    vector<long double> dist;
+    vector<int> pred;
+    // Cyclic: live buckets never span more than the ring, so bucket b sits
+    // in slot b % size whatever the distances reach
+    vector<vector<int>> buckets;
+    vector<vector<RelaxMessage>> outbox;
+    size_t edge_relaxations = 0;
+    size_t remote_messages = 0;
+
+    vector<int>& bucket(size_t b) { return buckets[b % buckets.size()]; }
+};
+
+// Min-reduction over one vote per partition, run once per barrier phase
+struct VoteReduction {
+    vector<size_t>* votes;
+    size_t* result;
+    void operator()() noexcept {
+        *result = *std::min_element(votes->begin(), votes->end());
+    }
+};
+
+struct SharedState {
+    const Graph& graph;
+    const NumaTopology& topology;
+    const NumaOptions& options;
+    int source;
+    long double delta;
+    size_t ring_size;
+    vector<int> bounds;
+    vector<Partition> partitions;
+    vector<size_t> votes;
+    size_t reduced = NO_BUCKET;
+    std::barrier<VoteReduction> sync;
+
+    SharedState(const Graph& g, const NumaTopology& t, const NumaOptions& o, int src,
+                long double d, size_t ring, vector<int> b)
+        : graph(g), topology(t), options(o), source(src), delta(d), ring_size(ring), bounds(std::move(b)),
+          partitions(bounds.size() - 1), votes(partitions.size(), NO_BUCKET),
+          sync(static_cast<std::ptrdiff_t>(partitions.size()), VoteReduction{&votes, &reduced}) {}
+
+    int owner(int v) const {
+        return static_cast<int>(std::upper_bound(bounds.begin() + 1, bounds.end(), v) - (bounds.begin() + 1));
+    }
+
+    size_t bucket_of(long double d) const { return static_cast<size_t>(d / delta); }
+};
+
+// Splits [0, n) into contiguous ranges of roughly equal vertex + edge count
+vector<int> balance_ranges(const Graph& graph, int parts) {
+    int n = graph.size();
+    size_t total = 0;
+    for (const auto& adj : graph) total += 1 + adj.size();
+
+    vector<int> bounds = {0};
+    size_t acc = 0;
+    for (int v = 0; v < n && (int)bounds.size() < parts; ++v) {
+        acc += 1 + graph[v].size();
+        if (acc * parts >= total * bounds.size()) bounds.push_back(v + 1);
+    }
+    while ((int)bounds.size() <= parts) bounds.push_back(n);
+    bounds.back() = n;
+    return bounds;
+}
+
+void relax_local(Partition& part, const SharedState& state, int v, int u, long double new_dist) {
+    int lv = v - part.begin;
+    if (new_dist >= part.dist[lv]) return;
+    part.dist[lv] = new_dist;
+    part.pred[lv] = u;
+    ++part.edge_relaxations;
+
+    part.bucket(state.bucket_of(new_dist)).push_back(lv);
+}
+
+void build_partition(Partition& part, SharedState& state, int p) {
+    const Graph& graph = state.graph;
+    part.begin = state.bounds[p];
+    part.end = state.bounds[p + 1];
+    int local_n = part.end - part.begin;
+
+    part.offsets.assign(local_n + 1, 0);
+    for (int lv = 0; lv < local_n; ++lv) {
+        part.offsets[lv + 1] = part.offsets[lv] + graph[part.begin + lv].size();
+    }
+    part.targets.resize(part.offsets.back());
+    part.weights.resize(part.offsets.back());
+    for (int lv = 0; lv < local_n; ++lv) {
+        int e = part.offsets[lv];
+        for (const Edge& edge : graph[part.begin + lv]) {
+            part.targets[e] = edge.to;
+            part.weights[e] = edge.weight;
+            ++e;
+        }
+    }
+
+    part.dist.assign(local_n, INF);
+    part.pred.assign(local_n, -1);
+    part.outbox.assign(state.partitions.size(), {});
+    part.buckets.assign(state.ring_size, {});
+
+    if (state.source >= part.begin && state.source < part.end) {
+        part.dist[state.source - part.begin] = 0.0L;
+        part.bucket(0).push_back(state.source - part.begin);
+    }
+}
+
+void run_partition(SharedState& state, int p) {
+    if (state.options.pin_threads) {
+        const auto& nodes = state.topology.node_cpus;
+        pin_to_cpus(nodes[p % nodes.size()]);
+    }
+
+    // First touch happens here, on the pinned thread
+    Partition& part = state.partitions[p];
+    build_partition(part, state, p);
+
+    // Every queued entry is for a bucket in [scan, scan + ring_size)
+    size_t scan = 0;
+    while (true) {
+        // Agree on the smallest non-empty bucket across all partitions
+        size_t vote = NO_BUCKET;
+        for (size_t b = scan; b < scan + state.ring_size; ++b) {
+            if (!part.bucket(b).empty()) {
+                vote = b;
+                break;
+            }
+        }
+        state.votes[p] = vote;
+        state.sync.arrive_and_wait();
+        size_t current = state.reduced;
+        if (current == NO_BUCKET) break;
+        scan = current;
+
+        while (true) {
+            // Settle the local part of the bucket; re-inserts land back in it
+            while (!part.bucket(current).empty()) {
+                vector<int> frontier;
+                frontier.swap(part.bucket(current));
+                for (int lu : frontier) {
+                    long double du = part.dist[lu];
+                    if (state.bucket_of(du) != current) continue;
+                    int u = part.begin + lu;
+                    for (int e = part.offsets[lu]; e < part.offsets[lu + 1]; ++e) {
+                        int v = part.targets[e];
+                        long double new_dist = du + part.weights[e];
+                        if (v >= part.begin && v < part.end) {
+                            relax_local(part, state, v, u, new_dist);
+                        } else {
+                            part.outbox[state.owner(v)].push_back({v, u, new_dist});
+                            ++part.remote_messages;
+                        }
+                    }
+                }
+            }
+
+            // Exchange batched cross-partition relaxations
+            state.sync.arrive_and_wait();
+            for (auto& sender : state.partitions) {
+                auto& inbox = sender.outbox[p];
+                for (const auto& msg : inbox) relax_local(part, state, msg.vertex, msg.pred, msg.dist);
+                inbox.clear();
+            }
+
+            bool active = !part.bucket(current).empty();
+            state.votes[p] = active ? 0 : NO_BUCKET;
+            state.sync.arrive_and_wait();
+            if (state.reduced == NO_BUCKET) break;
+        }
+    }
+}
+
+}  // namespace
+
+NumaSSSPResult compute_numa_sssp(const Graph& graph, int source, const NumaOptions& options) {
+    NumaSSSPResult result;
+    int n = graph.size();
+    if (n == 0) return result;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    NumaTopology topology = options.simulated_nodes > 0
+        ? NumaTopology::simulate(options.simulated_nodes)
+        : NumaTopology::detect();
+    int parts = options.partitions > 0 ? options.partitions : topology.node_count();
+    parts = std::clamp(parts, 1, n);
+
+    long double weight_sum = 0.0L;
+    long double max_weight = 0.0L;
+    size_t m = 0;
+    for (const auto& adj : graph) {
+        for (const Edge& edge : adj) {
+            weight_sum += edge.weight;
+            max_weight = std::max(max_weight, edge.weight);
+        }
+        m += adj.size();
+    }
+    long double delta = options.delta;
+    if (delta <= 0.0L) {
+        delta = (m > 0 && weight_sum > 0.0L) ? weight_sum / m : 1.0L;
+    }
+    // Relaxing bucket k reaches at most bucket k + ceil(max_weight / delta);
+    // one extra slot absorbs rounding in bucket_of
+    size_t ring = static_cast<size_t>(std::ceil(max_weight / delta)) + 2;
+
+    SharedState state(graph, topology, options, source, delta, ring, balance_ranges(graph, parts));
+    {
+        vector<std::jthread> workers;
+        workers.reserve(parts);
+        for (int p = 0; p < parts; ++p) {
+            workers.emplace_back(run_partition, std::ref(state), p);
+        }
+    }
+
+    result.dist.resize(n);
+    result.pred.resize(n);
+    for (const auto& part : state.partitions) {
+        std::copy(part.dist.begin(), part.dist.end(), result.dist.begin() + part.begin);
+        std::copy(part.pred.begin(), part.pred.end(), result.pred.begin() + part.begin);
+        result.edge_relaxations += part.edge_relaxations;
+        result.remote_messages += part.remote_messages;
+    }
+    result.partitions = parts;
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.total_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    return result;
+}
+
+} // namespace duan
@@ -0,0 +1,201 @@
+/**
+ * Unit tests and build-cost benchmark for the reverse CSR and symmetric views
+ */
+
+#include "../include/graph_views.hpp"
+#include "graph_generators.hpp"
+
+#include <algorithm>
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+using namespace duan;
+using namespace duan::test;
+
+namespace {
+
+// What the views replace: materialised adjacency-list copies
+Graph copy_reversed(const Graph& graph) {
+    Graph reversed(graph.size());
+    for (int u = 0; u < (int)graph.size(); ++u) {
+        for (const Edge& edge : graph[u]) reversed[edge.to].emplace_back(u, edge.weight);
+    }
+    return reversed;
+}
+
+Graph copy_undirected(const Graph& graph) {
+    Graph undirected = graph;
+    Graph reversed = copy_reversed(graph);
+    for (size_t u = 0; u < graph.size(); ++u) {
+        undirected[u].insert(undirected[u].end(), reversed[u].begin(), reversed[u].end());
+    }
+    return undirected;
+}
+
+template <GraphLike G>
+vector<std::pair<int, long double>> sorted_adjacency(const G& graph, int u) {
+    vector<std::pair<int, long double>> adj;
+    for (const Edge& edge : graph[u]) adj.emplace_back(edge.to, edge.weight);
+    std::sort(adj.begin(), adj.end());
+    return adj;
+}
+
+template <GraphLike A, GraphLike B>
+bool same_adjacency(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (int u = 0; u < (int)a.size(); ++u) {
+        if (sorted_adjacency(a, u) != sorted_adjacency(b, u)) return false;
+    }
+    return true;
+}
+
+bool same_distances(const vector<long double>& actual, const vector<long double>& expected) {
+    if (actual.size() != expected.size()) return false;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (std::isinf(expected[i]) != std::isinf(actual[i])) return false;
+        if (!std::isinf(expected[i]) && !approx_equal(actual[i], expected[i])) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("CsrGraph::from_graph preserves adjacency", "[graph_views]") {
+    Graph g = create_sparse_graph(300, 1500);
+    CsrGraph csr = CsrGraph::from_graph(g);
+
+    REQUIRE(csr.size() == g.size());
+    REQUIRE(same_adjacency(csr, g));
+}
+
+TEST_CASE("Reverse CSR holds every in-edge", "[graph_views]") {
+    Graph g = create_diamond_graph();
+    CsrGraph rev = CsrGraph::reversed(g, 1);
+
+    REQUIRE(rev.size() == g.size());
+    REQUIRE(rev[0].empty());
+    REQUIRE(rev[3].size() == 2);
+    REQUIRE(rev[3][0].to == 1);
+    REQUIRE(rev[3][1].to == 2);
+}
+
+TEST_CASE("Reverse CSR is identical for any thread count", "[graph_views]") {
+    Graph g = create_sparse_graph(2000, 12000);
+    Graph expected = copy_reversed(g);
+    CsrGraph single = CsrGraph::reversed(g, 1);
+
+    size_t m = 0;
+    for (const auto& adj : g) m += adj.size();
+    REQUIRE(single.edge_count() == m);
+    REQUIRE(same_adjacency(single, expected));
+    for (int threads : {2, 3, 8}) {
+        CsrGraph parallel = CsrGraph::reversed(g, threads);
+        for (int v = 0; v < (int)g.size(); ++v) {
+            REQUIRE(std::equal(single[v].begin(), single[v].end(), parallel[v].begin(), parallel[v].end(),
+                               [](const Edge& a, const Edge& b) {
+                                   return a.to == b.to && a.weight == b.weight;
+                               }));
+        }
+    }
+}
+
+TEST_CASE("Symmetric view iterates out-edges then in-edges", "[graph_views]") {
+    Graph g = create_path_graph(5);
+    CsrGraph rev = CsrGraph::reversed(g);
+    SymmetricGraph sym(g, rev);
+
+    REQUIRE(sym.size() == 5);
+    REQUIRE(sym[0].size() == 1);
+    REQUIRE(sym[4].size() == 1);
+    vector<int> middle;
+    for (const Edge& edge : sym[2]) middle.push_back(edge.to);
+    REQUIRE(middle == vector<int>{3, 1});
+
+    Graph sparse = create_sparse_graph(400, 2000);
+    CsrGraph sparse_rev = CsrGraph::reversed(sparse);
+    REQUIRE(same_adjacency(SymmetricGraph(sparse, sparse_rev), copy_undirected(sparse)));
+}
+
+TEST_CASE("Symmetric view handles isolated vertices", "[graph_views]") {
+    Graph g(4);
+    g[1].emplace_back(2, 1.0L);
+    CsrGraph rev = CsrGraph::reversed(g);
+    SymmetricGraph sym(g, rev);
+
+    REQUIRE(sym[0].begin() == sym[0].end());
+    REQUIRE(sym[3].begin() == sym[3].end());
+    REQUIRE(sym[2].begin()->to == 1);
+}
+
+TEST_CASE("SSSP on views matches SSSP on copied graphs", "[graph_views]") {
+    Graph g = create_sparse_graph(1500, 8000);
+    CsrGraph rev = CsrGraph::reversed(g);
+    SymmetricGraph sym(g, rev);
+    Graph rev_copy = copy_reversed(g);
+    Graph sym_copy = copy_undirected(g);
+
+    for (int source : {0, 7, 1499}) {
+        auto rev_expected = compute_dijkstra_sssp(rev_copy, source);
+        auto sym_expected = compute_dijkstra_sssp(sym_copy, source);
+
+        REQUIRE(same_distances(compute_dijkstra_sssp(rev, source), rev_expected));
+        REQUIRE(same_distances(compute_dijkstra_sssp(sym, source), sym_expected));
+        REQUIRE(same_distances(compute_sssp(rev, source).dist, compute_sssp(rev_copy, source).dist));
+        REQUIRE(same_distances(compute_sssp(sym, source).dist, compute_sssp(sym_copy, source).dist));
+    }
+}
+
+TEST_CASE("Duan SSSP on CSR matches adjacency lists", "[graph_views]") {
+    Graph g = create_grid_graph(15, 15);
+    CsrGraph csr = CsrGraph::from_graph(g);
+
+    auto from_lists = compute_sssp(g, 0);
+    auto from_csr = compute_sssp(csr, 0);
+    REQUIRE(same_distances(from_csr.dist, from_lists.dist));
+    REQUIRE(from_csr.pred == from_lists.pred);
+}
+
+TEST_CASE("View build vs graph copy", "[graph_views][benchmark]") {
+    constexpr int n = 1 << 18;
+    constexpr int m = 8 * n;
+    Graph g = create_sparse_graph(n, m);
+    int hw_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto time_us = [](auto&& fn) {
+        long long best = -1;
+        for (int run = 0; run < 3; ++run) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fn();
+            auto end = std::chrono::high_resolution_clock::now();
+            long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            if (best < 0 || us < best) best = us;
+        }
+        return best;
+    };
+
+    std::cout << "\n=== Graph view build cost (n=" << n << ", m=" << m << ") ===\n";
+    std::cout << std::setw(36) << "Construction" << std::setw(15) << "Time (μs)" << "\n";
+    auto row = [](const char* name, long long us) {
+        std::cout << std::setw(36) << name << std::setw(15) << us << "\n";
+    };
+
+    row("copy reversed vector<vector<Edge>>", time_us([&] { copy_reversed(g); }));
+    row("reverse CSR, 1 thread", time_us([&] { CsrGraph::reversed(g, 1); }));
+    row("reverse CSR, all threads", time_us([&] { CsrGraph::reversed(g, hw_threads); }));
+    row("copy undirected vector<vector<Edge>>", time_us([&] { copy_undirected(g); }));
+    row("reverse CSR + symmetric view", time_us([&] {
+        CsrGraph reverse = CsrGraph::reversed(g, hw_threads);
+        SymmetricGraph view(g, reverse);
+        (void)view;
+    }));
+
+    std::cout << "\n=== Dijkstra over the result ===\n";
+    Graph sym_copy = copy_undirected(g);
+    CsrGraph rev = CsrGraph::reversed(g, hw_threads);
+    SymmetricGraph sym(g, rev);
+    row("undirected copy", time_us([&] { compute_dijkstra_sssp(sym_copy, 0); }));
+    row("symmetric view", time_us([&] { compute_dijkstra_sssp(sym, 0); }));
+    REQUIRE(same_distances(compute_dijkstra_sssp(sym, 0), compute_dijkstra_sssp(sym_copy, 0)));
+}
@@ -0,0 +1,161 @@
+/**
+ * Unit tests and scaling benchmark for the NUMA-partitioned delta-stepping SSSP
+ */
+
+#include "../include/numa_sssp.hpp"
+#include "graph_generators.hpp"
+
+#include <catch_amalgamated.hpp>
+#include <cmath>
+#include <iomanip>
+
+using namespace duan;
+using namespace duan::test;
+
+namespace {
+
+bool same_distances(const vector<long double>& actual, const vector<long double>& expected) {
+    if (actual.size() != expected.size()) return false;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (std::isinf(expected[i]) != std::isinf(actual[i])) return false;
+        if (!std::isinf(expected[i]) && !approx_equal(actual[i], expected[i])) return false;
+    }
+    return true;
+}
+
+NumaOptions simulated(int partitions) {
+    NumaOptions options;
+    options.partitions = partitions;
+    options.simulated_nodes = 2;
+    return options;
+}
+
+}  // namespace
+
+TEST_CASE("NumaTopology detects at least one node", "[numa]") {
+    auto topology = NumaTopology::detect();
+    REQUIRE(topology.node_count() >= 1);
+    for (const auto& cpus : topology.node_cpus) {
+        REQUIRE_FALSE(cpus.empty());
+    }
+}
+
+TEST_CASE("NumaTopology simulate splits CPUs across nodes", "[numa]") {
+    auto topology = NumaTopology::simulate(4);
+    REQUIRE(topology.node_count() == 4);
+    for (const auto& cpus : topology.node_cpus) {
+        REQUIRE_FALSE(cpus.empty());
+    }
+}
+
+TEST_CASE("NUMA SSSP matches Dijkstra on path graph", "[numa]") {
+    Graph g = create_path_graph(50);
+    auto expected = compute_dijkstra_sssp(g, 0);
+
+    for (int partitions : {1, 2, 3}) {
+        auto result = compute_numa_sssp(g, 0, simulated(partitions));
+        REQUIRE(result.partitions == partitions);
+        REQUIRE(same_distances(result.dist, expected));
+    }
+}
+
+TEST_CASE("NUMA SSSP matches Dijkstra on grid graph", "[numa]") {
+    Graph g = create_grid_graph(20, 20);
+    auto expected = compute_dijkstra_sssp(g, 0);
+
+    for (int partitions : {1, 2, 4}) {
+        auto result = compute_numa_sssp(g, 0, simulated(partitions));
+        REQUIRE(same_distances(result.dist, expected));
+    }
+}
+
+TEST_CASE("NUMA SSSP matches Dijkstra on sparse random graph", "[numa]") {
+    Graph g = create_sparse_graph(2000, 10000);
+    auto expected = compute_dijkstra_sssp(g, 0);
+
+    for (int partitions : {1, 2, 4}) {
+        auto result = compute_numa_sssp(g, 0, simulated(partitions));
+        REQUIRE(same_distances(result.dist, expected));
+        if (partitions > 1) {
+            REQUIRE(result.remote_messages > 0);
+        }
+    }
+}
+
+TEST_CASE("NUMA SSSP predecessors form shortest-path tree", "[numa]") {
+    Graph g = create_sparse_graph(500, 3000);
+    auto result = compute_numa_sssp(g, 0, simulated(3));
+
+    REQUIRE(result.pred[0] == -1);
+    for (int v = 1; v < (int)g.size(); ++v) {
+        if (std::isinf(result.dist[v])) continue;
+        int u = result.pred[v];
+        REQUIRE(u >= 0);
+        bool has_tight_edge = false;
+        for (const Edge& edge : g[u]) {
+            if (edge.to == v && approx_equal(result.dist[u] + edge.weight, result.dist[v])) {
+                has_tight_edge = true;
+            }
+        }
+        REQUIRE(has_tight_edge);
+    }
+}
+
+TEST_CASE("NUMA SSSP source in a later partition", "[numa]") {
+    Graph g = create_grid_graph(10, 10);
+    auto expected = compute_dijkstra_sssp(g, 55);
+    auto result = compute_numa_sssp(g, 55, simulated(4));
+    REQUIRE(same_distances(result.dist, expected));
+}
+
+TEST_CASE("NUMA SSSP with a narrow delta reuses its bucket ring", "[numa]") {
+    // An edge spans at most 40 buckets, far fewer than the distances do,
+    // so each partition's bucket ring wraps around several times
+    Graph g = create_sparse_graph(2000, 10000);
+    auto expected = compute_dijkstra_sssp(g, 0);
+
+    for (int partitions : {1, 3}) {
+        NumaOptions options = simulated(partitions);
+        options.delta = 0.25L;
+        auto result = compute_numa_sssp(g, 0, options);
+        REQUIRE(same_distances(result.dist, expected));
+    }
+}
+
+TEST_CASE("NUMA SSSP partition scaling", "[numa][benchmark]") {
+    // Run under `numactl --cpunodebind=0,1 --membind=0,1` on a two-node
+    // machine; elsewhere the simulated nodes only split the CPU set
+    constexpr int n = 1 << 18;
+    constexpr int m = 8 * n;
+    Graph g = create_sparse_graph(n, m);
+    auto topology = NumaTopology::detect();
+
+    std::cout << "\n=== NUMA SSSP scaling (n=" << n << ", m=" << m
+              << ", detected nodes=" << topology.node_count() << ") ===\n";
+    std::cout << std::setw(12) << "Partitions"
+              << std::setw(15) << "Time (μs)"
+              << std::setw(15) << "Relaxations"
+              << std::setw(18) << "Remote msgs"
+              << "\n";
+
+    auto reference = compute_dijkstra_sssp(g, 0);
+    for (int partitions : {1, 2, 4, 8}) {
+        NumaOptions options;
+        options.partitions = partitions;
+        options.simulated_nodes = topology.node_count() > 1 ? 0 : 2;
+
+        NumaSSSPResult best;
+        for (int run = 0; run < 3; ++run) {
+            auto result = compute_numa_sssp(g, 0, options);
+            if (run == 0 || result.total_time < best.total_time) best = std::move(result);
+        }
+
+        std::cout << std::setw(12) << partitions
+                  << std::setw(15) << best.total_time.count()
+                  << std::setw(15) << best.edge_relaxations
+                  << std::setw(18) << best.remote_messages
+                  << "\n";
+
+        REQUIRE(same_distances(best.dist, reference));
+    }
+}
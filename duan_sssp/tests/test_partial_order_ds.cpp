@@ -3,8 +3,13 @@
  */
 
 #include "../include/duan_sssp.hpp"
+#include "arena.h"
 #include <catch_amalgamated.hpp>
 #include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory_resource>
+#include <random>
 
 using namespace duan;
 
@@ -184,3 +189,375 @@ TEST_CASE("PartialOrderDS ordering preserved", "[partial_order_ds]") {
     REQUIRE(keys[1] == 2);  // value 20.0
     REQUIRE(keys[2] == 4);  // value 40.0
 }
+
+namespace {
+
+// Pulls once and checks the result against the reference contents: at most
+// M keys, each present, none valued above anything left behind, and a
+// separator equal to the smallest remaining value (B once empty)
+void pull_and_check(PartialOrderDS& ds, std::map<int, long double>& reference, int M, long double B) {
+    auto [keys, separator] = ds.Pull();
+    REQUIRE(keys.size() == std::min(reference.size(), (size_t)M));
+
+    long double largest_pulled = -INF;
+    for (int key : keys) {
+        auto it = reference.find(key);
+        REQUIRE(it != reference.end());
+        largest_pulled = std::max(largest_pulled, it->second);
+        reference.erase(it);
+    }
+    long double smallest_left = B;
+    for (const auto& [key, value] : reference) smallest_left = std::min(smallest_left, value);
+
+    REQUIRE(largest_pulled <= smallest_left);
+    REQUIRE(separator == smallest_left);
+    REQUIRE(ds.total_elements() == (int)reference.size());
+}
+
+// Keeps the smaller value for a key, as Insert and BatchPrepend do
+void record_min(std::map<int, long double>& reference, int key, long double value) {
+    auto [it, inserted] = reference.emplace(key, value);
+    if (!inserted) it->second = std::min(it->second, value);
+}
+
+}  // namespace
+
+TEST_CASE("PartialOrderDS matches a reference set on random workloads", "[partial_order_ds]") {
+    constexpr long double B = 1e6;
+    for (int M : {1, 4, 16, 64}) {
+        for (uint64_t seed = 1; seed <= 4; ++seed) {
+            INFO("M=" << M << " seed=" << seed);
+            std::mt19937_64 rng(seed * 1000 + M);
+            std::uniform_int_distribution<int> key_dist(0, 1999);
+            std::uniform_int_distribution<int> op_dist(0, 99);
+            std::uniform_real_distribution<double> value_dist(0.0, 1e5);
+
+            PartialOrderDS ds;
+            ds.Initialize(M, B);
+            std::map<int, long double> reference;
+
+            for (int op = 0; op < 3000; ++op) {
+                const int roll = op_dist(rng);
+                if (roll < 15) {
+                    pull_and_check(ds, reference, M, B);
+                } else if (roll < 25) {
+                    // Prepended values lie below everything already present,
+                    // and some keys are already in the structure
+                    long double floor = B;
+                    for (const auto& [key, value] : reference) floor = std::min(floor, value);
+                    vector<KeyValuePair> batch;
+                    const int count = 1 + (int)(rng() % (3 * M + 1));
+                    for (int i = 0; i < count; ++i) {
+                        const long double value = floor - 1 - (long double)(rng() % 50);
+                        batch.emplace_back(key_dist(rng), value);
+                        record_min(reference, batch.back().first, value);
+                    }
+                    ds.BatchPrepend(batch);
+                } else {
+                    const int key = key_dist(rng);
+                    const long double value = (long double)(int)value_dist(rng);
+                    ds.Insert(key, value);
+                    record_min(reference, key, value);
+                }
+                REQUIRE(ds.total_elements() == (int)reference.size());
+            }
+            while (!reference.empty()) pull_and_check(ds, reference, M, B);
+            REQUIRE(ds.empty());
+        }
+    }
+}
+
+TEST_CASE("PartialOrderDS equal values with M=1", "[partial_order_ds]") {
+    constexpr long double B = 100.0;
+    PartialOrderDS ds;
+    ds.Initialize(1, B);
+    std::map<int, long double> reference;
+
+    // A prepend of identical values must still split down to single-element
+    // blocks, and inserts of identical values must still split a full block
+    vector<KeyValuePair> batch;
+    for (int key = 0; key < 300; ++key) {
+        batch.emplace_back(key, 5.0);
+        reference[key] = 5.0;
+    }
+    ds.BatchPrepend(batch);
+    for (int key = 300; key < 600; ++key) {
+        ds.Insert(key, 7.0);
+        reference[key] = 7.0;
+    }
+    REQUIRE(ds.total_elements() == 600);
+    while (!reference.empty()) pull_and_check(ds, reference, 1, B);
+    REQUIRE(ds.empty());
+}
+
+TEST_CASE("PartialOrderDS decrease-key swap-removes within blocks", "[partial_order_ds]") {
+    constexpr int M = 8;
+    constexpr long double B = 1e6;
+    std::mt19937_64 rng(78);
+    PartialOrderDS ds;
+    ds.Initialize(M, B);
+    std::map<int, long double> reference;
+
+    // Split-heavy fill: blocks hold at most M pairs, so most inserts land in
+    // a block that is split by in-place selection soon after
+    for (int key = 0; key < 4000; ++key) {
+        const long double value = (long double)(rng() % 100000);
+        ds.Insert(key, value);
+        reference[key] = value;
+    }
+    // Better values for random keys delete from the middle and end of
+    // blocks; the moved-in last pair's location must follow it
+    for (int round = 0; round < 4000; ++round) {
+        const int key = (int)(rng() % 4000);
+        auto it = reference.find(key);
+        if (it == reference.end()) continue;
+        const long double value = it->second - 1 - (long double)(rng() % 1000);
+        ds.Insert(key, value);
+        it->second = value;
+        if (round % 50 == 0) pull_and_check(ds, reference, M, B);
+    }
+    // A worse value is ignored
+    const auto [some_key, some_value] = *reference.begin();
+    ds.Insert(some_key, some_value + 1);
+    REQUIRE(ds.total_elements() == (int)reference.size());
+
+    while (!reference.empty()) pull_and_check(ds, reference, M, B);
+}
+
+TEST_CASE("PartialOrderDS BatchPrepend larger than M appends median-split blocks", "[partial_order_ds]") {
+    constexpr long double B = 1e6;
+    for (int M : {2, 7, 32}) {
+        INFO("M=" << M);
+        std::mt19937_64 rng(M);
+        PartialOrderDS ds;
+        ds.Initialize(M, B);
+        std::map<int, long double> reference;
+
+        for (int key = 0; key < 500; ++key) {
+            const long double value = 10000 + (long double)(rng() % 10000);
+            ds.Insert(key, value);
+            reference[key] = value;
+        }
+        // Many times M, with repeated keys and repeated values, some of
+        // them keys already in D1
+        vector<KeyValuePair> batch;
+        for (int i = 0; i < 40 * M; ++i) {
+            const int key = 400 + (int)(rng() % (20 * M));
+            const long double value = (long double)(rng() % 64);
+            batch.emplace_back(key, value);
+            record_min(reference, key, value);
+        }
+        ds.BatchPrepend(batch);
+        REQUIRE(ds.total_elements() == (int)reference.size());
+
+        while (!reference.empty()) pull_and_check(ds, reference, M, B);
+    }
+}
+
+TEST_CASE("PartialOrderDS stays usable after draining", "[partial_order_ds]") {
+    constexpr int M = 4;
+    constexpr long double B = 1000.0;
+    PartialOrderDS ds;
+    ds.Initialize(M, B);
+    std::map<int, long double> reference;
+
+    for (int round = 0; round < 3; ++round) {
+        // Values up to B land in the last D1 block, which is kept even while
+        // empty so inserts after a drain still have a home
+        for (int i = 0; i < 50; ++i) {
+            const int key = round * 100 + i;
+            const long double value = (long double)((i * 37) % 50) * 20;
+            ds.Insert(key, value);
+            reference[key] = value;
+        }
+        ds.Insert(round * 100 + 99, B);
+        reference[round * 100 + 99] = B;
+        while (!reference.empty()) pull_and_check(ds, reference, M, B);
+        REQUIRE(ds.empty());
+
+        auto [keys, separator] = ds.Pull();
+        REQUIRE(keys.empty());
+        REQUIRE(separator == B);
+    }
+}
+
+namespace {
+
+// Forwards to an upstream resource and counts how often it is asked for memory
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+    size_t allocations = 0;
+
+private:
+    std::pmr::memory_resource* upstream_;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return upstream_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Insert-heavy phase followed by prepends and pulls until drained, repeated
+// `rounds` times through Initialize the way BMSSP reuses a level
+int run_ds_workload(PartialOrderDS& ds, int rounds) {
+    constexpr int M = 64;
+    constexpr int N = 4096;
+    int pulled = 0;
+    for (int round = 0; round < rounds; ++round) {
+        ds.Initialize(M, 1e9);
+        for (int i = 0; i < N; ++i) {
+            ds.Insert(i, (long double)((i * 7919) % N));
+        }
+        vector<KeyValuePair> batch;
+        for (int i = 0; i < N / 4; ++i) {
+            batch.emplace_back(N + i, (long double)(i % 97));
+        }
+        ds.BatchPrepend(batch);
+        while (!ds.empty()) {
+            pulled += (int)ds.Pull().first.size();
+        }
+    }
+    return pulled;
+}
+
+}  // namespace
+
+TEST_CASE("PartialOrderDS pooled node allocation", "[partial_order_ds][benchmark]") {
+    constexpr int rounds = 4;
+
+    CountingResource heap_counter;
+    PartialOrderDS per_node(&heap_counter);
+    int heap_pulled = run_ds_workload(per_node, rounds);
+
+    CountingResource pool_counter;
+    auto* previous = std::pmr::set_default_resource(&pool_counter);
+    int pool_pulled = 0;
+    {
+        PartialOrderDS pooled;
+        pool_pulled = run_ds_workload(pooled, rounds);
+    }
+    std::pmr::set_default_resource(previous);
+
+    std::cout << "\n=== PartialOrderDS upstream allocations (" << rounds << " rounds) ===\n";
+    std::cout << std::setw(20) << "per-node heap" << std::setw(12) << heap_counter.allocations << "\n";
+    std::cout << std::setw(20) << "pooled (default)" << std::setw(12) << pool_counter.allocations << "\n";
+
+    // The shared resources from memory_arena/ plug in the same way
+    arena::SizeClassPool size_classes;
+    arena::MonotonicArena monotonic;
+    {
+        PartialOrderDS shared_pool(&size_classes);
+        PartialOrderDS on_arena(&monotonic);
+        REQUIRE(run_ds_workload(shared_pool, rounds) == heap_pulled);
+        REQUIRE(run_ds_workload(on_arena, rounds) == heap_pulled);
+    }
+    monotonic.reset();
+
+    REQUIRE(heap_pulled == pool_pulled);
+    REQUIRE(pool_counter.allocations * 10 < heap_counter.allocations);
+
+    BENCHMARK("per-node heap allocation") {
+        PartialOrderDS ds(std::pmr::new_delete_resource());
+        return run_ds_workload(ds, rounds);
+    };
+
+    BENCHMARK("pooled allocation") {
+        PartialOrderDS ds;
+        return run_ds_workload(ds, rounds);
+    };
+
+    BENCHMARK("arena::SizeClassPool") {
+        PartialOrderDS ds(&size_classes);
+        return run_ds_workload(ds, rounds);
+    };
+
+    BENCHMARK("arena::MonotonicArena, reset per run") {
+        int pulled = 0;
+        {
+            PartialOrderDS ds(&monotonic);
+            pulled = run_ds_workload(ds, rounds);
+        }
+        monotonic.reset();
+        return pulled;
+    };
+}
+
+TEST_CASE("PartialOrderDS Pull work stays O(M) per call", "[partial_order_ds][benchmark]") {
+    constexpr int M = 32;
+    std::cout << "\n=== PartialOrderDS Pull operation count (M=" << M << ") ===\n";
+    std::cout << std::setw(10) << "N"
+              << std::setw(12) << "Pulls"
+              << std::setw(15) << "Scanned"
+              << std::setw(15) << "Scanned/Pull"
+              << "\n";
+
+    g_collect_stats = true;
+    for (int n : {1000, 10000, 100000}) {
+        g_stats.reset();
+        PartialOrderDS ds;
+        ds.Initialize(M, 1e9);
+        for (int i = 0; i < n; ++i) {
+            ds.Insert(i, (long double)((i * 7919) % n));
+        }
+        size_t pulls = 0;
+        while (!ds.empty()) {
+            ds.Pull();
+            ++pulls;
+        }
+
+        double per_pull = (double)g_stats.ds_pull_scanned / (double)pulls;
+        std::cout << std::setw(10) << n
+                  << std::setw(12) << pulls
+                  << std::setw(15) << g_stats.ds_pull_scanned
+                  << std::setw(15) << std::fixed << std::setprecision(1) << per_pull
+                  << "\n";
+
+        // Two whole-block prefixes plus the separator scan, independent of N
+        REQUIRE(per_pull <= 6.0 * M);
+    }
+    g_collect_stats = false;
+}
+
+TEST_CASE("PartialOrderDS block split throughput", "[partial_order_ds][benchmark]") {
+    constexpr int N = 100000;
+    vector<KeyValuePair> batch;
+    batch.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        batch.emplace_back(i, (long double)((i * 7919) % N));
+    }
+
+    auto insert_all = [&](int M) {
+        PartialOrderDS ds;
+        ds.Initialize(M, 1e9);
+        for (const auto& [key, value] : batch) {
+            ds.Insert(key, value);
+        }
+        return ds.total_elements();
+    };
+
+    REQUIRE(insert_all(16) == N);
+
+    // Same inserts without any splits isolate the cost of splitting
+    BENCHMARK("Insert 100k, M=1<<20 (no splits)") {
+        return insert_all(1 << 20);
+    };
+
+    BENCHMARK("Insert 100k, M=16 (split-heavy)") {
+        return insert_all(16);
+    };
+
+    BENCHMARK("BatchPrepend 100k, M=16") {
+        PartialOrderDS ds;
+        ds.Initialize(16, 1e9);
+        ds.BatchPrepend(batch);
+        return ds.total_elements();
+    };
+}
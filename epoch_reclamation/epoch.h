@@ -0,0 +1,319 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace epoch {
+
+// ============================================================================
+// Epoch-Based Reclamation
+// ============================================================================
+//
+// Readers pin the domain for the span in which they may hold pointers into
+// a concurrent structure. A writer that unlinks an object retires it instead
+// of deleting it; the object is freed once the global epoch has moved two
+// steps past its retirement, which can only happen after every reader that
+// was pinned at the time has unpinned.
+//
+// Each thread gets a cache-line-sized record in the domain: its pinned
+// epoch plus three limbo bags, one per epoch modulo 3. Retirement only
+// touches the caller's own record. Every RETIRE_BATCH retirements the
+// thread tries to advance the global epoch and frees its bags that are
+// old enough, so frees happen in batches off the read path.
+
+#if defined(__APPLE__) && defined(__aarch64__)
+inline constexpr size_t CACHE_LINE_SIZE = 128;
+#else
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+class Domain {
+    struct ThreadRecord;
+
+public:
+    static constexpr size_t RETIRE_BATCH = 64;
+
+    // RAII pin; nests, and must be released on the thread that took it
+    class Guard {
+    public:
+        Guard(Guard&& other) noexcept : record_(std::exchange(other.record_, nullptr)) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+        ~Guard() {
+            if (record_ != nullptr) Domain::unpin(*record_);
+        }
+
+    private:
+        friend class Domain;
+        explicit Guard(ThreadRecord* record) noexcept : record_(record) {}
+
+        ThreadRecord* record_;
+    };
+
+    Domain() : id_(next_domain_id()) {
+        std::lock_guard lock(live_domains_mutex());
+        live_domains().insert(id_);
+    }
+
+    // Frees everything still in limbo. No thread may be pinned, and no
+    // thread may use the domain afterwards.
+    ~Domain();
+
+    Domain(const Domain&) = delete;
+    Domain& operator=(const Domain&) = delete;
+
+    [[nodiscard]] Guard pin() {
+        ThreadRecord& record = local_record();
+        if (record.nesting++ == 0) {
+            const uint64_t global = global_epoch_.load(std::memory_order_relaxed);
+            record.state.store((global << 1) | ACTIVE, std::memory_order_relaxed);
+            // Publish the pin before any load of the protected structure
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return Guard(&record);
+    }
+
+    // Defers deleter(object) until no thread pinned now can still see it
+    void retire(void* object, void (*deleter)(void*));
+
+    template<typename T>
+    void retire(T* object) {
+        retire(static_cast<void*>(object), [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // Advances the epoch if every pinned thread has caught up, then frees
+    // the calling thread's eligible bags. Returns the number freed.
+    size_t collect();
+
+    // Drives the epoch forward until everything this thread retired is
+    // freed; only returns once other threads stop holding old pins
+    void drain();
+
+    [[nodiscard]] uint64_t epoch() const noexcept { return global_epoch_.load(std::memory_order_acquire); }
+    [[nodiscard]] size_t retired_count() const noexcept { return retired_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t reclaimed_count() const noexcept { return reclaimed_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t ACTIVE = 1;
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+    };
+
+    struct Bag {
+        uint64_t epoch = 0;
+        std::vector<Retired> objects;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ThreadRecord {
+        // (pinned epoch << 1) | ACTIVE while pinned; read by other threads
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        ThreadRecord* next = nullptr;
+        // Owner-only from here on
+        size_t nesting = 0;
+        size_t since_collect = 0;
+        std::array<Bag, 3> bags;
+    };
+
+    // One slot per domain a thread has touched. The domain pointer is only
+    // compared, never dereferenced, so a stale entry for a destroyed domain
+    // is harmless; the id tells a new domain at the same address apart.
+    struct LocalSlot {
+        const Domain* domain;
+        uint64_t domain_id;
+        ThreadRecord* record;
+    };
+
+    struct LocalRecords {
+        std::vector<LocalSlot> slots;
+        ~LocalRecords();
+    };
+
+    const uint64_t id_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> global_epoch_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<ThreadRecord*> records_{nullptr};
+    std::atomic<size_t> retired_{0};
+    std::atomic<size_t> reclaimed_{0};
+
+    static uint64_t next_domain_id() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Ids of live domains, so exiting threads only release records of
+    // domains that still exist
+    static std::unordered_set<uint64_t>& live_domains() {
+        static auto* ids = new std::unordered_set<uint64_t>;
+        return *ids;
+    }
+    static std::mutex& live_domains_mutex() {
+        static auto* mutex = new std::mutex;
+        return *mutex;
+    }
+
+    static LocalRecords& local_records() {
+        thread_local LocalRecords records;
+        return records;
+    }
+
+    ThreadRecord& local_record() {
+        auto& slots = local_records().slots;
+        for (const auto& slot : slots) {
+            if (slot.domain == this && slot.domain_id == id_) return *slot.record;
+        }
+        return register_thread();
+    }
+
+    ThreadRecord& register_thread();
+
+    static void unpin(ThreadRecord& record) noexcept {
+        if (--record.nesting == 0) {
+            record.state.store(record.state.load(std::memory_order_relaxed) & ~ACTIVE,
+                               std::memory_order_release);
+        }
+    }
+
+    bool try_advance() noexcept;
+    size_t free_bags_before(ThreadRecord& record, uint64_t safe_epoch) noexcept;
+    size_t free_bag(Bag& bag) noexcept;
+};
+
+inline Domain::ThreadRecord& Domain::register_thread() {
+    ThreadRecord* record = nullptr;
+
+    // Reuse a record left behind by an exited thread, limbo bags included
+    for (ThreadRecord* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+        bool expected = false;
+        if (!r->in_use.load(std::memory_order_relaxed) &&
+            r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            record = r;
+            break;
+        }
+    }
+
+    if (record == nullptr) {
+        record = new ThreadRecord;
+        record->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+    }
+
+    local_records().slots.push_back({this, id_, record});
+    return *record;
+}
+
+inline Domain::LocalRecords::~LocalRecords() {
+    std::lock_guard lock(live_domains_mutex());
+    for (const auto& slot : slots) {
+        if (!live_domains().contains(slot.domain_id)) continue;
+        slot.record->nesting = 0;
+        slot.record->state.store(0, std::memory_order_release);
+        slot.record->in_use.store(false, std::memory_order_release);
+    }
+}
+
+inline Domain::~Domain() {
+    {
+        std::lock_guard lock(live_domains_mutex());
+        live_domains().erase(id_);
+    }
+    auto& slots = local_records().slots;
+    std::erase_if(slots, [this](const LocalSlot& slot) { return slot.domain_id == id_; });
+
+    ThreadRecord* record = records_.load(std::memory_order_acquire);
+    while (record != nullptr) {
+        ThreadRecord* next = record->next;
+        for (auto& bag : record->bags) free_bag(bag);
+        delete record;
+        record = next;
+    }
+}
+
+inline bool Domain::try_advance() noexcept {
+    const uint64_t global = global_epoch_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (ThreadRecord* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+        const uint64_t state = r->state.load(std::memory_order_acquire);
+        if ((state & ACTIVE) && (state >> 1) != global) return false;
+    }
+    uint64_t expected = global;
+    return global_epoch_.compare_exchange_strong(expected, global + 1, std::memory_order_acq_rel);
+}
+
+inline size_t Domain::free_bag(Bag& bag) noexcept {
+    const size_t count = bag.objects.size();
+    for (const Retired& retired : bag.objects) retired.deleter(retired.object);
+    bag.objects.clear();
+    reclaimed_.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+inline size_t Domain::free_bags_before(ThreadRecord& record, uint64_t safe_epoch) noexcept {
+    size_t freed = 0;
+    for (Bag& bag : record.bags) {
+        if (!bag.objects.empty() && bag.epoch + 2 <= safe_epoch) freed += free_bag(bag);
+    }
+    return freed;
+}
+
+inline void Domain::retire(void* object, void (*deleter)(void*)) {
+    ThreadRecord& record = local_record();
+    const uint64_t global = global_epoch_.load(std::memory_order_acquire);
+
+    // A bag still tagged with an older epoch is at least three behind: free
+    Bag& bag = record.bags[global % 3];
+    if (bag.epoch != global) {
+        free_bag(bag);
+        bag.epoch = global;
+    }
+    bag.objects.push_back({object, deleter});
+    retired_.fetch_add(1, std::memory_order_relaxed);
+
+    if (++record.since_collect >= RETIRE_BATCH) {
+        record.since_collect = 0;
+        collect();
+    }
+}
+
+inline size_t Domain::collect() {
+    try_advance();
+    return free_bags_before(local_record(), global_epoch_.load(std::memory_order_acquire));
+}
+
+inline void Domain::drain() {
+    ThreadRecord& record = local_record();
+    auto pending = [&record] {
+        for (const Bag& bag : record.bags) {
+            if (!bag.objects.empty()) return true;
+        }
+        return false;
+    };
+    while (pending()) {
+        collect();
+    }
+}
+
+using Guard = Domain::Guard;
+
+// Process-wide domain used by the containers unless given another. Never
+// destroyed, so threads may exit in any order relative to static teardown.
+inline Domain& default_domain() {
+    static auto* domain = new Domain;
+    return *domain;
+}
+
+} // namespace epoch
+
+#endif // EPOCH_H
@@ -0,0 +1,205 @@
+#include "epoch.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace epoch;
+
+namespace {
+
+// Stand-in object whose deleter only marks it dead, so a reader touching
+// it after reclamation is detected rather than undefined
+struct Tracked {
+    std::atomic<bool> alive{true};
+    std::chrono::steady_clock::time_point retired_at;
+};
+
+void mark_dead(void* object) {
+    static_cast<Tracked*>(object)->alive.store(false, std::memory_order_relaxed);
+}
+
+std::atomic<int> deleted_ints{0};
+
+void delete_counted(void* object) {
+    delete static_cast<int*>(object);
+    deleted_ints.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+TEST_CASE("Retired objects are freed after two epochs", "[epoch]") {
+    Domain domain;
+    deleted_ints = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        auto guard = domain.pin();
+        domain.retire(new int(i), delete_counted);
+    }
+    REQUIRE(domain.retired_count() == 10);
+    REQUIRE(deleted_ints == 0);
+
+    domain.drain();
+    REQUIRE(deleted_ints == 10);
+    REQUIRE(domain.reclaimed_count() == 10);
+    REQUIRE(domain.epoch() >= 2);
+}
+
+TEST_CASE("A pinned reader holds back reclamation", "[epoch]") {
+    Domain domain;
+    Tracked object;
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&] {
+        auto guard = domain.pin();
+        pinned = true;
+        while (!release) std::this_thread::yield();
+        REQUIRE(object.alive);
+    });
+    while (!pinned) std::this_thread::yield();
+
+    domain.retire(&object, mark_dead);
+    for (int i = 0; i < 100; ++i) domain.collect();
+    REQUIRE(object.alive);
+    // The reader pinned the epoch, so the global epoch moved at most once
+    REQUIRE(domain.epoch() <= 1);
+
+    release = true;
+    reader.join();
+    domain.drain();
+    REQUIRE_FALSE(object.alive);
+}
+
+TEST_CASE("Guards nest and move", "[epoch]") {
+    Domain domain;
+    Tracked object;
+    {
+        auto outer = domain.pin();
+        domain.retire(&object, mark_dead);
+        {
+            auto inner = domain.pin();
+            auto moved = std::move(inner);
+        }
+        // Still pinned by outer: the epoch cannot pass us twice
+        for (int i = 0; i < 10; ++i) domain.collect();
+        REQUIRE(object.alive);
+    }
+    domain.drain();
+    REQUIRE_FALSE(object.alive);
+}
+
+TEST_CASE("Exited threads hand their records and limbo to new threads", "[epoch]") {
+    Domain domain;
+    deleted_ints = 0;
+
+    std::thread([&] {
+        for (int i = 0; i < 5; ++i) domain.retire(new int(i), delete_counted);
+    }).join();
+    REQUIRE(deleted_ints == 0);
+
+    std::thread([&] { domain.drain(); }).join();
+    REQUIRE(deleted_ints == 5);
+}
+
+TEST_CASE("Readers never see a reclaimed object under churn", "[epoch]") {
+    constexpr int kObjects = 20000;
+    Domain domain;
+    std::vector<Tracked> pool(kObjects);
+    std::atomic<Tracked*> current{&pool[0]};
+    std::atomic<bool> done{false};
+    std::atomic<int> violations{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                auto guard = domain.pin();
+                Tracked* seen = current.load(std::memory_order_acquire);
+                for (int spin = 0; spin < 16; ++spin) {
+                    if (!seen->alive.load(std::memory_order_relaxed)) violations.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i < kObjects; ++i) {
+        Tracked* old = current.exchange(&pool[i], std::memory_order_acq_rel);
+        domain.retire(old, mark_dead);
+        if (i % 64 == 0) std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+    domain.drain();
+
+    REQUIRE(violations == 0);
+    REQUIRE(domain.reclaimed_count() == kObjects - 1);
+}
+
+TEST_CASE("Epoch reclamation costs", "[benchmark]") {
+    Domain domain;
+    constexpr int kPins = 10'000'000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kPins; ++i) {
+        auto guard = domain.pin();
+        asm volatile("" ::: "memory");
+    }
+    double pin_ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kPins;
+
+    constexpr int kRetires = 2'000'000;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRetires; ++i) domain.retire(new int(i));
+    domain.drain();
+    double retire_ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kRetires;
+
+    std::cout << "\nEpoch reclamation\n" << std::fixed << std::setprecision(2);
+    std::cout << "  pin + unpin           " << std::setw(8) << pin_ns << " ns\n";
+    std::cout << "  retire + batched free " << std::setw(8) << retire_ns << " ns/object\n";
+
+    // Retire-to-free latency with readers pinning short critical sections
+    for (int readers : {0, 1, 3}) {
+        constexpr int kObjects = 200'000;
+        static std::vector<double> latencies_us;
+        latencies_us.clear();
+        latencies_us.reserve(kObjects);
+
+        std::vector<Tracked> pool(kObjects);
+        std::atomic<bool> done{false};
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto guard = domain.pin();
+                    for (int spin = 0; spin < 64; ++spin) asm volatile("" ::: "memory");
+                }
+            });
+        }
+
+        for (auto& object : pool) {
+            object.retired_at = std::chrono::steady_clock::now();
+            domain.retire(&object, [](void* p) {
+                auto* tracked = static_cast<Tracked*>(p);
+                latencies_us.push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - tracked->retired_at).count());
+            });
+        }
+        domain.drain();
+        done = true;
+        for (auto& thread : threads) thread.join();
+
+        std::sort(latencies_us.begin(), latencies_us.end());
+        auto at = [](double q) { return latencies_us[static_cast<size_t>(q * (latencies_us.size() - 1))]; };
+        std::cout << "  reclamation latency, " << readers << " pinning readers: p50 " << std::setw(8) << at(0.5)
+                  << " us  p99 " << std::setw(9) << at(0.99) << " us  max " << std::setw(9) << latencies_us.back()
+                  << " us\n";
+    }
+}
@@ -0,0 +1,291 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <unistd.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+// `make configure` in hardware_topology/ writes the detected line size and
+// calibrated prefetch distance here; -D on the command line also overrides
+#if __has_include("topology_config.h")
+#include "topology_config.h"
+#endif
+
+#ifndef TOPOLOGY_CACHE_LINE_SIZE
+#if defined(__APPLE__) && defined(__aarch64__)
+#define TOPOLOGY_CACHE_LINE_SIZE 128
+#else
+#define TOPOLOGY_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+#ifndef TOPOLOGY_PREFETCH_DISTANCE
+#define TOPOLOGY_PREFETCH_DISTANCE 8
+#endif
+
+namespace topology {
+
+// ============================================================================
+// Compile-Time Parameters
+// ============================================================================
+
+// Layout unit for padding and alignment (false-sharing boundary)
+inline constexpr size_t CACHE_LINE_SIZE = TOPOLOGY_CACHE_LINE_SIZE;
+// How many independent lookups ahead a batched probe prefetches
+inline constexpr size_t PREFETCH_DISTANCE = TOPOLOGY_PREFETCH_DISTANCE;
+
+static_assert(CACHE_LINE_SIZE >= 16 && (CACHE_LINE_SIZE & (CACHE_LINE_SIZE - 1)) == 0,
+              "TOPOLOGY_CACHE_LINE_SIZE must be a power of two of at least 16");
+
+// ============================================================================
+// Runtime Detection
+// ============================================================================
+
+// Sizes are in bytes; a cache level the platform does not report is 0
+struct Topology {
+    size_t cache_line_size = CACHE_LINE_SIZE;
+    size_t l1d_size = 0;
+    size_t l2_size = 0;
+    size_t llc_size = 0;
+    size_t page_size = 4096;
+    unsigned logical_cpus = 1;
+    unsigned numa_nodes = 1;
+};
+
+namespace detail {
+
+// Keeps the calibration loads from being optimized away
+inline volatile uint64_t escape_sink;
+
+// splitmix64 finalizer, standing in for a table's key hash
+inline uint64_t mix64(uint64_t key) noexcept {
+    uint64_t z = key + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Parses sysfs cache sizes: "48K", "2048K", "16M" or plain bytes
+inline size_t parse_size(const std::string& text) {
+    size_t value = 0;
+    size_t i = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+        value = value * 10 + static_cast<size_t>(text[i] - '0');
+    }
+    if (i < text.size()) {
+        switch (text[i]) {
+        case 'K': return value << 10;
+        case 'M': return value << 20;
+        case 'G': return value << 30;
+        default: break;
+        }
+    }
+    return value;
+}
+
+inline std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+#if defined(__linux__)
+// cpu0's cache hierarchy as the kernel describes it; the highest level
+// found is the LLC
+inline void read_sysfs_caches(Topology& topology) {
+    unsigned llc_level = 0;
+    for (int index = 0;; ++index) {
+        const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        const std::string level_text = read_line(dir + "level");
+        if (level_text.empty()) break;
+        const unsigned level = static_cast<unsigned>(std::stoul(level_text));
+        const std::string type = read_line(dir + "type");
+        const size_t size = parse_size(read_line(dir + "size"));
+        if (type == "Instruction") continue;
+
+        if (level == 1) {
+            topology.l1d_size = size;
+            if (const size_t line = parse_size(read_line(dir + "coherency_line_size"))) topology.cache_line_size = line;
+        } else if (level == 2) {
+            topology.l2_size = size;
+        }
+        if (level >= llc_level && size > 0) {
+            llc_level = level;
+            topology.llc_size = size;
+        }
+    }
+}
+
+inline void read_sysconf_caches(Topology& topology) {
+#if defined(_SC_LEVEL1_DCACHE_LINESIZE)
+    auto value = [](int name) { const long v = sysconf(name); return v > 0 ? static_cast<size_t>(v) : size_t{0}; };
+    if (const size_t line = value(_SC_LEVEL1_DCACHE_LINESIZE)) topology.cache_line_size = line;
+    if (!topology.l1d_size) topology.l1d_size = value(_SC_LEVEL1_DCACHE_SIZE);
+    if (!topology.l2_size) topology.l2_size = value(_SC_LEVEL2_CACHE_SIZE);
+    if (!topology.llc_size) {
+        topology.llc_size = std::max({value(_SC_LEVEL4_CACHE_SIZE), value(_SC_LEVEL3_CACHE_SIZE), topology.l2_size});
+    }
+#else
+    (void)topology;
+#endif
+}
+
+inline unsigned count_numa_nodes() {
+    unsigned nodes = 0;
+    while (std::ifstream("/sys/devices/system/node/node" + std::to_string(nodes) + "/cpulist")) ++nodes;
+    return std::max(nodes, 1u);
+}
+#endif
+
+#if defined(__APPLE__)
+inline size_t sysctl_size(const char* name) {
+    int64_t value = 0;
+    size_t length = sizeof(value);
+    return sysctlbyname(name, &value, &length, nullptr, 0) == 0 && value > 0 ? static_cast<size_t>(value) : 0;
+}
+#endif
+
+} // namespace detail
+
+// Reads the machine's cache sizes, line size, page size and NUMA node
+// count. Linux: /sys/devices/system/cpu/cpu0/cache and
+// /sys/devices/system/node, with sysconf filling what sysfs lacks. macOS:
+// sysctl hw.*. Anything unreported keeps the defaults above.
+inline Topology detect() {
+    Topology topology;
+    topology.logical_cpus = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__linux__)
+    if (const long page = sysconf(_SC_PAGESIZE); page > 0) topology.page_size = static_cast<size_t>(page);
+    detail::read_sysconf_caches(topology);
+    detail::read_sysfs_caches(topology);
+    topology.numa_nodes = detail::count_numa_nodes();
+#elif defined(__APPLE__)
+    if (const long page = sysconf(_SC_PAGESIZE); page > 0) topology.page_size = static_cast<size_t>(page);
+    if (const size_t line = detail::sysctl_size("hw.cachelinesize")) topology.cache_line_size = line;
+    topology.l1d_size = detail::sysctl_size("hw.l1dcachesize");
+    topology.l2_size = detail::sysctl_size("hw.l2cachesize");
+    topology.llc_size = std::max(detail::sysctl_size("hw.l3cachesize"), topology.l2_size);
+#endif
+    return topology;
+}
+
+// detect(), run once per process
+inline const Topology& host() {
+    static const Topology topology = detect();
+    return topology;
+}
+
+// ============================================================================
+// Prefetch Distance Calibration
+// ============================================================================
+
+struct PrefetchCalibration {
+    size_t distance = PREFETCH_DISTANCE;   // fastest lookahead, in lookups
+    double ns_per_lookup = 0.0;            // at that distance
+    double ns_without_prefetch = 0.0;      // distance 0
+    std::vector<size_t> distances;         // candidates tried, ascending
+    std::vector<double> ns_by_distance;    // median time for each candidate
+};
+
+// Times run_batch(distance), which performs `lookups` lookups prefetching
+// `distance` ahead, for distances from 0 to 64. Candidates take turns
+// within each of five repeats, so drift in the machine's state hits them
+// all alike, and each keeps its median time. Returns the shortest distance
+// within 5% of the fastest: past the knee of the curve the differences
+// are run-to-run noise, and a longer distance only keeps more lines in
+// flight. Pass a table's own batched lookup to tune for it.
+template<typename BatchFn>
+    requires std::invocable<BatchFn&, size_t>
+PrefetchCalibration calibrate_prefetch_distance(BatchFn&& run_batch, size_t lookups) {
+    constexpr int REPEATS = 5;
+    PrefetchCalibration result;
+    result.distances = {0, 1, 2, 4, 6, 8, 12, 16, 24, 32, 48, 64};
+    std::vector<std::array<double, REPEATS>> samples(result.distances.size());
+
+    run_batch(size_t{0});
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+        for (size_t c = 0; c < result.distances.size(); ++c) {
+            const auto start = std::chrono::steady_clock::now();
+            run_batch(result.distances[c]);
+            samples[c][repeat] =
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / lookups;
+        }
+    }
+    for (auto& times : samples) {
+        std::nth_element(times.begin(), times.begin() + REPEATS / 2, times.end());
+        result.ns_by_distance.push_back(times[REPEATS / 2]);
+    }
+
+    const double fastest = *std::min_element(result.ns_by_distance.begin(), result.ns_by_distance.end());
+    for (size_t c = 0; c < result.distances.size(); ++c) {
+        if (result.ns_by_distance[c] <= fastest * 1.05) {
+            result.distance = result.distances[c];
+            result.ns_per_lookup = result.ns_by_distance[c];
+            break;
+        }
+    }
+    result.ns_without_prefetch = result.ns_by_distance.front();
+    return result;
+}
+
+// Calibrates on a stand-in for a batched hash lookup over a table well
+// past the LLC: hash the key, walk from its home line to a line whose
+// first word is odd (one or more lines, at random), with the home line of
+// the key `distance` lookups ahead prefetched. The random walk length
+// matters: its branch mispredicts are what limit how many lookups overlap
+// without help, and a loop of plain independent loads gains nothing from
+// prefetch. working_set 0 means four times the LLC, kept between 64 MiB
+// and 512 MiB. Takes a few seconds.
+inline PrefetchCalibration calibrate_prefetch_distance(size_t working_set = 0) {
+    const Topology& machine = host();
+    const size_t line = std::max<size_t>(machine.cache_line_size, sizeof(uint64_t));
+    if (working_set == 0) {
+        working_set = std::clamp<size_t>(machine.llc_size * 4, size_t{64} << 20, size_t{512} << 20);
+    }
+    const size_t lines = std::bit_floor(std::max<size_t>(working_set / line, 1024));
+    const size_t mask = lines - 1;
+    const size_t words_per_line = line / sizeof(uint64_t);
+
+    std::mt19937_64 rng(0x5eed);
+    std::unique_ptr<uint64_t[]> buffer(new uint64_t[lines * words_per_line]);
+    for (size_t i = 0; i < lines; ++i) buffer[i * words_per_line] = rng();
+
+    constexpr size_t LOOKUPS = 1 << 18;
+    constexpr size_t MAX_DISTANCE = 64;
+    std::vector<uint64_t> keys(LOOKUPS + MAX_DISTANCE);
+    for (auto& key : keys) key = rng();
+
+    uint64_t sink = 0;
+    PrefetchCalibration result = calibrate_prefetch_distance([&](size_t distance) {
+        for (size_t i = 0; i < LOOKUPS; ++i) {
+            if (distance) __builtin_prefetch(&buffer[(detail::mix64(keys[i + distance]) & mask) * words_per_line], 0, 3);
+            size_t index = detail::mix64(keys[i]) & mask;
+            while ((buffer[index * words_per_line] & 1) == 0) index = (index + 1) & mask;
+            sink += buffer[index * words_per_line];
+        }
+    }, LOOKUPS);
+    detail::escape_sink = sink;
+    return result;
+}
+
+} // namespace topology
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,25 @@
+// Prints a topology_config.h for this machine: the detected cache line
+// size and the calibrated prefetch distance. `make configure` writes it
+// next to topology.h, which picks it up on the next build.
+
+#include "topology.h"
+
+#include <iostream>
+
+int main() {
+    const topology::Topology& machine = topology::host();
+    const topology::PrefetchCalibration calibration = topology::calibrate_prefetch_distance();
+
+    std::cout << "// Generated by topology_probe (make configure); delete to use the defaults\n"
+              << "#ifndef TOPOLOGY_CACHE_LINE_SIZE\n"
+              << "#define TOPOLOGY_CACHE_LINE_SIZE " << machine.cache_line_size << "\n"
+              << "#endif\n"
+              << "#ifndef TOPOLOGY_PREFETCH_DISTANCE\n"
+              << "#define TOPOLOGY_PREFETCH_DISTANCE " << calibration.distance << "\n"
+              << "#endif\n";
+
+    std::cerr << "cache line " << machine.cache_line_size << " B, prefetch distance " << calibration.distance
+              << " (" << calibration.ns_per_lookup << " ns/lookup vs " << calibration.ns_without_prefetch
+              << " without)\n";
+    return 0;
+}
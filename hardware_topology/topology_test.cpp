@@ -0,0 +1,77 @@
+#include "topology.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace topology;
+
+TEST_CASE("sysfs cache sizes parse with their suffixes", "[topology]") {
+    REQUIRE(detail::parse_size("48K") == 48 * 1024);
+    REQUIRE(detail::parse_size("2048K") == 2 * 1024 * 1024);
+    REQUIRE(detail::parse_size("16M") == 16 * 1024 * 1024);
+    REQUIRE(detail::parse_size("64") == 64);
+    REQUIRE(detail::parse_size("") == 0);
+}
+
+TEST_CASE("Detected topology is self-consistent", "[topology]") {
+    const Topology& machine = host();
+    REQUIRE(&machine == &host());
+
+    REQUIRE(std::has_single_bit(machine.cache_line_size));
+    REQUIRE(machine.cache_line_size >= 16);
+    REQUIRE(std::has_single_bit(machine.page_size));
+    REQUIRE(machine.logical_cpus >= 1);
+    REQUIRE(machine.numa_nodes >= 1);
+    if (machine.l1d_size && machine.l2_size) REQUIRE(machine.l2_size >= machine.l1d_size);
+    if (machine.l2_size && machine.llc_size) REQUIRE(machine.llc_size >= machine.l2_size);
+
+    REQUIRE(std::has_single_bit(CACHE_LINE_SIZE));
+    REQUIRE(CACHE_LINE_SIZE == TOPOLOGY_CACHE_LINE_SIZE);
+    REQUIRE(PREFETCH_DISTANCE == TOPOLOGY_PREFETCH_DISTANCE);
+}
+
+TEST_CASE("Calibration picks the shortest distance near the fastest", "[topology]") {
+    // A workload that takes 200 us without enough lookahead and 100 us from
+    // distance 8 on, give or take 2%
+    auto spin = [](double microseconds) {
+        const auto until = std::chrono::steady_clock::now() + std::chrono::duration<double, std::micro>(microseconds);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    };
+    size_t calls = 0;
+    const PrefetchCalibration result = calibrate_prefetch_distance([&](size_t distance) {
+        ++calls;
+        spin(distance < 8 ? 200.0 : 100.0 + static_cast<double>(distance % 3));
+    }, 1000);
+
+    REQUIRE(result.distance == 8);
+    REQUIRE(result.distances.size() == result.ns_by_distance.size());
+    REQUIRE(result.distances.front() == 0);
+    REQUIRE(calls == 1 + 5 * result.distances.size());
+    REQUIRE(result.ns_without_prefetch == result.ns_by_distance.front());
+    REQUIRE(result.ns_without_prefetch > 1.5 * result.ns_per_lookup);
+    REQUIRE(result.ns_per_lookup >= 100.0);
+}
+
+TEST_CASE("Host topology and prefetch distance", "[benchmark]") {
+    const Topology& machine = host();
+    std::cout << "\nHost: " << machine.logical_cpus << " logical CPUs, " << machine.numa_nodes << " NUMA node(s), "
+              << machine.cache_line_size << " B lines, " << machine.page_size << " B pages\n"
+              << "  L1d " << (machine.l1d_size >> 10) << " KiB, L2 " << (machine.l2_size >> 10) << " KiB, LLC "
+              << (machine.llc_size >> 20) << " MiB\n"
+              << "  compiled with CACHE_LINE_SIZE " << CACHE_LINE_SIZE << ", PREFETCH_DISTANCE " << PREFETCH_DISTANCE
+              << "\n";
+
+    const PrefetchCalibration calibration = calibrate_prefetch_distance();
+    std::cout << "\nBatched probe stand-in, ns/lookup by prefetch distance:\n ";
+    for (size_t c = 0; c < calibration.distances.size(); ++c) {
+        std::cout << " " << calibration.distances[c] << ":" << std::fixed << std::setprecision(1)
+                  << calibration.ns_by_distance[c];
+    }
+    std::cout << "\n  chosen distance " << calibration.distance << " (" << calibration.ns_per_lookup << " vs "
+              << calibration.ns_without_prefetch << " ns without prefetch)\n";
+}
@@ -0,0 +1,273 @@
+#ifndef COMPRESSED_CACHE_H
+#define COMPRESSED_CACHE_H
+
+#include "lru_cache.h"
+
+#include <array>
+#include <cstring>
+
+using namespace std;
+
+template <typename C>
+concept ValueCodec = requires(string_view input, string& output) {
+    { C::compress(input, output) } -> same_as<void>;
+    { C::decompress(input, output) } -> same_as<bool>;
+};
+
+// Stores values as given
+struct IdentityCodec {
+    static void compress(string_view input, string& output) { output.assign(input); }
+    static bool decompress(string_view input, string& output) {
+        output.assign(input);
+        return true;
+    }
+};
+
+// Byte-oriented LZ77 in the LZ4 block layout: a varint of the raw size,
+// then sequences of [token][literal-length ext][literals][offset u16]
+// [match-length ext]. Greedy matching over a 4K-entry hash of 4-byte
+// prefixes; the last sequence carries literals only. Decoding checks every
+// length and offset, so corrupt input is rejected rather than overrun.
+struct LzCodec {
+    static constexpr size_t MIN_MATCH = 4;
+    static constexpr size_t MAX_OFFSET = 65535;
+    static constexpr int HASH_BITS = 12;
+    // Matches stop this far from the end so the final literals are never empty
+    static constexpr size_t END_LITERALS = 5;
+
+    static void compress(string_view input, string& output);
+    static bool decompress(string_view input, string& output);
+
+private:
+    static uint32_t load32(const char* p) noexcept {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static void put_length(string& output, size_t length) {
+        for (; length >= 255; length -= 255) {
+            output.push_back(static_cast<char>(255));
+        }
+        output.push_back(static_cast<char>(length));
+    }
+
+    static bool get_length(const unsigned char*& in, const unsigned char* end, size_t& length) {
+        for (;;) {
+            if (in == end) {
+                return false;
+            }
+            const auto extra = *in++;
+            length += extra;
+            if (extra != 255) {
+                return true;
+            }
+        }
+    }
+
+    static void put_sequence(string& output, string_view literals, size_t offset, size_t match_length);
+};
+
+inline void LzCodec::put_sequence(string& output, string_view literals, size_t offset, size_t match_length) {
+    const auto literal_nibble = min<size_t>(literals.size(), 15);
+    const auto match_nibble = match_length == 0 ? 0 : min<size_t>(match_length - MIN_MATCH, 15);
+    output.push_back(static_cast<char>((literal_nibble << 4) | match_nibble));
+    if (literal_nibble == 15) {
+        put_length(output, literals.size() - 15);
+    }
+    output.append(literals);
+
+    if (match_length == 0) {
+        return;
+    }
+    output.push_back(static_cast<char>(offset & 0xff));
+    output.push_back(static_cast<char>(offset >> 8));
+    if (match_nibble == 15) {
+        put_length(output, match_length - MIN_MATCH - 15);
+    }
+}
+
+inline void LzCodec::compress(string_view input, string& output) {
+    output.clear();
+    for (auto size = input.size(); ; size >>= 7) {
+        output.push_back(static_cast<char>((size & 0x7f) | (size >= 0x80 ? 0x80 : 0)));
+        if (size < 0x80) {
+            break;
+        }
+    }
+
+    const auto* data = input.data();
+    const auto n = input.size();
+    size_t anchor = 0;
+
+    if (n > MIN_MATCH + END_LITERALS) {
+        array<uint32_t, size_t{1} << HASH_BITS> table{};
+        const auto match_limit = n - END_LITERALS;
+
+        for (size_t i = 0; i + MIN_MATCH <= match_limit;) {
+            const auto sequence = load32(data + i);
+            const auto slot = (sequence * 2654435761u) >> (32 - HASH_BITS);
+            const size_t candidate = table[slot];
+            table[slot] = static_cast<uint32_t>(i);
+
+            if (candidate >= i || i - candidate > MAX_OFFSET || load32(data + candidate) != sequence) {
+                // Skip faster through incompressible stretches
+                i += 1 + ((i - anchor) >> 6);
+                continue;
+            }
+
+            auto length = MIN_MATCH;
+            while (i + length < match_limit && data[candidate + length] == data[i + length]) {
+                ++length;
+            }
+
+            put_sequence(output, input.substr(anchor, i - anchor), i - candidate, length);
+            i += length;
+            anchor = i;
+        }
+    }
+
+    put_sequence(output, input.substr(anchor), 0, 0);
+}
+
+inline bool LzCodec::decompress(string_view input, string& output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+    const auto* end = in + input.size();
+
+    size_t size = 0;
+    for (int shift = 0;; shift += 7) {
+        if (in == end || shift > 56) {
+            return false;
+        }
+        const auto byte_value = *in++;
+        size |= static_cast<size_t>(byte_value & 0x7f) << shift;
+        if ((byte_value & 0x80) == 0) {
+            break;
+        }
+    }
+
+    // A match byte can stand for at most 255 output bytes; larger claims are corrupt
+    if (size / 255 > input.size()) {
+        return false;
+    }
+
+    output.resize(size);
+    auto* out = output.data();
+    size_t written = 0;
+
+    while (in != end) {
+        const auto token = *in++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !get_length(in, end, literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(end - in) || literals > size - written) {
+            return false;
+        }
+        memcpy(out + written, in, literals);
+        in += literals;
+        written += literals;
+
+        if (in == end) {
+            break;
+        }
+
+        if (end - in < 2) {
+            return false;
+        }
+        const size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t length = (token & 0x0f) + MIN_MATCH;
+        if ((token & 0x0f) == 15 && !get_length(in, end, length)) {
+            return false;
+        }
+        if (offset == 0 || offset > written || length > size - written) {
+            return false;
+        }
+
+        // Overlapping copies (offset < length) replicate the pattern
+        const auto* source = out + written - offset;
+        if (offset >= length) {
+            memcpy(out + written, source, length);
+        } else {
+            for (size_t k = 0; k < length; ++k) {
+                out[written + k] = source[k];
+            }
+        }
+        written += length;
+    }
+
+    return written == size;
+}
+
+// String values held compressed under a byte budget. The budget counts
+// stored (compressed) value bytes; max_entries sizes the node arena, so set
+// it to the budget over the smallest expected compressed value. get()
+// decompresses into the caller's buffer, which keeps its capacity between
+// calls.
+template <Hashable K, ValueCodec Codec = LzCodec>
+class CompressedCache {
+public:
+    CompressedCache(size_t byte_budget, size_t max_entries) : entries_(max_entries), budget_(byte_budget) {
+        entries_.set_eviction_handler([this](K&&, string&& value) { bytes_ -= value.size(); });
+    }
+
+    // The eviction handler points back at this object
+    CompressedCache(const CompressedCache&) = delete;
+    CompressedCache& operator=(const CompressedCache&) = delete;
+
+    template <typename KeyLike>
+    bool get(const KeyLike& key, string& out) {
+        const auto* stored = entries_.get(key);
+        return stored != nullptr && Codec::decompress(*stored, out);
+    }
+
+    template <typename KeyLike>
+    bool has(const KeyLike& key) const {
+        return entries_.has(key);
+    }
+
+    // False when the value cannot fit in the budget even compressed
+    template <typename KType>
+    bool set(KType&& key, string_view value);
+
+    size_t size() const noexcept { return entries_.size(); }
+    size_t bytes() const noexcept { return bytes_; }
+    size_t byte_budget() const noexcept { return budget_; }
+
+private:
+    LRUCache<K, string> entries_;
+    size_t budget_;
+    size_t bytes_ = 0;
+    string scratch_;
+};
+
+template <Hashable K, ValueCodec Codec>
+template <typename KType>
+bool CompressedCache<K, Codec>::set(KType&& key, string_view value) {
+    Codec::compress(value, scratch_);
+    if (scratch_.size() > budget_) {
+        return false;
+    }
+    const auto stored_size = scratch_.size();
+
+    if (auto* existing = entries_.get(key)) {
+        bytes_ = bytes_ - existing->size() + stored_size;
+        existing->swap(scratch_);
+    } else {
+        while (bytes_ + stored_size > budget_ && entries_.evict()) {
+        }
+        if (!entries_.set(std::forward<KType>(key), std::move(scratch_))) {
+            return false;
+        }
+        bytes_ += stored_size;
+    }
+
+    // An update that grew the value may still be over budget; the updated
+    // entry is MRU, so it goes last
+    while (bytes_ > budget_ && entries_.evict()) {
+    }
+    return true;
+}
+
+#endif
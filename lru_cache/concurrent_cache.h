@@ -0,0 +1,86 @@
+#ifndef CONCURRENT_CACHE_H
+#define CONCURRENT_CACHE_H
+
+#include "lru_cache.h"
+#include "epoch.h"
+
+#include <mutex>
+
+using namespace std;
+
+// LRUCache shared between threads. Values live in their own allocations and
+// the cache holds pointers to them; evicting or overwriting an entry retires
+// the old value to an epoch domain instead of destroying it. get() takes the
+// caller's Guard and returns a pointer that stays valid until the guard is
+// released, even if another thread evicts the key meanwhile, so readers use
+// values in place without copying them out under the lock. The lock still
+// covers every lookup, since a hit moves the entry to the MRU position.
+template <Hashable K, typename V>
+class ConcurrentLRUCache {
+public:
+    explicit ConcurrentLRUCache(size_t capacity, epoch::Domain& domain = epoch::default_domain())
+        : entries_(capacity), domain_(domain) {
+        entries_.set_eviction_handler([this](K&&, V*&& value) { domain_.retire(value); });
+    }
+
+    // Values still cached are retired, not freed, so a reader pinned
+    // elsewhere keeps them
+    ~ConcurrentLRUCache() { clear(); }
+
+    ConcurrentLRUCache(const ConcurrentLRUCache&) = delete;
+    ConcurrentLRUCache& operator=(const ConcurrentLRUCache&) = delete;
+
+    epoch::Guard pin() const { return domain_.pin(); }
+
+    const V* get(const K& key, const epoch::Guard&) {
+        lock_guard lock(mutex_);
+        auto** value = entries_.get(key);
+        return value == nullptr ? nullptr : *value;
+    }
+
+    template <typename KType, typename VType>
+    bool set(KType&& key, VType&& value);
+
+    bool evict() {
+        lock_guard lock(mutex_);
+        return entries_.evict();
+    }
+
+    void clear() {
+        lock_guard lock(mutex_);
+        for (auto [key, value] : entries_) {
+            domain_.retire(value);
+        }
+        entries_.clear();
+    }
+
+    size_t size() const {
+        lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    mutable mutex mutex_;
+    LRUCache<K, V*> entries_;
+    epoch::Domain& domain_;
+};
+
+template <Hashable K, typename V>
+template <typename KType, typename VType>
+bool ConcurrentLRUCache<K, V>::set(KType&& key, VType&& value) {
+    // Built outside the lock; a failed insert hands it straight back
+    auto fresh = make_unique<V>(std::forward<VType>(value));
+
+    lock_guard lock(mutex_);
+    if (auto** current = entries_.get(key)) {
+        domain_.retire(exchange(*current, fresh.release()));
+        return true;
+    }
+    if (!entries_.set(std::forward<KType>(key), fresh.get())) {
+        return false;
+    }
+    fresh.release();
+    return true;
+}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef CORO_CACHE_H
+#define CORO_CACHE_H
+
+#include "lru_cache.h"
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <variant>
+
+using namespace std;
+
+template <typename T = void>
+class Task;
+
+namespace task_detail {
+
+// Resumes whoever awaited the task, or nothing for a detached task
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    coroutine_handle<> await_suspend(coroutine_handle<Promise> handle) noexcept {
+        if (auto continuation = handle.promise().continuation) {
+            return continuation;
+        }
+        return noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    coroutine_handle<> continuation;
+    exception_ptr error;
+
+    suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (error) {
+            rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+
+    void take() const {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+};
+
+}  // namespace task_detail
+
+// Lazily started coroutine. Awaiting it starts the body and resumes the
+// awaiter by symmetric transfer when the body finishes, so chains of tasks
+// do not grow the stack.
+template <typename T>
+class Task {
+public:
+    using promise_type = task_detail::Promise<T>;
+
+    explicit Task(coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool done() const noexcept { return !handle_ || handle_.done(); }
+    coroutine_handle<promise_type> handle() const noexcept { return handle_; }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+            coroutine_handle<> await_suspend(coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    coroutine_handle<promise_type> handle_;
+};
+
+namespace task_detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+}  // namespace task_detail
+
+// Single-threaded run queue. spawn() adopts a task and queues its start;
+// co_await schedule() requeues the caller behind everything already ready.
+// run() drains the queue and rethrows the first exception a spawned task
+// ended with.
+class SingleThreadExecutor {
+public:
+    void post(coroutine_handle<> handle) { ready_.push_back(handle); }
+
+    void spawn(Task<> task) {
+        spawned_.push_back(std::move(task));
+        try {
+            post(spawned_.back().handle());
+        } catch (...) {
+            spawned_.pop_back();
+            throw;
+        }
+    }
+
+    auto schedule() noexcept {
+        struct Awaiter {
+            SingleThreadExecutor& executor;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(coroutine_handle<> handle) { executor.post(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    void run();
+
+    size_t pending() const noexcept { return ready_.size(); }
+
+private:
+    deque<coroutine_handle<>> ready_;
+    vector<Task<>> spawned_;
+};
+
+inline void SingleThreadExecutor::run() {
+    while (!ready_.empty()) {
+        auto handle = ready_.front();
+        ready_.pop_front();
+        handle.resume();
+    }
+
+    // Finished tasks are reaped here; a task still suspended on something
+    // outside the executor stays owned until a later run() sees it done
+    exception_ptr first_error;
+    erase_if(spawned_, [&](Task<>& task) {
+        if (!task.done()) {
+            return false;
+        }
+        if (!first_error && task.handle().promise().error) {
+            first_error = task.handle().promise().error;
+        }
+        return true;
+    });
+    if (first_error) {
+        rethrow_exception(first_error);
+    }
+}
+
+// LRUCache with an awaitable loading get. co_get() on a hit completes
+// without suspending and without allocating a coroutine frame. On a miss
+// the caller suspends; the first miss for a key spawns loader(key) on the
+// executor and later misses for the same key join it, so one load serves
+// every awaiter. When the load lands the value is cached and the awaiters
+// are queued on the executor; a loader exception is rethrown to each of
+// them and nothing is cached. A loader that throws before returning its
+// task fails only the awaiter that called it; no load is recorded, so the
+// next miss calls the loader again. Values are returned by copy, as the cached
+// entry may be evicted before a resumed awaiter runs. The loader is held by
+// reference and must outlive the loads it starts.
+template <Hashable K, typename V>
+class AsyncLoadingCache {
+    struct InFlight {
+        vector<coroutine_handle<>> waiters;
+        variant<monostate, V, exception_ptr> result;
+    };
+
+public:
+    AsyncLoadingCache(size_t capacity, SingleThreadExecutor& executor) : entries_(capacity), executor_(executor) {}
+
+    // The loader tasks point back at this object
+    AsyncLoadingCache(const AsyncLoadingCache&) = delete;
+    AsyncLoadingCache& operator=(const AsyncLoadingCache&) = delete;
+
+    template <typename Loader>
+        requires invocable<Loader&, const K&> && same_as<invoke_result_t<Loader&, const K&>, Task<V>>
+    auto co_get(const K& key, Loader& loader) {
+        struct Awaiter {
+            AsyncLoadingCache& cache;
+            const K& key;
+            Loader& loader;
+            V* hit;
+            shared_ptr<InFlight> load;
+
+            bool await_ready() const noexcept { return hit != nullptr; }
+
+            // An exception thrown here resumes the caller with it. The load
+            // is spawned before it is published, so a loader or allocation
+            // failure never leaves an entry that no load will complete.
+            void await_suspend(coroutine_handle<> awaiting) {
+                auto it = cache.in_flight_.find(key);
+                if (it == cache.in_flight_.end()) {
+                    auto started = make_shared<InFlight>();
+                    cache.executor_.spawn(cache.complete_load(key, started, loader(key)));
+                    ++cache.loads_started_;
+                    it = cache.in_flight_.emplace(key, std::move(started)).first;
+                }
+                load = it->second;
+                load->waiters.push_back(awaiting);
+            }
+
+            V await_resume() {
+                if (hit != nullptr) {
+                    return *hit;
+                }
+                if (auto* error = get_if<exception_ptr>(&load->result)) {
+                    rethrow_exception(*error);
+                }
+                return std::get<V>(load->result);
+            }
+        };
+        return Awaiter{*this, key, loader, entries_.get(key), nullptr};
+    }
+
+    V* get(const K& key) { return entries_.get(key); }
+
+    template <typename KType, typename VType>
+    bool set(KType&& key, VType&& value) {
+        return entries_.set(std::forward<KType>(key), std::forward<VType>(value));
+    }
+
+    size_t size() const noexcept { return entries_.size(); }
+    size_t loads_in_flight() const noexcept { return in_flight_.size(); }
+    size_t loads_started() const noexcept { return loads_started_; }
+
+private:
+    LRUCache<K, V> entries_;
+    SingleThreadExecutor& executor_;
+    unordered_map<K, shared_ptr<InFlight>> in_flight_;
+    size_t loads_started_ = 0;
+
+    Task<> complete_load(K key, shared_ptr<InFlight> load, Task<V> work);
+};
+
+template <Hashable K, typename V>
+Task<> AsyncLoadingCache<K, V>::complete_load(K key, shared_ptr<InFlight> load, Task<V> work) {
+    try {
+        load->result.template emplace<V>(co_await std::move(work));
+        (void)entries_.set(key, std::get<V>(load->result));
+    } catch (...) {
+        load->result.template emplace<exception_ptr>(current_exception());
+    }
+
+    in_flight_.erase(key);
+    for (auto waiter : load->waiters) {
+        executor_.post(waiter);
+    }
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef INTERNED_KEYS_H
+#define INTERNED_KEYS_H
+
+#include "lru_cache.h"
+#include "intern.h"
+
+using namespace std;
+
+// Text lookups for LRUCache<intern::Symbol, V>: get("AAPL") and
+// has(string_view) match against the symbols' text without touching the
+// pool, since std::hash<intern::Symbol> is the hash of the text
+template <>
+struct LookupTraits<intern::Symbol> {
+    static size_t hash(string_view key) { return intern::hash_text(key); }
+    static bool equal(const intern::Symbol& stored, string_view key) { return stored.view() == key; }
+};
+
+#endif // INTERNED_KEYS_H
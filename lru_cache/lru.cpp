@@ -1,9 +1,29 @@
 #include "lru_cache.h"
+#include "arena.h"
+#include "compressed_cache.h"
+#include "concurrent_cache.h"
+#include "coro_cache.h"
+#include "interned_keys.h"
+#include "negative_cache.h"
+#include "refresh_ahead_cache.h"
+#include "tiered_cache.h"
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
 #include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 
@@ -81,6 +101,8 @@ int main() {
 
 #include "catch_amalgamated.hpp"
 
+#include <iostream>
+
 namespace {
 
 constexpr int kSetOps = 10000;
@@ -131,6 +153,128 @@ vector<vector<unique_ptr<V>>> make_unique_payloads(int runs, int count) {
     return payloads;
 }
 
+// Trace keys are opaque ids: scramble the generator's dense ints so the
+// index sees realistic hashes (std::hash<uint64_t> is the identity)
+uint64_t scramble(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Day-in-the-life trace alternating two phases. Recency: requests drift
+// through a window slightly larger than the cache. Frequency: a hot set of
+// 3/4 of the cache, broken up by bursts of one-off keys (batch jobs,
+// crawlers) that each flush a plain LRU.
+vector<uint64_t> make_phase_trace(size_t capacity, int phases, int ops_per_phase) {
+    mt19937_64 rng(42);
+    vector<uint64_t> trace;
+    trace.reserve(static_cast<size_t>(phases) * ops_per_phase);
+    uint64_t fresh = 1'000'000'000;
+
+    for (int phase = 0; phase < phases; ++phase) {
+        if (phase % 2 == 0) {
+            const uint64_t window = capacity + capacity / 4;
+            for (int i = 0; i < ops_per_phase; ++i) {
+                trace.push_back(scramble(fresh + static_cast<uint64_t>(i) / 4 + rng() % window));
+            }
+            fresh += ops_per_phase / 4 + window;
+        } else {
+            const uint64_t hot = capacity * 3 / 4;
+            const uint64_t hot_base = static_cast<uint64_t>(phase) << 32;
+            for (int i = 0; i < ops_per_phase; ++i) {
+                if (i % static_cast<int>(6 * capacity) < static_cast<int>(5 * capacity)) {
+                    trace.push_back(scramble(hot_base + rng() % hot));
+                } else {
+                    trace.push_back(scramble(fresh++));
+                }
+            }
+        }
+    }
+    return trace;
+}
+
+template <typename Cache>
+size_t replay_trace(Cache& cache, span<const uint64_t> trace) {
+    size_t hits = 0;
+    for (const auto key : trace) {
+        if (cache.get(key) != nullptr) {
+            ++hits;
+        } else {
+            (void)cache.set(key, key);
+        }
+    }
+    return hits;
+}
+
+// Scratch directory for file-tier tests, removed with its contents
+struct TempDir {
+    filesystem::path path;
+
+    TempDir() {
+        auto pattern = (filesystem::temp_directory_path() / "lru_tier_XXXXXX").string();
+        if (mkdtemp(pattern.data()) == nullptr) {
+            throw system_error(errno, generic_category(), "mkdtemp");
+        }
+        path = pattern;
+    }
+
+    ~TempDir() {
+        error_code ignored;
+        filesystem::remove_all(path, ignored);
+    }
+};
+
+span<const byte> bytes_of(string_view text) {
+    return as_bytes(span(text.data(), text.size()));
+}
+
+string string_of(const vector<byte>& bytes) {
+    return string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// ~8 KB JSON documents: repeated field names and a small value vocabulary,
+// so they compress roughly the way API payloads do
+string make_json_blob(mt19937_64& rng, size_t target_bytes) {
+    static constexpr array<string_view, 8> kStatus{"active", "pending", "suspended", "closed",
+                                                   "trial", "archived", "review", "migrated"};
+    static constexpr array<string_view, 6> kRegion{"us-east-1", "us-west-2", "eu-west-1",
+                                                   "eu-central-1", "ap-south-1", "sa-east-1"};
+    string blob = "{\"items\":[";
+    while (blob.size() < target_bytes) {
+        blob += "{\"id\":" + to_string(rng() % 100000);
+        blob += ",\"status\":\"" + string(kStatus[rng() % kStatus.size()]);
+        blob += "\",\"region\":\"" + string(kRegion[rng() % kRegion.size()]);
+        blob += "\",\"score\":" + to_string(rng() % 1000);
+        blob += ",\"tags\":[\"billing\",\"priority-" + to_string(rng() % 4) + "\"]},";
+    }
+    blob.back() = ']';
+    blob += '}';
+    return blob;
+}
+
+// Test clock for the refresh-ahead cache, advanced by hand
+struct ManualClock {
+    using rep = int64_t;
+    using period = milli;
+    using duration = chrono::milliseconds;
+    using time_point = chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline atomic<int64_t> ticks{0};
+    static time_point now() noexcept { return time_point(duration(ticks.load())); }
+};
+
+// Awaits key through cache and appends the value, or -1 if the load threw
+template <typename Loader>
+Task<> read_into(AsyncLoadingCache<int, int>& cache, int key, Loader& loader, vector<int>& out) {
+    try {
+        out.push_back(co_await cache.co_get(key, loader));
+    } catch (const runtime_error&) {
+        out.push_back(-1);
+    }
+}
+
 struct NoDefault {
     int value;
 
@@ -228,6 +372,33 @@ TEST_CASE("LRUCache string literal lookups", "[lru]") {
     }
 }
 
+TEST_CASE("LRUCache with interned keys", "[lru]") {
+    intern::Pool pool;
+    LRUCache<intern::Symbol, int> cache(2);
+    const auto aapl = pool.intern("AAPL");
+    const auto msft = pool.intern("MSFT");
+    REQUIRE(cache.set(aapl, 1));
+    REQUIRE(cache.set(msft, 2));
+
+    SECTION("handles from the pool find their entries") {
+        REQUIRE(*cache.get(pool.intern("AAPL")) == 1);
+        REQUIRE(cache.get(intern::Symbol{}) == nullptr);
+    }
+
+    SECTION("text lookups match without interning") {
+        REQUIRE(*cache.get("MSFT") == 2);
+        REQUIRE(cache.has(string_view("AAPL")));
+        REQUIRE_FALSE(cache.has("GOOG"));
+        REQUIRE(pool.size() == 2);
+    }
+
+    SECTION("eviction keeps the symbol valid") {
+        REQUIRE(cache.set(pool.intern("GOOG"), 3));
+        REQUIRE_FALSE(cache.has(aapl));
+        REQUIRE(aapl.view() == "AAPL");
+    }
+}
+
 TEST_CASE("LRUCache get returns pointer", "[lru]") {
     LRUCache<string, string> cache(3);
     REQUIRE(cache.set("key1", "value1"));
@@ -298,6 +469,52 @@ TEST_CASE("LRUCache move semantics", "[lru]") {
     REQUIRE(assigned.has("key2"));
 }
 
+TEST_CASE("LRUCache allocates from a memory resource", "[lru]") {
+    arena::MonotonicArena arena;
+    {
+        LRUCache<string, string> cache(4, &arena);
+        REQUIRE(cache.resource() == &arena);
+        REQUIRE(arena.bytes_used() >= 4 * sizeof(pair<string, string>));
+        REQUIRE(cache.set("short", "a"));
+        REQUIRE(cache.set("a key longer than the small-string buffer", "b"));
+
+        // Move-assigning across resources takes the source's storage whole
+        LRUCache<string, string> heap_cache(2);
+        REQUIRE(heap_cache.set("old", "value"));
+        REQUIRE(heap_cache.resource() == pmr::get_default_resource());
+        heap_cache = std::move(cache);
+        REQUIRE(heap_cache.resource() == &arena);
+        REQUIRE(*heap_cache.get("short") == "a");
+        REQUIRE(*heap_cache.get("a key longer than the small-string buffer") == "b");
+        REQUIRE_FALSE(heap_cache.has("old"));
+        REQUIRE(cache.size() == 0);
+
+        ARCCache<string, int> arc(3, &arena);
+        const size_t before = arena.bytes_used();
+        for (int i = 0; i < 20; ++i) {
+            REQUIRE(arc.set(to_string(i), i));
+        }
+        REQUIRE(arena.bytes_used() == before);
+        REQUIRE(arc.size() == 3);
+        REQUIRE(*arc.get("19") == 19);
+
+        // The ghost lists move with the nodes, so the heap cache keeps
+        // evicting into the arena's ghosts without allocating
+        ARCCache<string, int> heap_arc(5);
+        REQUIRE(heap_arc.set("old", 0));
+        heap_arc = std::move(arc);
+        REQUIRE(heap_arc.resource() == &arena);
+        for (int i = 20; i < 40; ++i) {
+            REQUIRE(heap_arc.set(to_string(i), i));
+        }
+        REQUIRE(arena.bytes_used() == before);
+        REQUIRE(heap_arc.size() == 3);
+        REQUIRE_FALSE(heap_arc.has("old"));
+        REQUIRE(arc.size() == 0);
+    }
+    arena.reset();
+}
+
 TEST_CASE("LRUCache supports non-default-constructible values", "[lru]") {
     LRUCache<string, NoDefault> cache(2);
 
@@ -337,6 +554,50 @@ TEST_CASE("LRUCache capacity edge cases", "[lru]") {
         REQUIRE_FALSE(result);
         REQUIRE_FALSE(cache.has("key"));
     }
+
+    SECTION("oversized limit throws before allocating") {
+        arena::MonotonicArena arena;
+        for (size_t limit : {size_t{numeric_limits<uint32_t>::max()}, size_t{1} << 40}) {
+            REQUIRE_THROWS_AS((LRUCache<uint64_t, uint64_t>(limit, &arena)), length_error);
+        }
+        REQUIRE(arena.bytes_used() == 0);
+    }
+}
+
+TEST_CASE("LRUCache finds keys that share low hash bits", "[lru]") {
+    // Identity hashes that differ only above bit 32: one home under a
+    // low-bit mask, and a handful of fingerprints
+    LRUCache<uint64_t, uint64_t> cache(4096);
+    for (uint64_t i = 0; i < 4096; ++i) {
+        REQUIRE(cache.set(i << 32, i));
+    }
+    for (uint64_t i = 0; i < 4096; ++i) {
+        REQUIRE(cache.get(i << 32) != nullptr);
+        REQUIRE(*cache.get(i << 32) == i);
+        REQUIRE_FALSE(cache.has((i << 32) | 1));
+    }
+    REQUIRE(cache.set(uint64_t{1} << 52, 0));
+    REQUIRE(cache.size() == 4096);
+    REQUIRE_FALSE(cache.has(0));
+}
+
+TEST_CASE("LRUCache fingerprints differ for keys that differ above the low bits", "[lru]") {
+    // Identity hashes i << 16: every key once had the same fingerprint, so
+    // fingerprints never rejected a bucket and each probe read the node
+    LRUCache<uint64_t, uint64_t> cache(1 << 16);
+    unordered_set<uint16_t> fingerprints;
+    for (uint64_t i = 0; i < (1 << 16); ++i) {
+        fingerprints.insert(cache.fingerprint(i << 16));
+    }
+    // 65536 random draws from 65536 values give about 41400 distinct
+    REQUIRE(fingerprints.size() > 40'000);
+
+    LRUCache<uint64_t, uint64_t> small(16);
+    fingerprints.clear();
+    for (uint64_t i = 0; i < 1024; ++i) {
+        fingerprints.insert(small.fingerprint(i << 16));
+    }
+    REQUIRE(fingerprints.size() > 900);
 }
 
 TEST_CASE("LRUCache iterators", "[lru]") {
@@ -380,6 +641,798 @@ TEST_CASE("LRUCache clear", "[lru]") {
     REQUIRE(cache.size() == 1);
 }
 
+TEST_CASE("ARCCache basic operations", "[lru][arc]") {
+    ARCCache<string, string> cache(3);
+
+    REQUIRE(cache.set("key1", "value1"));
+    REQUIRE(cache.set("key2", "value2"));
+    REQUIRE(cache.set("key3", "value3"));
+    REQUIRE(cache.size() == 3);
+    REQUIRE(cache.recent_size() == 3);
+
+    auto result = cache.get("key2");
+    REQUIRE(result != nullptr);
+    REQUIRE(*result == "value2");
+    REQUIRE(cache.recent_size() == 2);
+
+    REQUIRE(cache.set("key4", "value4"));
+    REQUIRE(cache.size() == 3);
+    REQUIRE_FALSE(cache.has("key1"));
+    REQUIRE(cache.has("key2"));
+    REQUIRE(cache.has("key4"));
+}
+
+TEST_CASE("ARCCache iterates T2 before T1", "[lru][arc]") {
+    ARCCache<int, int> cache(4);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(cache.set(i, i * 10));
+    }
+    [[maybe_unused]] auto _ = cache.get(1);
+
+    vector<int> order;
+    for (auto [k, v] : cache) {
+        REQUIRE(v == k * 10);
+        order.push_back(k);
+    }
+    REQUIRE(order == vector<int>{1, 3, 2, 0});
+}
+
+TEST_CASE("ARCCache keeps frequent keys through a scan", "[lru][arc]") {
+    constexpr int kCapacity = 100;
+    ARCCache<int, int> arc(kCapacity);
+    LRUCache<int, int> lru(kCapacity);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int key = 0; key < kCapacity / 2; ++key) {
+            if (arc.get(key) == nullptr) (void)arc.set(key, key);
+            if (lru.get(key) == nullptr) (void)lru.set(key, key);
+        }
+    }
+    for (int key = 1000; key < 1000 + 2 * kCapacity; ++key) {
+        (void)arc.set(key, key);
+        (void)lru.set(key, key);
+    }
+
+    int arc_survivors = 0;
+    int lru_survivors = 0;
+    for (int key = 0; key < kCapacity / 2; ++key) {
+        arc_survivors += arc.has(key) ? 1 : 0;
+        lru_survivors += lru.has(key) ? 1 : 0;
+    }
+    REQUIRE(arc_survivors == kCapacity / 2);
+    REQUIRE(lru_survivors == 0);
+    REQUIRE(arc.size() == kCapacity);
+}
+
+TEST_CASE("ARCCache ghost hit re-enters as frequent", "[lru][arc]") {
+    ARCCache<int, int> cache(2);
+    REQUIRE(cache.set(1, 1));
+    REQUIRE(cache.set(2, 2));
+    REQUIRE(cache.get(2) != nullptr);
+    REQUIRE(cache.set(3, 3));
+    REQUIRE_FALSE(cache.has(1));
+    REQUIRE(cache.has(2));
+
+    // 1 is a B1 ghost now, so re-inserting it lands in T2
+    REQUIRE(cache.set(1, 1));
+    REQUIRE(cache.has(1));
+    REQUIRE(cache.recent_size() == 1);
+    REQUIRE((*cache.begin()).first == 1);
+}
+
+TEST_CASE("ARCCache clear and move", "[lru][arc]") {
+    ARCCache<string, string> cache(2);
+    REQUIRE(cache.set("a", "1"));
+    REQUIRE(cache.set("b", "2"));
+    REQUIRE(cache.set("c", "3"));
+
+    auto moved = std::move(cache);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(moved.size() == 2);
+    REQUIRE(moved.has("c"));
+
+    moved.clear();
+    REQUIRE(moved.size() == 0);
+    REQUIRE(moved.recent_size() == 0);
+    REQUIRE(moved.set("d", "4"));
+    REQUIRE(moved.set("e", "5"));
+    REQUIRE(moved.set("f", "6"));
+    REQUIRE(moved.size() == 2);
+    REQUIRE(moved.has("f"));
+}
+
+TEST_CASE("ARCCache stays consistent under random load", "[lru][arc]") {
+    ARCCache<int, int> cache(64);
+    mt19937 rng(7);
+    for (int i = 0; i < 200000; ++i) {
+        const int key = static_cast<int>(rng() % 400);
+        if (auto* value = cache.get(key)) {
+            REQUIRE(*value == key);
+        } else {
+            REQUIRE(cache.set(key, key));
+        }
+        REQUIRE(cache.size() <= 64);
+        REQUIRE(cache.recent_size() <= cache.size());
+    }
+
+    size_t counted = 0;
+    for ([[maybe_unused]] auto entry : cache) {
+        ++counted;
+    }
+    REQUIRE(counted == cache.size());
+}
+
+TEST_CASE("LRUCache eviction handler sees victims", "[lru][tier]") {
+    LRUCache<string, int> cache(2);
+    vector<pair<string, int>> evicted;
+    cache.set_eviction_handler([&](string&& key, int&& value) { evicted.emplace_back(std::move(key), value); });
+
+    REQUIRE(cache.set("a", 1));
+    REQUIRE(cache.set("b", 2));
+    REQUIRE(cache.set("a", 10));
+    REQUIRE(cache.set("c", 3));
+
+    REQUIRE(evicted == vector<pair<string, int>>{{"b", 2}});
+    cache.clear();
+    REQUIRE(evicted.size() == 1);
+}
+
+TEST_CASE("FileTier round-trips records", "[lru][tier]") {
+    TempDir dir;
+    FileTier tier(dir.path / "log", 1 << 16, 1024);
+    vector<byte> out;
+
+    REQUIRE(tier.append(1, bytes_of("k1"), bytes_of("buffered")));
+    REQUIRE(tier.read(1, bytes_of("k1"), out));
+    REQUIRE(string_of(out) == "buffered");
+
+    tier.flush();
+    REQUIRE(tier.read(1, bytes_of("k1"), out));
+    REQUIRE(string_of(out) == "buffered");
+
+    SECTION("stored key must match") {
+        REQUIRE_FALSE(tier.read(1, bytes_of("k2"), out));
+    }
+
+    SECTION("erase hides the record") {
+        tier.erase(1);
+        REQUIRE_FALSE(tier.read(1, bytes_of("k1"), out));
+        REQUIRE(tier.size() == 0);
+    }
+
+    SECTION("newest record for a hash wins") {
+        REQUIRE(tier.append(1, bytes_of("k1"), bytes_of("newer")));
+        REQUIRE(tier.read(1, bytes_of("k1"), out));
+        REQUIRE(string_of(out) == "newer");
+        REQUIRE(tier.size() == 1);
+    }
+}
+
+TEST_CASE("FileTier ring drops the oldest records", "[lru][tier]") {
+    TempDir dir;
+    FileTier tier(dir.path / "log", 4096, 512);
+    const string value(100, 'v');
+    vector<byte> out;
+
+    for (size_t i = 0; i < 200; ++i) {
+        const auto key = to_string(i);
+        REQUIRE(tier.append(i, bytes_of(key), bytes_of(value)));
+    }
+
+    REQUIRE(tier.size() < 40);
+    REQUIRE_FALSE(tier.read(0, bytes_of("0"), out));
+    for (size_t i = 200 - tier.size(); i < 200; ++i) {
+        REQUIRE(tier.read(i, bytes_of(to_string(i)), out));
+        REQUIRE(string_of(out) == value);
+    }
+
+    REQUIRE_FALSE(tier.append(999, bytes_of("big"), bytes_of(string(600, 'x'))));
+}
+
+TEST_CASE("TieredCache demotes and promotes", "[lru][tier]") {
+    TempDir dir;
+    TieredCache<string, string> cache(2, dir.path / "tier", 1 << 16);
+
+    REQUIRE(cache.set("a", "1"));
+    REQUIRE(cache.set("b", "2"));
+    REQUIRE(cache.set("c", "3"));
+    REQUIRE(cache.dram_size() == 2);
+    REQUIRE(cache.file_size() == 1);
+    REQUIRE(cache.has("a"));
+
+    auto* value = cache.get("a");
+    REQUIRE(value != nullptr);
+    REQUIRE(*value == "1");
+    REQUIRE(cache.stats().file_hits == 1);
+    REQUIRE(cache.stats().demotions == 2);
+
+    // Promoting "a" demoted "b"; the promoted copy left the file tier
+    REQUIRE(cache.file_size() == 1);
+    REQUIRE(cache.get("b") != nullptr);
+    REQUIRE(cache.get("missing") == nullptr);
+    REQUIRE(cache.stats().misses == 1);
+}
+
+TEST_CASE("TieredCache set supersedes the file copy", "[lru][tier]") {
+    TempDir dir;
+    TieredCache<int, uint64_t> cache(1, dir.path / "tier", 1 << 16);
+
+    REQUIRE(cache.set(1, uint64_t{100}));
+    REQUIRE(cache.set(2, uint64_t{200}));
+    REQUIRE(cache.set(1, uint64_t{101}));
+    REQUIRE(cache.set(3, uint64_t{300}));
+
+    auto* value = cache.get(1);
+    REQUIRE(value != nullptr);
+    REQUIRE(*value == 101);
+    REQUIRE(*cache.get(2) == 200);
+}
+
+TEST_CASE("LzCodec round-trips", "[lru][codec]") {
+    mt19937_64 rng(3);
+    string random_bytes(5000, '\0');
+    for (auto& c : random_bytes) {
+        c = static_cast<char>(rng());
+    }
+
+    const vector<string> inputs{
+        "",
+        "a",
+        "abcdefghi",
+        string(10000, 'x'),
+        "abcabcabcabcabcabcabcabcabcabc-tail",
+        random_bytes,
+        make_json_blob(rng, 8192),
+        string(70000, 'y') + random_bytes + string(70000, 'y'),
+    };
+
+    string compressed;
+    string restored = "stale contents";
+    for (const auto& input : inputs) {
+        LzCodec::compress(input, compressed);
+        REQUIRE(LzCodec::decompress(compressed, restored));
+        REQUIRE(restored == input);
+    }
+
+    LzCodec::compress(string(10000, 'x'), compressed);
+    REQUIRE(compressed.size() < 100);
+}
+
+TEST_CASE("LzCodec compresses JSON more than 4x", "[lru][codec]") {
+    mt19937_64 rng(5);
+    const auto blob = make_json_blob(rng, 8192);
+    string compressed;
+    LzCodec::compress(blob, compressed);
+    REQUIRE(compressed.size() * 4 < blob.size());
+}
+
+TEST_CASE("LzCodec rejects corrupt input", "[lru][codec]") {
+    mt19937_64 rng(9);
+    const auto blob = make_json_blob(rng, 4096);
+    string compressed;
+    string out;
+    LzCodec::compress(blob, compressed);
+
+    REQUIRE_FALSE(LzCodec::decompress(compressed.substr(0, compressed.size() / 2), out));
+    REQUIRE_FALSE(LzCodec::decompress(string("\xff\xff\xff\xff\x0f", 5), out));
+
+    // Fuzz: flipped bytes may decode to garbage but must never overrun
+    for (int i = 0; i < 2000; ++i) {
+        auto damaged = compressed;
+        damaged[rng() % damaged.size()] ^= static_cast<char>(1 + rng() % 255);
+        (void)LzCodec::decompress(damaged, out);
+    }
+}
+
+TEST_CASE("CompressedCache stays within its byte budget", "[lru][codec]") {
+    mt19937_64 rng(1);
+    CompressedCache<int> cache(20000, 1000);
+    string out;
+
+    for (int key = 0; key < 100; ++key) {
+        REQUIRE(cache.set(key, make_json_blob(rng, 8192)));
+        REQUIRE(cache.bytes() <= cache.byte_budget());
+    }
+    REQUIRE(cache.size() > 5);
+    REQUIRE(cache.has(99));
+    REQUIRE_FALSE(cache.has(0));
+
+    REQUIRE(cache.get(99, out));
+    REQUIRE(out.starts_with("{\"items\":["));
+    REQUIRE_FALSE(cache.get(0, out));
+}
+
+TEST_CASE("CompressedCache updates and accounts bytes", "[lru][codec]") {
+    CompressedCache<string, IdentityCodec> cache(100, 10);
+    string out;
+
+    REQUIRE(cache.set("a", string(40, 'a')));
+    REQUIRE(cache.set("b", string(40, 'b')));
+    REQUIRE(cache.bytes() == 80);
+
+    REQUIRE(cache.set("a", string(10, 'A')));
+    REQUIRE(cache.bytes() == 50);
+    REQUIRE(cache.get("a", out));
+    REQUIRE(out == string(10, 'A'));
+
+    // Growing "a" past the budget evicts the LRU entry, "b"
+    REQUIRE(cache.set("a", string(90, 'A')));
+    REQUIRE(cache.bytes() == 90);
+    REQUIRE_FALSE(cache.has("b"));
+
+    REQUIRE_FALSE(cache.set("huge", string(101, 'h')));
+}
+
+TEST_CASE("RefreshAheadCache reloads near-expiry hits in the background", "[lru][refresh]") {
+    ManualClock::ticks = 0;
+    atomic<int> loads{0};
+    RefreshOptions options;
+    options.ttl = chrono::milliseconds(1000);
+    options.refresh_window = chrono::milliseconds(200);
+    RefreshAheadCache<int, string, ManualClock> cache(
+        8, [&](const int& key) { return to_string(key) + "@" + to_string(++loads); }, options);
+
+    REQUIRE(cache.get(1) == "1@1");
+    REQUIRE(cache.stats().sync_loads == 1);
+
+    ManualClock::ticks = 500;
+    REQUIRE(cache.get(1) == "1@1");
+    REQUIRE(cache.stats().refreshes_queued == 0);
+
+    // Inside the window: readers keep the current value, the worker reloads
+    ManualClock::ticks = 850;
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(cache.get(1).starts_with("1@"));
+    }
+    cache.wait_idle();
+    REQUIRE(loads == 2);
+    REQUIRE(cache.stats().refreshes_queued == 1);
+    REQUIRE(cache.stats().refreshes_completed == 1);
+    REQUIRE(cache.get(1) == "1@2");
+
+    // The refresh moved the deadline to 1850, so 1500 is still a hit
+    ManualClock::ticks = 1500;
+    REQUIRE(cache.get(1) == "1@2");
+    REQUIRE(cache.stats().sync_loads == 1);
+
+    ManualClock::ticks = 5000;
+    REQUIRE(cache.get(1) == "1@3");
+    REQUIRE(cache.stats().sync_loads == 2);
+}
+
+TEST_CASE("RefreshAheadCache batches queued refreshes", "[lru][refresh]") {
+    ManualClock::ticks = 0;
+    atomic<bool> entered{false};
+    atomic<bool> release{false};
+    mutex sizes_mutex;
+    vector<size_t> batch_sizes;
+
+    RefreshAheadCache<int, int, ManualClock> cache(8, [&](const vector<int>& keys) {
+        {
+            lock_guard lock(sizes_mutex);
+            batch_sizes.push_back(keys.size());
+        }
+        entered = true;
+        while (!release) {
+            this_thread::yield();
+        }
+        return vector<int>(keys.begin(), keys.end());
+    });
+
+    for (int key = 1; key <= 3; ++key) {
+        cache.put(key, 0);
+    }
+    ManualClock::ticks = 900;
+
+    REQUIRE(cache.get(1) == 0);
+    while (!entered) {
+        this_thread::yield();
+    }
+    REQUIRE(cache.get(2) == 0);
+    REQUIRE(cache.get(3) == 0);
+    REQUIRE(cache.get(2) == 0);
+    release = true;
+    cache.wait_idle();
+
+    REQUIRE(batch_sizes == vector<size_t>{1, 2});
+    REQUIRE(cache.stats().refreshes_deduplicated == 1);
+    REQUIRE(cache.get(3) == 3);
+}
+
+TEST_CASE("RefreshAheadCache drops reloads overtaken by put or eviction", "[lru][refresh]") {
+    ManualClock::ticks = 0;
+    atomic<bool> entered{false};
+    atomic<bool> release{false};
+
+    RefreshAheadCache<int, int, ManualClock> cache(2, [&](const vector<int>& keys) {
+        entered = true;
+        while (!release) {
+            this_thread::yield();
+        }
+        vector<int> values;
+        for (int key : keys) {
+            values.push_back(-key);
+        }
+        return values;
+    });
+
+    auto start_refresh = [&](int key) {
+        entered = false;
+        release = false;
+        REQUIRE(cache.get(key) == key);
+        while (!entered) {
+            this_thread::yield();
+        }
+    };
+
+    SECTION("put during the load wins") {
+        cache.put(1, 1);
+        ManualClock::ticks = 900;
+        start_refresh(1);
+        cache.put(1, 100);
+        release = true;
+        cache.wait_idle();
+        // Let the worker finish applying the batch put() already cancelled
+        while (cache.stats().refreshes_discarded == 0) {
+            this_thread::yield();
+        }
+        REQUIRE(cache.get(1) == 100);
+        REQUIRE(cache.stats().refreshes_completed == 0);
+    }
+
+    SECTION("a key evicted during the load stays out") {
+        cache.put(1, 1);
+        ManualClock::ticks = 900;
+        start_refresh(1);
+        cache.put(2, 2);
+        cache.put(3, 3);
+        release = true;
+        cache.wait_idle();
+        REQUIRE(cache.stats().refreshes_discarded == 1);
+        // 1 is gone, so this is a cold load rather than a refreshed hit
+        REQUIRE(cache.get(1) == -1);
+        REQUIRE(cache.stats().sync_loads == 1);
+        REQUIRE(cache.get(3) == 3);
+    }
+
+    SECTION("a cancelled refresh can be queued again") {
+        cache.put(1, 1);
+        ManualClock::ticks = 900;
+        start_refresh(1);
+        cache.put(1, 100);
+        ManualClock::ticks = 1800;
+        REQUIRE(cache.get(1) == 100);
+        release = true;
+        cache.wait_idle();
+        REQUIRE(cache.stats().refreshes_queued == 2);
+        REQUIRE(cache.stats().refreshes_completed == 1);
+        REQUIRE(cache.get(1) == -1);
+    }
+}
+
+TEST_CASE("RefreshAheadCache keeps the old value when a refresh fails", "[lru][refresh]") {
+    ManualClock::ticks = 0;
+    atomic<int> calls{0};
+    RefreshAheadCache<int, int, ManualClock> cache(4, [&](const int& key) {
+        if (++calls > 1) {
+            throw runtime_error("backend down");
+        }
+        return key * 10;
+    });
+
+    REQUIRE(cache.get(7) == 70);
+    ManualClock::ticks = 900;
+    REQUIRE(cache.get(7) == 70);
+    cache.wait_idle();
+    REQUIRE(cache.stats().refresh_failures == 1);
+    REQUIRE(cache.get(7) == 70);
+}
+
+TEST_CASE("AsyncLoadingCache hit completes without suspending", "[lru][coro]") {
+    SingleThreadExecutor executor;
+    AsyncLoadingCache<int, int> cache(4, executor);
+    int calls = 0;
+    auto loader = [&](const int& key) -> Task<int> {
+        ++calls;
+        co_return key;
+    };
+
+    REQUIRE(cache.set(1, 10));
+    auto awaiter = cache.co_get(1, loader);
+    REQUIRE(awaiter.await_ready());
+    REQUIRE(awaiter.await_resume() == 10);
+    REQUIRE(calls == 0);
+    REQUIRE(executor.pending() == 0);
+}
+
+TEST_CASE("AsyncLoadingCache shares one load between awaiters", "[lru][coro]") {
+    SingleThreadExecutor executor;
+    AsyncLoadingCache<int, int> cache(4, executor);
+    int calls = 0;
+    auto loader = [&](const int& key) -> Task<int> {
+        ++calls;
+        // Stand-in for I/O: give the other readers a turn before completing
+        co_await executor.schedule();
+        co_await executor.schedule();
+        co_return key * 2;
+    };
+
+    vector<int> results;
+    for (int i = 0; i < 3; ++i) {
+        executor.spawn(read_into(cache, 5, loader, results));
+    }
+    executor.spawn(read_into(cache, 6, loader, results));
+    executor.run();
+
+    REQUIRE(calls == 2);
+    REQUIRE(cache.loads_started() == 2);
+    REQUIRE(cache.loads_in_flight() == 0);
+    sort(results.begin(), results.end());
+    REQUIRE(results == vector<int>{10, 10, 10, 12});
+    REQUIRE(*cache.get(5) == 10);
+
+    // Now cached: no new load
+    executor.spawn(read_into(cache, 5, loader, results));
+    executor.run();
+    REQUIRE(calls == 2);
+    REQUIRE(results.back() == 10);
+}
+
+TEST_CASE("AsyncLoadingCache rethrows a failed load to every awaiter", "[lru][coro]") {
+    SingleThreadExecutor executor;
+    AsyncLoadingCache<int, int> cache(4, executor);
+    int calls = 0;
+    auto loader = [&](const int& key) -> Task<int> {
+        co_await executor.schedule();
+        if (++calls == 1) {
+            throw runtime_error("backend down");
+        }
+        co_return key;
+    };
+
+    vector<int> results;
+    executor.spawn(read_into(cache, 3, loader, results));
+    executor.spawn(read_into(cache, 3, loader, results));
+    executor.run();
+    REQUIRE(results == vector<int>{-1, -1});
+    REQUIRE(cache.get(3) == nullptr);
+    REQUIRE(cache.loads_in_flight() == 0);
+
+    // The failure is not cached; the next miss loads again
+    executor.spawn(read_into(cache, 3, loader, results));
+    executor.run();
+    REQUIRE(results.back() == 3);
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("AsyncLoadingCache survives a loader that throws before returning a task", "[lru][coro]") {
+    SingleThreadExecutor executor;
+    AsyncLoadingCache<int, int> cache(4, executor);
+    auto load = [](int key) -> Task<int> { co_return key * 3; };
+    int calls = 0;
+    auto loader = [&](const int& key) -> Task<int> {
+        if (++calls == 1) {
+            throw runtime_error("no connection");
+        }
+        return load(key);
+    };
+
+    vector<int> results;
+    executor.spawn(read_into(cache, 7, loader, results));
+    executor.run();
+    REQUIRE(results == vector<int>{-1});
+    REQUIRE(cache.loads_in_flight() == 0);
+    REQUIRE(cache.loads_started() == 0);
+
+    // Nothing was left behind for the key: the next misses start a fresh
+    // load and share it
+    executor.spawn(read_into(cache, 7, loader, results));
+    executor.spawn(read_into(cache, 7, loader, results));
+    executor.run();
+    REQUIRE(results == vector<int>{-1, 21, 21});
+    REQUIRE(calls == 2);
+    REQUIRE(*cache.get(7) == 21);
+}
+
+TEST_CASE("HashSet64 matches a reference set", "[lru][negative]") {
+    HashSet64 set;
+    unordered_set<uint64_t> reference;
+    mt19937_64 rng(64);
+    const auto initial_bytes = set.bytes();
+
+    // Small key range so inserts and erases hit members, and long probe
+    // runs form and get shifted back over
+    for (int op = 0; op < 200'000; ++op) {
+        const uint64_t hash_value = 1 + rng() % 5000;
+        if (op % 3 == 2) {
+            REQUIRE(set.erase(hash_value) == (reference.erase(hash_value) == 1));
+        } else {
+            REQUIRE(set.insert(hash_value) == reference.insert(hash_value).second);
+        }
+    }
+    REQUIRE(set.size() == reference.size());
+    for (uint64_t hash_value = 1; hash_value <= 5000; ++hash_value) {
+        REQUIRE(set.contains(hash_value) == reference.contains(hash_value));
+    }
+    size_t visited = 0;
+    REQUIRE(set.all_of([&](uint64_t hash_value) { return reference.contains(hash_value) && ++visited > 0; }));
+    REQUIRE(visited == reference.size());
+
+    for (const auto hash_value : reference) {
+        REQUIRE(set.erase(hash_value));
+    }
+    REQUIRE(set.size() == 0);
+    REQUIRE(set.bytes() == initial_bytes);
+}
+
+TEST_CASE("NegativeCache grows, shrinks and resets", "[lru][negative]") {
+    NegativeCache<int> absent(16, 50'000);
+    const auto initial_bytes = absent.memory_bytes();
+
+    for (int key = 0; key < 20'000; ++key) {
+        absent.mark_absent(key);
+    }
+    REQUIRE(absent.size() == 20'000);
+    REQUIRE(absent.memory_bytes() > initial_bytes);
+    for (int key = 0; key < 20'000; ++key) {
+        REQUIRE(absent.known_absent(key));
+    }
+    for (int key = 20'000; key < 40'000; ++key) {
+        REQUIRE_FALSE(absent.known_absent(key));
+    }
+
+    const auto grown_bytes = absent.memory_bytes();
+    for (int key = 0; key < 19'900; ++key) {
+        absent.mark_present(key);
+    }
+    REQUIRE(absent.size() == 100);
+    REQUIRE(absent.memory_bytes() < grown_bytes);
+    for (int key = 19'900; key < 20'000; ++key) {
+        REQUIRE(absent.known_absent(key));
+    }
+    REQUIRE_FALSE(absent.known_absent(0));
+
+    // The key that pushes past max_keys starts a fresh set
+    for (int key = 100'000; key < 150'000; ++key) {
+        absent.mark_absent(key);
+    }
+    REQUIRE(absent.resets() == 1);
+    REQUIRE(absent.size() == 100);
+    REQUIRE(absent.known_absent(149'999));
+    REQUIRE_FALSE(absent.known_absent(19'999));
+}
+
+TEST_CASE("NegativeCachingLRU skips the loader for known-absent keys", "[lru][negative]") {
+    NegativeCachingLRU<int, string> cache(8);
+    int loads = 0;
+    auto loader = [&](const int& key) -> optional<string> {
+        ++loads;
+        if (key % 2 == 0) {
+            return to_string(key);
+        }
+        return nullopt;
+    };
+
+    REQUIRE(*cache.get(2, loader) == "2");
+    REQUIRE(cache.get(3, loader) == nullptr);
+    REQUIRE(loads == 2);
+    REQUIRE(cache.get(3, loader) == nullptr);
+    REQUIRE(*cache.get(2, loader) == "2");
+    REQUIRE(loads == 2);
+
+    // A key created later is no longer rejected
+    REQUIRE(cache.set(3, "three"));
+    REQUIRE(*cache.get(3, loader) == "three");
+    REQUIRE(cache.absent().size() == 0);
+}
+
+TEST_CASE("NegativeCachingLRU agrees with its backend", "[lru][negative]") {
+    // The backend changes only through set(), which writes both; every get
+    // must then see the backend, and the loader runs only for keys neither
+    // resident nor recorded absent
+    NegativeCachingLRU<int, string> cache(16);
+    unordered_map<int, string> backend;
+    unordered_set<int> recorded;
+    int loads = 0;
+    auto loader = [&](const int& key) -> optional<string> {
+        ++loads;
+        REQUIRE_FALSE(recorded.contains(key));
+        if (auto it = backend.find(key); it != backend.end()) {
+            return it->second;
+        }
+        recorded.insert(key);
+        return nullopt;
+    };
+
+    mt19937 rng(86);
+    for (int op = 0; op < 20'000; ++op) {
+        const int key = static_cast<int>(rng() % 300);
+        if (op % 5 == 0) {
+            backend[key] = to_string(op);
+            recorded.erase(key);
+            REQUIRE(cache.set(key, to_string(op)));
+            continue;
+        }
+        const auto* value = cache.get(key, loader);
+        if (auto it = backend.find(key); it != backend.end()) {
+            REQUIRE((value != nullptr && *value == it->second));
+        } else {
+            REQUIRE(value == nullptr);
+            REQUIRE(recorded.contains(key));
+        }
+    }
+    REQUIRE(loads > 0);
+    REQUIRE(cache.absent().size() == recorded.size());
+
+    const int before = loads;
+    for (const int key : recorded) {
+        REQUIRE(cache.get(key, loader) == nullptr);
+    }
+    REQUIRE(loads == before);
+}
+
+TEST_CASE("ConcurrentLRUCache keeps evicted values alive for pinned readers", "[lru][epoch]") {
+    epoch::Domain domain;
+    ConcurrentLRUCache<int, string> cache(2, domain);
+    REQUIRE(cache.set(1, "one"));
+    REQUIRE(cache.set(2, "two"));
+
+    {
+        auto guard = cache.pin();
+        const string* one = cache.get(1, guard);
+        const string* two = cache.get(2, guard);
+        REQUIRE(cache.set(3, "three"));
+        REQUIRE(cache.set(2, "deux"));
+        domain.collect();
+
+        REQUIRE(cache.get(1, guard) == nullptr);
+        REQUIRE(*cache.get(2, guard) == "deux");
+        REQUIRE(*one == "one");
+        REQUIRE(*two == "two");
+        REQUIRE(domain.retired_count() == 2);
+        REQUIRE(domain.reclaimed_count() == 0);
+    }
+
+    domain.drain();
+    REQUIRE(domain.reclaimed_count() == 2);
+    REQUIRE(cache.evict());
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("ConcurrentLRUCache readers race evictions safely", "[lru][epoch]") {
+    epoch::Domain domain;
+    {
+        ConcurrentLRUCache<int, string> cache(64, domain);
+        atomic<bool> done{false};
+        atomic<int> mismatches{0};
+
+        vector<thread> readers;
+        for (int r = 0; r < 2; ++r) {
+            readers.emplace_back([&, r] {
+                mt19937 rng(r);
+                while (!done.load(memory_order_relaxed)) {
+                    auto guard = cache.pin();
+                    const int key = static_cast<int>(rng() % 256);
+                    if (const auto* value = cache.get(key, guard); value != nullptr && *value != to_string(key)) {
+                        mismatches.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 50'000; ++i) {
+            const int key = i % 256;
+            (void)cache.set(key, to_string(key));
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        REQUIRE(mismatches == 0);
+    }
+    domain.drain();
+    REQUIRE(domain.reclaimed_count() == domain.retired_count());
+}
+
 TEST_CASE("LRUCache benchmarks", "[benchmark]") {
     const auto keys = make_strings("key", kSetOps);
     const auto values = make_strings("value", kSetOps);
@@ -510,4 +1563,544 @@ TEST_CASE("LRUCache eviction performance", "[benchmark]") {
     };
 }
 
+TEST_CASE("ARC vs LRU on a phase-shifting trace", "[benchmark]") {
+    constexpr size_t kCapacity = 4096;
+    constexpr int kPhases = 8;
+    constexpr int kOpsPerPhase = 200000;
+    const auto trace = make_phase_trace(kCapacity, kPhases, kOpsPerPhase);
+
+    // Replays phase by phase on one cache: {recency hit ratio, frequency hit ratio, ns/op}
+    auto measure = [&](auto& cache) {
+        array<size_t, 2> hits{};
+        const auto start = chrono::steady_clock::now();
+        for (int phase = 0; phase < kPhases; ++phase) {
+            const auto slice = span(trace).subspan(static_cast<size_t>(phase) * kOpsPerPhase, kOpsPerPhase);
+            hits[phase % 2] += replay_trace(cache, slice);
+        }
+        const auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        const auto per_kind = static_cast<double>(kPhases / 2 * kOpsPerPhase);
+        return tuple{hits[0] / per_kind, hits[1] / per_kind, elapsed / static_cast<double>(trace.size())};
+    };
+
+    LRUCache<uint64_t, uint64_t> lru(kCapacity);
+    ARCCache<uint64_t, uint64_t> arc(kCapacity);
+    const auto [lru_recency, lru_frequency, lru_ns] = measure(lru);
+    const auto [arc_recency, arc_frequency, arc_ns] = measure(arc);
+
+    cout << "\nPhase trace: " << trace.size() << " ops, capacity " << kCapacity << '\n';
+    cout << fixed << setprecision(2);
+    cout << "       recency hits  frequency hits   ns/op\n";
+    cout << "  LRU  " << setw(11) << lru_recency * 100 << "%  " << setw(13) << lru_frequency * 100 << "%  "
+         << setw(8) << lru_ns << '\n';
+    cout << "  ARC  " << setw(11) << arc_recency * 100 << "%  " << setw(13) << arc_frequency * 100 << "%  "
+         << setw(8) << arc_ns << '\n';
+    CHECK(arc_frequency > lru_frequency);
+
+    BENCHMARK_ADVANCED("LRU trace replay")(Catch::Benchmark::Chronometer meter) {
+        auto caches = make_caches<uint64_t, uint64_t>(meter.runs(), kCapacity);
+        meter.measure([&](int run) { return replay_trace(caches[run], trace); });
+    };
+
+    BENCHMARK_ADVANCED("ARC trace replay")(Catch::Benchmark::Chronometer meter) {
+        vector<ARCCache<uint64_t, uint64_t>> caches;
+        caches.reserve(meter.runs());
+        for (int i = 0; i < meter.runs(); ++i) {
+            caches.emplace_back(kCapacity);
+        }
+        meter.measure([&](int run) { return replay_trace(caches[run], trace); });
+    };
+}
+
+TEST_CASE("Tiered cache with a file victim tier", "[benchmark]") {
+    // Working set ~10x the DRAM tier, skewed toward low ids
+    constexpr size_t kDramItems = 2000;
+    constexpr uint64_t kKeys = 20000;
+    constexpr int kOps = 200000;
+    constexpr size_t kFileBytes = 32u << 20;
+    const string payload(512, 'p');
+
+    mt19937_64 rng(11);
+    vector<uint64_t> trace;
+    trace.reserve(kOps);
+    for (int i = 0; i < kOps; ++i) {
+        const auto r = static_cast<double>(rng() % 1'000'000) / 1'000'000.0;
+        trace.push_back(scramble(static_cast<uint64_t>(r * r * static_cast<double>(kKeys))));
+    }
+
+    TempDir dir;
+    TieredCache<uint64_t, string> tiered(kDramItems, dir.path / "tier", kFileBytes);
+    LRUCache<uint64_t, string> dram_only(kDramItems);
+
+    // Warm both so the file tier is populated before measuring
+    for (const auto key : trace) {
+        if (tiered.get(key) == nullptr) (void)tiered.set(key, payload);
+        if (dram_only.get(key) == nullptr) (void)dram_only.set(key, payload);
+    }
+    tiered.reset_stats();
+
+    array<double, 3> tier_ns{};
+    size_t dram_only_hits = 0;
+    for (const auto key : trace) {
+        const auto before = tiered.stats();
+        const auto start = chrono::steady_clock::now();
+        const bool hit = tiered.get(key) != nullptr;
+        const auto ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        if (!hit) (void)tiered.set(key, payload);
+
+        const auto& after = tiered.stats();
+        tier_ns[after.dram_hits > before.dram_hits ? 0 : after.file_hits > before.file_hits ? 1 : 2] += ns;
+
+        if (dram_only.get(key) != nullptr) {
+            ++dram_only_hits;
+        } else {
+            (void)dram_only.set(key, payload);
+        }
+    }
+
+    const auto& stats = tiered.stats();
+    auto pct = [](size_t part) { return 100.0 * static_cast<double>(part) / kOps; };
+    auto per = [](double total, size_t count) { return count == 0 ? 0.0 : total / static_cast<double>(count); };
+
+    cout << "\nTiered cache: " << kDramItems << " DRAM entries, " << kKeys << " keys, "
+         << payload.size() << " B values, file tier in " << dir.path << '\n';
+    cout << fixed << setprecision(2);
+    cout << "  DRAM hits  " << setw(6) << pct(stats.dram_hits) << "%  " << setw(8)
+         << per(tier_ns[0], stats.dram_hits) << " ns/get\n";
+    cout << "  file hits  " << setw(6) << pct(stats.file_hits) << "%  " << setw(8)
+         << per(tier_ns[1], stats.file_hits) << " ns/get\n";
+    cout << "  misses     " << setw(6) << pct(stats.misses) << "%  " << setw(8)
+         << per(tier_ns[2], stats.misses) << " ns/get\n";
+    cout << "  DRAM-only LRU hit ratio " << pct(dram_only_hits) << "%\n";
+    CHECK(stats.dram_hits + stats.file_hits > dram_only_hits);
+}
+
+TEST_CASE("Compressed values under a fixed byte budget", "[benchmark]") {
+    constexpr size_t kBudget = 8u << 20;
+    constexpr size_t kBlobs = 6000;
+    constexpr int kOps = 100000;
+
+    mt19937_64 rng(21);
+    vector<string> blobs;
+    blobs.reserve(kBlobs);
+    size_t raw_bytes = 0;
+    for (size_t i = 0; i < kBlobs; ++i) {
+        blobs.push_back(make_json_blob(rng, 8192));
+        raw_bytes += blobs.back().size();
+    }
+
+    vector<uint32_t> trace;
+    trace.reserve(kOps);
+    for (int i = 0; i < kOps; ++i) {
+        const auto r = static_cast<double>(rng() % 1'000'000) / 1'000'000.0;
+        trace.push_back(static_cast<uint32_t>(r * r * kBlobs));
+    }
+
+    auto run = [&](auto& cache) {
+        string out;
+        size_t hits = 0;
+        const auto start = chrono::steady_clock::now();
+        for (const auto key : trace) {
+            if (cache.get(key, out)) {
+                ++hits;
+            } else {
+                (void)cache.set(key, blobs[key]);
+            }
+        }
+        const auto ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        return pair{static_cast<double>(hits) / kOps, ns / kOps};
+    };
+
+    CompressedCache<uint32_t, IdentityCodec> plain(kBudget, kBlobs);
+    CompressedCache<uint32_t, LzCodec> compressed(kBudget, kBlobs);
+    const auto [plain_ratio, plain_ns] = run(plain);
+    const auto [lz_ratio, lz_ns] = run(compressed);
+
+    string packed;
+    string unpacked;
+    size_t packed_bytes = 0;
+    const auto compress_start = chrono::steady_clock::now();
+    for (const auto& blob : blobs) {
+        LzCodec::compress(blob, packed);
+        packed_bytes += packed.size();
+    }
+    const auto compress_s = chrono::duration<double>(chrono::steady_clock::now() - compress_start).count();
+    const auto decompress_start = chrono::steady_clock::now();
+    for (const auto& blob : blobs) {
+        LzCodec::compress(blob, packed);
+        (void)LzCodec::decompress(packed, unpacked);
+    }
+    const auto decompress_s =
+        chrono::duration<double>(chrono::steady_clock::now() - decompress_start).count() - compress_s;
+
+    cout << "\nCompressed cache: " << (kBudget >> 20) << " MiB budget, " << kBlobs << " JSON blobs of ~"
+         << raw_bytes / kBlobs << " B\n";
+    cout << fixed << setprecision(2);
+    cout << "  LzCodec ratio " << static_cast<double>(raw_bytes) / static_cast<double>(packed_bytes)
+         << "x, compress " << static_cast<double>(raw_bytes) / compress_s / 1e6 << " MB/s, decompress ~"
+         << static_cast<double>(raw_bytes) / decompress_s / 1e6 << " MB/s\n";
+    cout << "  identity  " << setw(5) << plain.size() << " entries  hit ratio " << setw(6) << plain_ratio * 100
+         << "%  " << setw(9) << plain_ns << " ns/op\n";
+    cout << "  LzCodec   " << setw(5) << compressed.size() << " entries  hit ratio " << setw(6) << lz_ratio * 100
+         << "%  " << setw(9) << lz_ns << " ns/op\n";
+    CHECK(compressed.size() > 4 * plain.size());
+}
+
+TEST_CASE("Refresh-ahead vs reload on expiry", "[benchmark]") {
+    // Hot keys with a slow backend: without refresh-ahead every expiry puts
+    // a reader behind a full reload
+    constexpr auto kBackendLatency = chrono::milliseconds(2);
+    constexpr auto kRunTime = chrono::milliseconds(800);
+    constexpr int kHotKeys = 16;
+
+    auto run = [&](chrono::milliseconds window) {
+        RefreshOptions options;
+        options.ttl = chrono::milliseconds(100);
+        options.refresh_window = window;
+        RefreshAheadCache<int, int> cache(64, [&](const int& key) {
+            this_thread::sleep_for(kBackendLatency);
+            return key;
+        }, options);
+        for (int key = 0; key < kHotKeys; ++key) {
+            cache.put(key, key);
+        }
+
+        vector<double> latencies_us;
+        const auto stop_at = chrono::steady_clock::now() + kRunTime;
+        for (int i = 0; chrono::steady_clock::now() < stop_at; ++i) {
+            const auto start = chrono::steady_clock::now();
+            (void)cache.get(i % kHotKeys);
+            latencies_us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+        }
+        sort(latencies_us.begin(), latencies_us.end());
+        const auto stalled = latencies_us.end() - lower_bound(latencies_us.begin(), latencies_us.end(), 1000.0);
+        return tuple{latencies_us[latencies_us.size() / 2], stalled, latencies_us.back(), cache.stats()};
+    };
+
+    cout << "\nRefresh-ahead: " << kHotKeys << " hot keys, 100 ms TTL, " << kBackendLatency.count()
+         << " ms backend\n";
+    cout << fixed << setprecision(2);
+    for (const auto window : {chrono::milliseconds(0), chrono::milliseconds(30)}) {
+        const auto [p50, stalled, worst, stats] = run(window);
+        cout << "  window " << setw(3) << window.count() << " ms  p50 " << setw(5) << p50 << " us  max "
+             << setw(8) << worst << " us  reads over 1 ms " << setw(4) << stalled << "  sync loads " << setw(4)
+             << stats.sync_loads << "  background " << stats.refreshes_completed << " in "
+             << stats.refresh_batches << " batches\n";
+    }
+}
+
+TEST_CASE("co_get hit path vs get", "[benchmark]") {
+    constexpr int kKeys = 1024;
+    constexpr int kLookups = 10'000'000;
+
+    SingleThreadExecutor executor;
+    AsyncLoadingCache<int, int> cache(kKeys, executor);
+    auto loader = [](const int& key) -> Task<int> { co_return key; };
+    for (int key = 0; key < kKeys; ++key) {
+        REQUIRE(cache.set(key, key));
+    }
+
+    auto time_ns_per_op = [&](auto&& body) {
+        const auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kLookups;
+    };
+
+    long long plain_sum = 0;
+    const auto plain = time_ns_per_op([&] {
+        for (int i = 0; i < kLookups; ++i) {
+            plain_sum += *cache.get(i & (kKeys - 1));
+        }
+    });
+
+    long long coro_sum = 0;
+    auto reader = [&]() -> Task<> {
+        for (int i = 0; i < kLookups; ++i) {
+            coro_sum += co_await cache.co_get(i & (kKeys - 1), loader);
+        }
+    };
+    const auto awaited = time_ns_per_op([&] {
+        executor.spawn(reader());
+        executor.run();
+    });
+
+    REQUIRE(plain_sum == coro_sum);
+    REQUIRE(cache.loads_started() == 0);
+    cout << "\nHit path, " << kKeys << " resident keys, " << kLookups << " lookups\n";
+    cout << fixed << setprecision(2);
+    cout << "  get()              " << setw(6) << plain << " ns/op\n";
+    cout << "  co_await co_get()  " << setw(6) << awaited << " ns/op\n";
+}
+
+TEST_CASE("Negative lookups: absent set vs bucket probe", "[benchmark]") {
+    constexpr int kResident = 1 << 16;
+    constexpr int kAbsent = 1 << 18;
+    constexpr int kLookups = 10'000'000;
+
+    NegativeCachingLRU<uint64_t, uint64_t> cache(kResident, kAbsent);
+    auto resident = [](const uint64_t& key) -> optional<uint64_t> { return key; };
+    for (uint64_t i = 0; i < kResident; ++i) {
+        REQUIRE(cache.get(scramble(i), resident) != nullptr);
+    }
+    auto missing = [](const uint64_t&) -> optional<uint64_t> { return nullopt; };
+    vector<uint64_t> absent_keys;
+    for (uint64_t i = 0; i < kAbsent; ++i) {
+        absent_keys.push_back(scramble(kResident + i));
+        REQUIRE(cache.get(absent_keys.back(), missing) == nullptr);
+    }
+
+    auto time_ns_per_op = [&](auto&& probe) {
+        size_t found = 0;
+        const auto start = chrono::steady_clock::now();
+        for (int i = 0; i < kLookups; ++i) {
+            found += probe(absent_keys[i & (kAbsent - 1)]);
+        }
+        const auto ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kLookups;
+        return pair{ns, found};
+    };
+
+    auto unexpected = [](const uint64_t&) -> optional<uint64_t> { throw logic_error("loader called"); };
+    const auto [probe_ns, probe_found] = time_ns_per_op([&](uint64_t key) { return cache.entries().get(key) != nullptr; });
+    const auto [set_ns, known] = time_ns_per_op([&](uint64_t key) { return cache.absent().known_absent(key); });
+    const auto [get_ns, rejected] = time_ns_per_op([&](uint64_t key) { return cache.get(key, unexpected) == nullptr; });
+    REQUIRE(probe_found == 0);
+    REQUIRE(known == static_cast<size_t>(kLookups));
+    REQUIRE(rejected == static_cast<size_t>(kLookups));
+
+    const auto& absent = cache.absent();
+    cout << "\nNegative lookups, " << kResident << " resident keys, " << kAbsent << " known-absent keys\n";
+    cout << fixed << setprecision(2);
+    cout << "  LRUCache::get miss              " << setw(6) << probe_ns << " ns/op\n";
+    cout << "  NegativeCache::known_absent     " << setw(6) << set_ns << " ns/op  ("
+         << static_cast<double>(absent.memory_bytes()) / absent.size() << " bytes/key)\n";
+    cout << "  NegativeCachingLRU::get, absent " << setw(6) << get_ns << " ns/op\n";
+}
+
+TEST_CASE("Bucket index: hit-heavy and miss-heavy lookups", "[benchmark]") {
+    constexpr int kLookups = 4'000'000;
+
+    // Misses draw from keys never inserted, so each one walks a probe
+    // chain to its end
+    auto run = [&](auto make_key, size_t capacity, int hit_percent) {
+        LRUCache<decltype(make_key(0)), int> cache(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            (void)cache.set(make_key(i), static_cast<int>(i));
+        }
+        mt19937_64 rng(7);
+        vector<decltype(make_key(0))> probes;
+        probes.reserve(1 << 16);
+        for (int i = 0; i < (1 << 16); ++i) {
+            const auto slot = rng() % capacity;
+            probes.push_back(static_cast<int>(rng() % 100) < hit_percent ? make_key(slot) : make_key(capacity + slot));
+        }
+
+        size_t found = 0;
+        const auto start = chrono::steady_clock::now();
+        for (int i = 0; i < kLookups; ++i) {
+            found += cache.get(probes[i & ((1 << 16) - 1)]) != nullptr;
+        }
+        const auto ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kLookups;
+        REQUIRE(found > 0);
+        return ns;
+    };
+
+    const auto int_key = [](size_t i) { return scramble(i); };
+    const auto string_key = [](size_t i) { return "symbol:" + to_string(scramble(i)); };
+
+    cout << "\nBucket index lookups (ns/op)\n";
+    cout << fixed << setprecision(2);
+    cout << "  " << setw(28) << left << "workload" << right << setw(10) << "hits 95%" << setw(11) << "hits 10%"
+         << "\n";
+    for (const size_t capacity : {size_t{1} << 14, size_t{1} << 21}) {
+        cout << "  " << setw(28) << left << ("uint64 keys, " + to_string(capacity) + " entries") << right
+             << setw(10) << run(int_key, capacity, 95) << setw(11) << run(int_key, capacity, 10) << "\n";
+        cout << "  " << setw(28) << left << ("string keys, " + to_string(capacity) + " entries") << right
+             << setw(10) << run(string_key, capacity, 95) << setw(11) << run(string_key, capacity, 10) << "\n";
+    }
+}
+
+TEST_CASE("Shared reads: epoch-guarded pointer vs copy under lock", "[benchmark]") {
+    constexpr int kKeys = 4096;
+    constexpr int kLookups = 5'000'000;
+    const string payload(256, 'x');
+
+    mutex lock;
+    LRUCache<int, string> locked(kKeys);
+    ConcurrentLRUCache<int, string> shared(kKeys);
+    for (int key = 0; key < kKeys; ++key) {
+        (void)locked.set(key, payload);
+        (void)shared.set(key, payload);
+    }
+
+    auto time_ns_per_op = [&](auto&& body) {
+        const auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kLookups;
+    };
+
+    size_t copied_bytes = 0;
+    const auto copy = time_ns_per_op([&] {
+        for (int i = 0; i < kLookups; ++i) {
+            string value;
+            {
+                lock_guard guard(lock);
+                value = *locked.get(scramble(i) % kKeys);
+            }
+            copied_bytes += value.size();
+        }
+    });
+
+    size_t read_bytes = 0;
+    const auto guarded = time_ns_per_op([&] {
+        for (int i = 0; i < kLookups; ++i) {
+            auto guard = shared.pin();
+            read_bytes += shared.get(scramble(i) % kKeys, guard)->size();
+        }
+    });
+
+    // Eviction churn: each set retires the value it replaces
+    const auto churn = time_ns_per_op([&] {
+        for (int i = 0; i < kLookups; ++i) {
+            (void)shared.set(kKeys + i, payload);
+        }
+    });
+
+    REQUIRE(copied_bytes == read_bytes);
+    cout << "\nShared reads, " << kKeys << " keys, " << payload.size() << "-byte values, one thread\n";
+    cout << fixed << setprecision(2);
+    cout << "  mutex + LRUCache::get + copy    " << setw(6) << copy << " ns/op\n";
+    cout << "  pin + ConcurrentLRUCache::get   " << setw(6) << guarded << " ns/op\n";
+    cout << "  set with eviction + retire      " << setw(6) << churn << " ns/op\n";
+}
+
+TEST_CASE("String keys vs interned symbols across caches", "[benchmark]") {
+    constexpr size_t kKeys = 200'000;
+    constexpr size_t kCaches = 4;
+    constexpr int kRequests = 2'000'000;
+
+    // Request paths well past the small-string buffer, as cache keys
+    // usually are; every cache holds every key
+    vector<string> texts;
+    for (size_t i = 0; i < kKeys; ++i) {
+        texts.push_back("/api/v2/accounts/" + to_string(scramble(i) % 100'000'000) + "/positions?view=full");
+    }
+    intern::Pool pool;
+    vector<LRUCache<string, int>> by_string;
+    vector<LRUCache<intern::Symbol, int>> by_symbol;
+    for (size_t c = 0; c < kCaches; ++c) {
+        by_string.emplace_back(kKeys);
+        by_symbol.emplace_back(kKeys);
+        for (size_t i = 0; i < kKeys; ++i) {
+            (void)by_string[c].set(texts[i], static_cast<int>(i));
+            (void)by_symbol[c].set(pool.intern(texts[i]), static_cast<int>(i));
+        }
+    }
+
+    // Key storage only; everything else in an entry is the same size.
+    // String heap blocks are counted at their capacity, without malloc's
+    // own rounding and headers.
+    size_t string_bytes = 0;
+    for (const auto& text : texts) {
+        string_bytes += sizeof(string) + (text.capacity() > 15 ? text.capacity() + 1 : 0);
+    }
+    string_bytes *= kCaches;
+    const size_t symbol_bytes = kCaches * kKeys * sizeof(intern::Symbol) + pool.memory_bytes();
+
+    vector<uint32_t> requests;
+    mt19937_64 rng(11);
+    for (int i = 0; i < kRequests; ++i) {
+        requests.push_back(static_cast<uint32_t>(rng() % kKeys));
+    }
+    vector<intern::Symbol> symbols;
+    for (const auto& text : texts) {
+        symbols.push_back(*pool.find(text));
+    }
+
+    // One request looks its key up in every cache
+    auto time_ns_per_request = [&](auto&& lookup_all) {
+        long sum = 0;
+        const auto start = chrono::steady_clock::now();
+        for (const uint32_t key : requests) {
+            sum += lookup_all(key);
+        }
+        const auto ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kRequests;
+        return pair{ns, sum};
+    };
+
+    const auto [text_ns, text_sum] = time_ns_per_request([&](uint32_t key) {
+        int sum = 0;
+        for (auto& cache : by_string) sum += *cache.get(string_view(texts[key]));
+        return sum;
+    });
+    const auto [symbol_ns, symbol_sum] = time_ns_per_request([&](uint32_t key) {
+        int sum = 0;
+        for (auto& cache : by_symbol) sum += *cache.get(symbols[key]);
+        return sum;
+    });
+    const auto [intern_ns, intern_sum] = time_ns_per_request([&](uint32_t key) {
+        const auto symbol = pool.intern(texts[key]);
+        int sum = 0;
+        for (auto& cache : by_symbol) sum += *cache.get(symbol);
+        return sum;
+    });
+    const auto [symbol_text_ns, symbol_text_sum] = time_ns_per_request([&](uint32_t key) {
+        int sum = 0;
+        for (auto& cache : by_symbol) sum += *cache.get(string_view(texts[key]));
+        return sum;
+    });
+    REQUIRE(symbol_sum == text_sum);
+    REQUIRE(intern_sum == text_sum);
+    REQUIRE(symbol_text_sum == text_sum);
+
+    cout << "\n" << kCaches << " caches sharing " << kKeys << " keys of " << texts[0].size()
+         << " bytes, one lookup per cache per request\n";
+    cout << fixed << setprecision(1);
+    cout << "  key bytes: string " << string_bytes / double(1 << 20) << " MiB, interned " << symbol_bytes / double(1 << 20)
+         << " MiB (pool " << pool.memory_bytes() / double(1 << 20) << " MiB)\n";
+    cout << "  LRUCache<string>::get(text)             " << setw(7) << text_ns << " ns/request\n";
+    cout << "  LRUCache<Symbol>::get(symbol)           " << setw(7) << symbol_ns << " ns/request\n";
+    cout << "  intern(text), then get(symbol)          " << setw(7) << intern_ns << " ns/request\n";
+    cout << "  LRUCache<Symbol>::get(text)             " << setw(7) << symbol_text_ns << " ns/request\n";
+}
+
+TEST_CASE("Request-scoped caches on an arena", "[benchmark]") {
+    // Each request builds a small memo cache, fills it, reads it back and
+    // drops it; the arena is reset between requests
+    constexpr size_t kItems = 64;
+    constexpr int kRequests = 200'000;
+
+    auto request = [](pmr::memory_resource* resource) {
+        LRUCache<uint64_t, uint64_t> memo(kItems, resource);
+        for (uint64_t i = 0; i < kItems; ++i) {
+            (void)memo.set(i * 0x9E3779B97F4A7C15ULL, i);
+        }
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < kItems; ++i) {
+            sum += *memo.get(i * 0x9E3779B97F4A7C15ULL);
+        }
+        return sum;
+    };
+    auto time_ns_per_request = [&](pmr::memory_resource* resource, auto&& after_request) {
+        uint64_t sum = 0;
+        const auto start = chrono::steady_clock::now();
+        for (int r = 0; r < kRequests; ++r) {
+            sum += request(resource);
+            after_request();
+        }
+        REQUIRE(sum == uint64_t{kRequests} * kItems * (kItems - 1) / 2);
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kRequests;
+    };
+
+    const double heap_ns = time_ns_per_request(pmr::new_delete_resource(), [] {});
+    arena::MonotonicArena monotonic;
+    const double arena_ns = time_ns_per_request(&monotonic, [&] { monotonic.reset(); });
+    arena::SizeClassPool pool;
+    const double pool_ns = time_ns_per_request(&pool, [] {});
+
+    cout << "\nRequest-scoped LRUCache<uint64_t, uint64_t>(" << kItems << "): build, fill, read, destroy\n";
+    cout << fixed << setprecision(1);
+    cout << "  global heap                  " << setw(8) << heap_ns << " ns/request\n";
+    cout << "  MonotonicArena, reset        " << setw(8) << arena_ns << " ns/request\n";
+    cout << "  SizeClassPool                " << setw(8) << pool_ns << " ns/request\n";
+}
+
 #endif
@@ -2,15 +2,21 @@
 #define LRU_H
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <memory_resource>
 #include <new>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -21,16 +27,218 @@ concept Hashable = requires(const K& key) {
     { hash<K>{}(key) } -> convertible_to<size_t>;
 };
 
-template <Hashable K, typename V>
+// Replacement policies. LRUPolicy keeps one recency list; ARCPolicy splits
+// it into T1 (seen once) and T2 (seen again) and adapts the split using
+// ghost lists of recently evicted hashes (Megiddo & Modha, FAST '03).
+struct LRUPolicy {
+    struct node_state {};
+};
+
+struct ARCPolicy {
+    struct node_state {
+        bool frequent = false;
+    };
+};
+
+template <typename P>
+concept ReplacementPolicy = same_as<P, LRUPolicy> || same_as<P, ARCPolicy>;
+
+// Lookups by something other than K. Specialise for K with static
+// hash(lookup), which must equal hash<K> of the matching key, and
+// equal(stored, lookup); interned_keys.h does so for intern::Symbol.
+template <typename K>
+struct LookupTraits {};
+
+// Moves from's buffer and resource into to. Plain move assignment keeps
+// to's resource and copies element by element when the resources differ,
+// which is not a valid move for objects living in raw storage.
+template <typename T>
+void take_storage(pmr::vector<T>& to, pmr::vector<T>& from) noexcept {
+    std::destroy_at(&to);
+    std::construct_at(&to, std::move(from));
+}
+
+// ARC's B1/B2 ghost lists. A ghost is only the hash of an evicted key, kept
+// in a fixed arena with its own linear-probing index. Colliding hashes may
+// sit in the index twice; that only costs a spurious adaptation step.
+class ArcGhosts {
+public:
+    enum class List : uint8_t { none, b1, b2 };
+
+    static constexpr uint32_t NONE = numeric_limits<uint32_t>::max();
+
+    ArcGhosts() = default;
+    ArcGhosts(size_t capacity, pmr::memory_resource* resource);
+    ArcGhosts(ArcGhosts&&) noexcept = default;
+    ArcGhosts& operator=(ArcGhosts&& other) noexcept;
+
+    uint32_t find(size_t hash_value) const;
+    List list_of(uint32_t ghost) const noexcept { return ghosts_[ghost].list; }
+    size_t size(List list) const noexcept { return list == List::b1 ? sizes_[0] : sizes_[1]; }
+
+    void push(List list, size_t hash_value);
+    void remove(uint32_t ghost);
+    void pop_lru(List list);
+    void clear();
+
+private:
+    struct Ghost {
+        size_t hash = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint32_t slot = NONE;
+        List list = List::none;
+    };
+
+    pmr::vector<Ghost> ghosts_;
+    pmr::vector<uint32_t> index_;
+    uint32_t free_head_ = NONE;
+    uint32_t heads_[2] = {NONE, NONE};
+    uint32_t tails_[2] = {NONE, NONE};
+    size_t sizes_[2] = {0, 0};
+
+    static size_t list_slot(List list) noexcept { return list == List::b1 ? 0 : 1; }
+};
+
+inline ArcGhosts::ArcGhosts(size_t capacity, pmr::memory_resource* resource)
+    : ghosts_(capacity, resource), index_(resource) {
+    size_t slots = 4;
+    while (slots < capacity * 2) {
+        slots <<= 1;
+    }
+    index_.assign(capacity == 0 ? 0 : slots, NONE);
+    clear();
+}
+
+inline ArcGhosts& ArcGhosts::operator=(ArcGhosts&& other) noexcept {
+    if (this != &other) {
+        take_storage(ghosts_, other.ghosts_);
+        take_storage(index_, other.index_);
+        free_head_ = other.free_head_;
+        copy(begin(other.heads_), end(other.heads_), heads_);
+        copy(begin(other.tails_), end(other.tails_), tails_);
+        copy(begin(other.sizes_), end(other.sizes_), sizes_);
+        other.clear();
+    }
+    return *this;
+}
+
+inline uint32_t ArcGhosts::find(size_t hash_value) const {
+    if (index_.empty()) {
+        return NONE;
+    }
+
+    const auto mask = index_.size() - 1;
+    for (auto slot = hash_value & mask; index_[slot] != NONE; slot = (slot + 1) & mask) {
+        if (ghosts_[index_[slot]].hash == hash_value) {
+            return index_[slot];
+        }
+    }
+    return NONE;
+}
+
+inline void ArcGhosts::push(List list, size_t hash_value) {
+    if (ghosts_.empty()) {
+        return;
+    }
+
+    if (free_head_ == NONE) {
+        pop_lru(sizes_[0] > 0 ? List::b1 : List::b2);
+    }
+
+    const auto ghost_index = free_head_;
+    auto& ghost = ghosts_[ghost_index];
+    free_head_ = ghost.next;
+
+    const auto which = list_slot(list);
+    ghost.hash = hash_value;
+    ghost.list = list;
+    ghost.prev = NONE;
+    ghost.next = heads_[which];
+    if (heads_[which] != NONE) {
+        ghosts_[heads_[which]].prev = ghost_index;
+    } else {
+        tails_[which] = ghost_index;
+    }
+    heads_[which] = ghost_index;
+    ++sizes_[which];
+
+    const auto mask = index_.size() - 1;
+    auto slot = hash_value & mask;
+    while (index_[slot] != NONE) {
+        slot = (slot + 1) & mask;
+    }
+    index_[slot] = ghost_index;
+    ghost.slot = static_cast<uint32_t>(slot);
+}
+
+inline void ArcGhosts::remove(uint32_t ghost_index) {
+    auto& ghost = ghosts_[ghost_index];
+    const auto which = list_slot(ghost.list);
+
+    if (ghost.prev != NONE) {
+        ghosts_[ghost.prev].next = ghost.next;
+    } else {
+        heads_[which] = ghost.next;
+    }
+    if (ghost.next != NONE) {
+        ghosts_[ghost.next].prev = ghost.prev;
+    } else {
+        tails_[which] = ghost.prev;
+    }
+    --sizes_[which];
+
+    // Backward-shift deletion keeps probe chains unbroken without tombstones
+    const auto mask = index_.size() - 1;
+    auto hole = static_cast<size_t>(ghost.slot);
+    for (auto next = (hole + 1) & mask; index_[next] != NONE; next = (next + 1) & mask) {
+        const auto ideal = ghosts_[index_[next]].hash & mask;
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            index_[hole] = index_[next];
+            ghosts_[index_[hole]].slot = static_cast<uint32_t>(hole);
+            hole = next;
+        }
+    }
+    index_[hole] = NONE;
+
+    ghost.list = List::none;
+    ghost.prev = NONE;
+    ghost.next = free_head_;
+    free_head_ = ghost_index;
+}
+
+inline void ArcGhosts::pop_lru(List list) {
+    if (const auto tail = tails_[list_slot(list)]; tail != NONE) {
+        remove(tail);
+    }
+}
+
+inline void ArcGhosts::clear() {
+    for (size_t i = 0; i < ghosts_.size(); ++i) {
+        ghosts_[i] = Ghost{};
+        ghosts_[i].next = i + 1 < ghosts_.size() ? static_cast<uint32_t>(i + 1) : NONE;
+    }
+    fill(index_.begin(), index_.end(), NONE);
+    free_head_ = ghosts_.empty() ? NONE : 0;
+    heads_[0] = heads_[1] = NONE;
+    tails_[0] = tails_[1] = NONE;
+    sizes_[0] = sizes_[1] = 0;
+}
+
+template <Hashable K, typename V, ReplacementPolicy Policy = LRUPolicy>
 class LRUCache {
 public:
     using key_type = K;
     using mapped_type = V;
+    using policy_type = Policy;
+    // Called with the victim's key and value just before it is destroyed
+    using eviction_handler = function<void(K&&, V&&)>;
     using value_type = pair<const K&, V&>;
     using const_value_type = pair<const K&, const V&>;
 
 private:
     static constexpr size_t INVALID_INDEX = numeric_limits<size_t>::max();
+    static constexpr bool is_arc = same_as<Policy, ARCPolicy>;
 
     template <typename T>
     struct Storage {
@@ -54,6 +262,7 @@ private:
         size_t next = INVALID_INDEX;
         size_t hash = 0;
         size_t bucket_index = INVALID_INDEX;
+        [[no_unique_address]] typename Policy::node_state policy_state;
 
         K& key() noexcept { return *key_storage.ptr(); }
         const K& key() const noexcept { return *key_storage.ptr(); }
@@ -78,20 +287,60 @@ private:
         }
     };
 
+    // Eight bytes, so a cache line holds eight buckets. The fingerprint
+    // rejects most non-matching buckets without touching the node; PSLs are
+    // 16-bit, which holds as long as hash<K> does not give 65536 live keys
+    // the same value (insert_bucket asserts it rather than wrap).
     struct Bucket {
-        size_t node_index = INVALID_INDEX;
-        size_t psl = 0;
+        static constexpr uint32_t EMPTY = numeric_limits<uint32_t>::max();
+
+        uint32_t node_index = EMPTY;
+        uint16_t psl = 0;
+        uint16_t fingerprint = 0;
 
-        bool is_empty() const noexcept { return node_index == INVALID_INDEX; }
+        bool is_empty() const noexcept { return node_index == EMPTY; }
     };
+    static_assert(sizeof(Bucket) == 8);
 
-    vector<Entry> nodes_;
-    vector<Bucket> hash_buckets_;
+    pmr::vector<Entry> nodes_;
+    pmr::vector<Bucket> hash_buckets_;
+    // 64 - log2(bucket count): homes come from the top bits of the mixed hash
+    unsigned bucket_shift_ = 64;
     size_t free_head_ = INVALID_INDEX;
     size_t lru_head_ = INVALID_INDEX;
     size_t lru_tail_ = INVALID_INDEX;
     size_t size_ = 0;
 
+    // ARC only: one list ordered [T2 MRU..T2 LRU][T1 MRU..T1 LRU], so the
+    // iterator and unlink/link code are shared with LRU. t1_head_ marks
+    // the boundary; target_t1_ is ARC's adaptive target size p for T1.
+    struct ArcState {
+        size_t t1_head = INVALID_INDEX;
+        size_t t1_size = 0;
+        size_t target_t1 = 0;
+        ArcGhosts ghosts;
+    };
+    struct NoPolicyState {};
+    [[no_unique_address]] conditional_t<is_arc, ArcState, NoPolicyState> arc_;
+    eviction_handler on_evict_;
+
+    // Checked in the mem-initializer, before nodes_ allocates
+    static size_t checked_item_limit(size_t item_limit) {
+        if (item_limit >= Bucket::EMPTY) {
+            throw length_error("LRUCache: item_limit must fit in 32 bits");
+        }
+        return item_limit;
+    }
+
+    // The ghost arena is built in place so it shares the cache's resource
+    static auto make_policy_state(size_t item_limit, pmr::memory_resource* resource) {
+        if constexpr (is_arc) {
+            return ArcState{INVALID_INDEX, 0, 0, ArcGhosts(item_limit, resource)};
+        } else {
+            return NoPolicyState{};
+        }
+    }
+
     static constexpr size_t next_power_of_two(size_t n) noexcept {
         if (n == 0) {
             return 1;
@@ -107,6 +356,20 @@ private:
         return n + 1;
     }
 
+    // Fibonacci mixing, so identity hashes of clustered integers spread out
+    static uint64_t mix_hash(size_t hash_value) noexcept {
+        return static_cast<uint64_t>(hash_value) * 0x9e3779b97f4a7c15ULL;
+    }
+    // The 16 bits just below the home bits of the same product, so keys
+    // that share a home still differ in fingerprint; bucket_shift_ is at
+    // least 31, as the table never exceeds 2^33 buckets
+    uint16_t fingerprint_of(size_t hash_value) const noexcept {
+        return static_cast<uint16_t>(mix_hash(hash_value) >> (bucket_shift_ - 16));
+    }
+    size_t home_bucket(size_t hash_value) const noexcept {
+        return static_cast<size_t>(mix_hash(hash_value) >> bucket_shift_);
+    }
+
     static size_t hash_lookup(const K& key) { return hash<K>{}(key); }
     static bool keys_equal(const K& stored, const K& key) { return stored == key; }
 
@@ -126,6 +389,17 @@ private:
         return stored == key;
     }
 
+    template <typename KeyLike>
+    static size_t hash_lookup(const KeyLike& key) requires requires { LookupTraits<K>::hash(key); } {
+        return LookupTraits<K>::hash(key);
+    }
+
+    template <typename KeyLike>
+    static bool keys_equal(const K& stored, const KeyLike& key)
+        requires requires { LookupTraits<K>::equal(stored, key); } {
+        return LookupTraits<K>::equal(stored, key);
+    }
+
     void init_free_list();
     template <typename KeyLike>
     size_t find_bucket_with_hash(const KeyLike& key, size_t hash_value) const
@@ -135,10 +409,15 @@ private:
         };
     void insert_bucket(size_t node_index, size_t hash_value);
     void remove_bucket(size_t node_index);
+    void link_before(size_t node_index, size_t next_index);
     void link_as_mru(size_t node_index);
     void unlink(size_t node_index);
     void move_to_mru(size_t node_index);
+    void touch(size_t node_index);
+    void evict_node(size_t node_index);
     void evict_lru();
+    bool arc_make_room(size_t hash_value) requires is_arc;
+    void arc_replace(bool hit_in_b2) requires is_arc;
     void destroy_all() noexcept;
 
 public:
@@ -215,7 +494,10 @@ public:
         size_t current_ = INVALID_INDEX;
     };
 
-    explicit LRUCache(size_t item_limit);
+    // All storage (nodes, buckets, ARC ghosts) comes from resource, which
+    // must outlive the cache; e.g. an arena::MonotonicArena reset once a
+    // request-scoped cache is gone.
+    explicit LRUCache(size_t item_limit, pmr::memory_resource* resource = pmr::get_default_resource());
     ~LRUCache();
     LRUCache(LRUCache&& other) noexcept;
     LRUCache& operator=(LRUCache&& other) noexcept;
@@ -248,8 +530,25 @@ public:
 
     size_t size() const noexcept { return size_; }
     size_t capacity() const noexcept { return nodes_.size(); }
+    // The bucket fingerprint key gets in this table, for probe diagnostics
+    uint16_t fingerprint(const K& key) const noexcept { return fingerprint_of(hash<K>{}(key)); }
+    pmr::memory_resource* resource() const noexcept { return nodes_.get_allocator().resource(); }
+
+    // Evictions made to admit new keys go through the handler; clear() does not
+    void set_eviction_handler(eviction_handler handler) { on_evict_ = std::move(handler); }
 
     void clear();
+    // Evicts one entry as if making room for a new key; false when empty
+    bool evict();
+
+    // Resident keys first seen once (ARC's T1); always 0 under LRUPolicy
+    size_t recent_size() const noexcept {
+        if constexpr (is_arc) {
+            return arc_.t1_size;
+        } else {
+            return 0;
+        }
+    }
 
     iterator begin() noexcept;
     iterator end() noexcept;
@@ -259,8 +558,9 @@ public:
     const_iterator cend() const noexcept;
 };
 
-template <Hashable K, typename V>
-LRUCache<K, V>::LRUCache(size_t item_limit) : nodes_(item_limit) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+LRUCache<K, V, Policy>::LRUCache(size_t item_limit, pmr::memory_resource* resource)
+    : nodes_(checked_item_limit(item_limit), resource), hash_buckets_(resource), arc_(make_policy_state(item_limit, resource)) {
     if (nodes_.empty()) {
         return;
     }
@@ -271,51 +571,56 @@ LRUCache<K, V>::LRUCache(size_t item_limit) : nodes_(item_limit) {
     }
 
     hash_buckets_.resize(bucket_count);
+    bucket_shift_ = static_cast<unsigned>(64 - countr_zero(bucket_count));
     init_free_list();
 }
 
-template <Hashable K, typename V>
-LRUCache<K, V>::~LRUCache() {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+LRUCache<K, V, Policy>::~LRUCache() {
     destroy_all();
 }
 
-template <Hashable K, typename V>
-LRUCache<K, V>::LRUCache(LRUCache&& other) noexcept
+template <Hashable K, typename V, ReplacementPolicy Policy>
+LRUCache<K, V, Policy>::LRUCache(LRUCache&& other) noexcept
     : nodes_(std::move(other.nodes_)),
       hash_buckets_(std::move(other.hash_buckets_)),
+      bucket_shift_(other.bucket_shift_),
       free_head_(other.free_head_),
       lru_head_(other.lru_head_),
       lru_tail_(other.lru_tail_),
-      size_(other.size_) {
+      size_(other.size_),
+      arc_(std::move(other.arc_)),
+      on_evict_(std::move(other.on_evict_)) {
     other.free_head_ = INVALID_INDEX;
     other.lru_head_ = INVALID_INDEX;
     other.lru_tail_ = INVALID_INDEX;
     other.size_ = 0;
+    other.arc_ = {};
 }
 
-template <Hashable K, typename V>
-LRUCache<K, V>& LRUCache<K, V>::operator=(LRUCache&& other) noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+LRUCache<K, V, Policy>& LRUCache<K, V, Policy>::operator=(LRUCache&& other) noexcept {
     if (this == &other) {
         return *this;
     }
 
+    // Takes other's storage and resource as-is, like the move constructor
     destroy_all();
-    nodes_ = std::move(other.nodes_);
-    hash_buckets_ = std::move(other.hash_buckets_);
-    free_head_ = other.free_head_;
-    lru_head_ = other.lru_head_;
-    lru_tail_ = other.lru_tail_;
-    size_ = other.size_;
-
-    other.free_head_ = INVALID_INDEX;
-    other.lru_head_ = INVALID_INDEX;
-    other.lru_tail_ = INVALID_INDEX;
-    other.size_ = 0;
+    take_storage(nodes_, other.nodes_);
+    take_storage(hash_buckets_, other.hash_buckets_);
+    bucket_shift_ = other.bucket_shift_;
+    free_head_ = exchange(other.free_head_, INVALID_INDEX);
+    lru_head_ = exchange(other.lru_head_, INVALID_INDEX);
+    lru_tail_ = exchange(other.lru_tail_, INVALID_INDEX);
+    size_ = exchange(other.size_, 0);
+    arc_ = std::move(other.arc_);
+    other.arc_ = {};
+    on_evict_ = std::move(other.on_evict_);
     return *this;
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::init_free_list() {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::init_free_list() {
     for (size_t i = 0; i < nodes_.size(); ++i) {
         auto& node = nodes_[i];
         node.prev = INVALID_INDEX;
@@ -325,8 +630,8 @@ void LRUCache<K, V>::init_free_list() {
     free_head_ = nodes_.empty() ? INVALID_INDEX : 0;
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::destroy_all() noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::destroy_all() noexcept {
     for (auto node_index = lru_head_; node_index != INVALID_INDEX;) {
         auto& node = nodes_[node_index];
         const auto next_index = node.next;
@@ -335,9 +640,9 @@ void LRUCache<K, V>::destroy_all() noexcept {
     }
 }
 
-template <Hashable K, typename V>
+template <Hashable K, typename V, ReplacementPolicy Policy>
 template <typename KeyLike>
-size_t LRUCache<K, V>::find_bucket_with_hash(const KeyLike& key, size_t hash_value) const
+size_t LRUCache<K, V, Policy>::find_bucket_with_hash(const KeyLike& key, size_t hash_value) const
     requires requires(const K& stored, const KeyLike& lookup) {
         { hash_lookup(lookup) } -> convertible_to<size_t>;
         { keys_equal(stored, lookup) } -> convertible_to<bool>;
@@ -347,7 +652,8 @@ size_t LRUCache<K, V>::find_bucket_with_hash(const KeyLike& key, size_t hash_val
     }
 
     const auto mask = hash_buckets_.size() - 1;
-    const auto ideal = hash_value & mask;
+    const auto ideal = home_bucket(hash_value);
+    const auto fingerprint = fingerprint_of(hash_value);
 
     for (size_t psl = 0; psl < hash_buckets_.size(); ++psl) {
         const auto index = (ideal + psl) & mask;
@@ -357,6 +663,9 @@ size_t LRUCache<K, V>::find_bucket_with_hash(const KeyLike& key, size_t hash_val
             return INVALID_INDEX;
         }
 
+        if (bucket.fingerprint != fingerprint) {
+            continue;
+        }
         const auto& node = nodes_[bucket.node_index];
         if (node.hash == hash_value && keys_equal(node.key(), key)) {
             return index;
@@ -366,11 +675,11 @@ size_t LRUCache<K, V>::find_bucket_with_hash(const KeyLike& key, size_t hash_val
     return INVALID_INDEX;
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::insert_bucket(size_t node_index, size_t hash_value) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::insert_bucket(size_t node_index, size_t hash_value) {
     const auto mask = hash_buckets_.size() - 1;
-    const auto ideal = hash_value & mask;
-    Bucket pending{node_index, 0};
+    const auto ideal = home_bucket(hash_value);
+    Bucket pending{static_cast<uint32_t>(node_index), 0, fingerprint_of(hash_value)};
 
     for (size_t psl = 0;; ++psl, ++pending.psl) {
         const auto index = (ideal + psl) & mask;
@@ -386,11 +695,12 @@ void LRUCache<K, V>::insert_bucket(size_t node_index, size_t hash_value) {
             swap(bucket, pending);
             nodes_[bucket.node_index].bucket_index = index;
         }
+        assert(pending.psl != numeric_limits<uint16_t>::max() && "LRUCache: probe sequence length overflow");
     }
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::remove_bucket(size_t node_index) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::remove_bucket(size_t node_index) {
     if (hash_buckets_.empty()) {
         return;
     }
@@ -417,24 +727,38 @@ void LRUCache<K, V>::remove_bucket(size_t node_index) {
     }
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::link_as_mru(size_t node_index) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::link_before(size_t node_index, size_t next_index) {
     auto& node = nodes_[node_index];
-    node.prev = INVALID_INDEX;
-    node.next = lru_head_;
+    node.prev = next_index != INVALID_INDEX ? nodes_[next_index].prev : lru_tail_;
+    node.next = next_index;
+
+    if (node.prev != INVALID_INDEX) {
+        nodes_[node.prev].next = node_index;
+    } else {
+        lru_head_ = node_index;
+    }
 
-    if (lru_head_ != INVALID_INDEX) {
-        nodes_[lru_head_].prev = node_index;
+    if (next_index != INVALID_INDEX) {
+        nodes_[next_index].prev = node_index;
     } else {
         lru_tail_ = node_index;
     }
+}
 
-    lru_head_ = node_index;
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::link_as_mru(size_t node_index) {
+    link_before(node_index, lru_head_);
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::unlink(size_t node_index) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::unlink(size_t node_index) {
     const auto& node = nodes_[node_index];
+    if constexpr (is_arc) {
+        if (node_index == arc_.t1_head) {
+            arc_.t1_head = node.next;
+        }
+    }
 
     if (node.prev != INVALID_INDEX) {
         nodes_[node.prev].next = node.next;
@@ -449,8 +773,8 @@ void LRUCache<K, V>::unlink(size_t node_index) {
     }
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::move_to_mru(size_t node_index) {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::move_to_mru(size_t node_index) {
     if (node_index == lru_head_) {
         return;
     }
@@ -459,33 +783,151 @@ void LRUCache<K, V>::move_to_mru(size_t node_index) {
     link_as_mru(node_index);
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::evict_lru() {
-    const auto victim = lru_tail_;
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::touch(size_t node_index) {
+    if constexpr (is_arc) {
+        // Any re-reference promotes to T2's MRU end, the head of the list
+        auto& state = nodes_[node_index].policy_state;
+        if (state.frequent) {
+            move_to_mru(node_index);
+            return;
+        }
+        state.frequent = true;
+        --arc_.t1_size;
+        unlink(node_index);
+        link_as_mru(node_index);
+    } else {
+        move_to_mru(node_index);
+    }
+}
+
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::evict_node(size_t victim) {
     unlink(victim);
     remove_bucket(victim);
 
     auto& node = nodes_[victim];
-    node.destroy();
-    node.prev = INVALID_INDEX;
-    node.next = free_head_;
-    free_head_ = victim;
-    --size_;
+    auto release = [&]() noexcept {
+        node.destroy();
+        node.prev = INVALID_INDEX;
+        node.next = free_head_;
+        free_head_ = victim;
+        --size_;
+    };
+
+    if (on_evict_) {
+        try {
+            on_evict_(std::move(node.key()), std::move(node.value()));
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+    release();
 }
 
-template <Hashable K, typename V>
-void LRUCache<K, V>::clear() {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::evict_lru() {
+    evict_node(lru_tail_);
+}
+
+template <Hashable K, typename V, ReplacementPolicy Policy>
+bool LRUCache<K, V, Policy>::evict() {
+    if (size_ == 0) {
+        return false;
+    }
+
+    if constexpr (is_arc) {
+        arc_replace(false);
+    } else {
+        evict_lru();
+    }
+    return true;
+}
+
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::arc_replace(bool hit_in_b2) requires is_arc {
+    const bool t2_empty = arc_.t1_size == size_;
+    const bool from_t1 = arc_.t1_size > 0 &&
+                         (t2_empty || arc_.t1_size > arc_.target_t1 ||
+                          (hit_in_b2 && arc_.t1_size == arc_.target_t1));
+
+    // T1's LRU is the list tail; T2's LRU sits just before the boundary
+    const auto victim = from_t1 || arc_.t1_head == INVALID_INDEX ? lru_tail_ : nodes_[arc_.t1_head].prev;
+    arc_.ghosts.push(from_t1 ? ArcGhosts::List::b1 : ArcGhosts::List::b2, nodes_[victim].hash);
+    if (from_t1) {
+        --arc_.t1_size;
+    }
+    evict_node(victim);
+}
+
+// Runs ARC's miss path for a key about to be inserted. Returns true when
+// the key was a ghost, so it goes straight into T2.
+template <Hashable K, typename V, ReplacementPolicy Policy>
+bool LRUCache<K, V, Policy>::arc_make_room(size_t hash_value) requires is_arc {
+    using List = ArcGhosts::List;
+    auto& ghosts = arc_.ghosts;
+    const auto capacity = nodes_.size();
+    const bool full = size_ == capacity;
+    const auto b1 = ghosts.size(List::b1);
+    const auto b2 = ghosts.size(List::b2);
+
+    if (const auto ghost = ghosts.find(hash_value); ghost != ArcGhosts::NONE) {
+        const bool in_b2 = ghosts.list_of(ghost) == List::b2;
+        if (in_b2) {
+            const auto step = max<size_t>(b1 / b2, 1);
+            arc_.target_t1 = arc_.target_t1 > step ? arc_.target_t1 - step : 0;
+        } else {
+            arc_.target_t1 = min(capacity, arc_.target_t1 + max<size_t>(b2 / b1, 1));
+        }
+        ghosts.remove(ghost);
+        if (full) {
+            arc_replace(in_b2);
+        }
+        return true;
+    }
+
+    if (arc_.t1_size + b1 >= capacity) {
+        if (arc_.t1_size < capacity) {
+            ghosts.pop_lru(List::b1);
+            if (full) {
+                arc_replace(false);
+            }
+        } else {
+            // T1 alone fills the cache: drop its LRU without a ghost
+            --arc_.t1_size;
+            evict_node(lru_tail_);
+        }
+    } else if (size_ + b1 + b2 >= capacity) {
+        if (size_ + b1 + b2 >= 2 * capacity) {
+            ghosts.pop_lru(List::b2);
+        }
+        if (full) {
+            arc_replace(false);
+        }
+    }
+    return false;
+}
+
+template <Hashable K, typename V, ReplacementPolicy Policy>
+void LRUCache<K, V, Policy>::clear() {
     destroy_all();
     size_ = 0;
     lru_head_ = INVALID_INDEX;
     lru_tail_ = INVALID_INDEX;
     fill(hash_buckets_.begin(), hash_buckets_.end(), Bucket{});
     init_free_list();
+    if constexpr (is_arc) {
+        arc_.t1_head = INVALID_INDEX;
+        arc_.t1_size = 0;
+        arc_.target_t1 = 0;
+        arc_.ghosts.clear();
+    }
 }
 
-template <Hashable K, typename V>
+template <Hashable K, typename V, ReplacementPolicy Policy>
 template <typename KeyLike>
-bool LRUCache<K, V>::has(const KeyLike& key) const
+bool LRUCache<K, V, Policy>::has(const KeyLike& key) const
     requires requires(const K& stored, const KeyLike& lookup) {
         { hash_lookup(lookup) } -> convertible_to<size_t>;
         { keys_equal(stored, lookup) } -> convertible_to<bool>;
@@ -493,9 +935,9 @@ bool LRUCache<K, V>::has(const KeyLike& key) const
     return find_bucket_with_hash(key, hash_lookup(key)) != INVALID_INDEX;
 }
 
-template <Hashable K, typename V>
+template <Hashable K, typename V, ReplacementPolicy Policy>
 template <typename KeyLike>
-V* LRUCache<K, V>::get(const KeyLike& key)
+V* LRUCache<K, V, Policy>::get(const KeyLike& key)
     requires requires(const K& stored, const KeyLike& lookup) {
         { hash_lookup(lookup) } -> convertible_to<size_t>;
         { keys_equal(stored, lookup) } -> convertible_to<bool>;
@@ -506,13 +948,13 @@ V* LRUCache<K, V>::get(const KeyLike& key)
     }
 
     const auto node_index = hash_buckets_[bucket_index].node_index;
-    move_to_mru(node_index);
+    touch(node_index);
     return &nodes_[node_index].value();
 }
 
-template <Hashable K, typename V>
+template <Hashable K, typename V, ReplacementPolicy Policy>
 template <typename KeyLike>
-const V* LRUCache<K, V>::get(const KeyLike& key) const
+const V* LRUCache<K, V, Policy>::get(const KeyLike& key) const
     requires requires(const K& stored, const KeyLike& lookup) {
         { hash_lookup(lookup) } -> convertible_to<size_t>;
         { keys_equal(stored, lookup) } -> convertible_to<bool>;
@@ -525,9 +967,9 @@ const V* LRUCache<K, V>::get(const KeyLike& key) const
     return &nodes_[hash_buckets_[bucket_index].node_index].value();
 }
 
-template <Hashable K, typename V>
+template <Hashable K, typename V, ReplacementPolicy Policy>
 template <typename KType, typename VType>
-bool LRUCache<K, V>::set(KType&& key, VType&& value) {
+bool LRUCache<K, V, Policy>::set(KType&& key, VType&& value) {
     if (nodes_.empty()) [[unlikely]] {
         return false;
     }
@@ -537,11 +979,14 @@ bool LRUCache<K, V>::set(KType&& key, VType&& value) {
     if (bucket_index != INVALID_INDEX) {
         auto& node = nodes_[hash_buckets_[bucket_index].node_index];
         node.value() = std::forward<VType>(value);
-        move_to_mru(hash_buckets_[bucket_index].node_index);
+        touch(hash_buckets_[bucket_index].node_index);
         return true;
     }
 
-    if (size_ == nodes_.size()) {
+    [[maybe_unused]] bool into_t2 = false;
+    if constexpr (is_arc) {
+        into_t2 = arc_make_room(hash_value);
+    } else if (size_ == nodes_.size()) {
         evict_lru();
     }
 
@@ -559,39 +1004,53 @@ bool LRUCache<K, V>::set(KType&& key, VType&& value) {
     node.hash = hash_value;
 
     insert_bucket(slot, hash_value);
-    link_as_mru(slot);
+    if constexpr (is_arc) {
+        node.policy_state.frequent = into_t2;
+        if (into_t2) {
+            link_as_mru(slot);
+        } else {
+            link_before(slot, arc_.t1_head);
+            arc_.t1_head = slot;
+            ++arc_.t1_size;
+        }
+    } else {
+        link_as_mru(slot);
+    }
     ++size_;
     return true;
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::iterator LRUCache<K, V>::begin() noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::iterator LRUCache<K, V, Policy>::begin() noexcept {
     return iterator(nodes_.data(), lru_head_);
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::iterator LRUCache<K, V>::end() noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::iterator LRUCache<K, V, Policy>::end() noexcept {
     return iterator(nodes_.data(), INVALID_INDEX);
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::const_iterator LRUCache<K, V>::begin() const noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::const_iterator LRUCache<K, V, Policy>::begin() const noexcept {
     return const_iterator(nodes_.data(), lru_head_);
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::const_iterator LRUCache<K, V>::end() const noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::const_iterator LRUCache<K, V, Policy>::end() const noexcept {
     return const_iterator(nodes_.data(), INVALID_INDEX);
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::const_iterator LRUCache<K, V>::cbegin() const noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::const_iterator LRUCache<K, V, Policy>::cbegin() const noexcept {
     return begin();
 }
 
-template <Hashable K, typename V>
-typename LRUCache<K, V>::const_iterator LRUCache<K, V>::cend() const noexcept {
+template <Hashable K, typename V, ReplacementPolicy Policy>
+typename LRUCache<K, V, Policy>::const_iterator LRUCache<K, V, Policy>::cend() const noexcept {
     return end();
 }
 
+template <Hashable K, typename V>
+using ARCCache = LRUCache<K, V, ARCPolicy>;
+
 #endif
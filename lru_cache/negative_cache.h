@@ -0,0 +1,219 @@
+#ifndef NEGATIVE_CACHE_H
+#define NEGATIVE_CACHE_H
+
+#include "lru_cache.h"
+
+#include <bit>
+#include <optional>
+
+using namespace std;
+
+// Open-addressed set of nonzero 64-bit hashes: one word per slot, 0 marks
+// an empty one. Linear probing with backward-shift deletion; it doubles
+// past 3/4 load and halves under 1/8, so it stays 8 to 21 bytes per hash.
+class HashSet64 {
+public:
+    explicit HashSet64(size_t min_slots = 16) : min_slots_(bit_ceil(max<size_t>(min_slots, 16))) {
+        slots_.assign(min_slots_, 0);
+        mask_ = min_slots_ - 1;
+    }
+
+    bool contains(uint64_t hash_value) const noexcept {
+        for (auto i = hash_value & mask_;; i = (i + 1) & mask_) {
+            if (slots_[i] == hash_value) {
+                return true;
+            }
+            if (slots_[i] == 0) {
+                return false;
+            }
+        }
+    }
+
+    // False when already present
+    bool insert(uint64_t hash_value);
+    // False when not present
+    bool erase(uint64_t hash_value);
+
+    void clear() {
+        slots_.assign(min_slots_, 0);
+        mask_ = min_slots_ - 1;
+        size_ = 0;
+    }
+
+    // fn(hash) for every member until it returns false; true if none did
+    template <typename Fn>
+    bool all_of(Fn&& fn) const {
+        for (const auto hash_value : slots_) {
+            if (hash_value != 0 && !fn(hash_value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t size() const noexcept { return size_; }
+    size_t bytes() const noexcept { return slots_.size() * sizeof(uint64_t); }
+
+private:
+    vector<uint64_t> slots_;
+    size_t mask_;
+    size_t size_ = 0;
+    size_t min_slots_;
+
+    void resize(size_t slot_count);
+};
+
+inline bool HashSet64::insert(uint64_t hash_value) {
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        resize(slots_.size() * 2);
+    }
+    auto i = hash_value & mask_;
+    for (; slots_[i] != 0; i = (i + 1) & mask_) {
+        if (slots_[i] == hash_value) {
+            return false;
+        }
+    }
+    slots_[i] = hash_value;
+    ++size_;
+    return true;
+}
+
+inline bool HashSet64::erase(uint64_t hash_value) {
+    auto hole = hash_value & mask_;
+    for (; slots_[hole] != hash_value; hole = (hole + 1) & mask_) {
+        if (slots_[hole] == 0) {
+            return false;
+        }
+    }
+    // Pull back every later member of the run whose home does not lie
+    // cyclically in (hole, next], so no probe stops early at the hole
+    for (auto next = (hole + 1) & mask_; slots_[next] != 0; next = (next + 1) & mask_) {
+        const auto home = slots_[next] & mask_;
+        if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = 0;
+    --size_;
+
+    if (slots_.size() > min_slots_ && size_ * 8 < slots_.size()) {
+        resize(slots_.size() / 2);
+    }
+    return true;
+}
+
+inline void HashSet64::resize(size_t slot_count) {
+    vector<uint64_t> old(slot_count, 0);
+    old.swap(slots_);
+    mask_ = slot_count - 1;
+    for (const auto hash_value : old) {
+        if (hash_value != 0) {
+            auto i = hash_value & mask_;
+            while (slots_[i] != 0) {
+                i = (i + 1) & mask_;
+            }
+            slots_[i] = hash_value;
+        }
+    }
+}
+
+// Keys known to be absent from the backend, as a HashSet64 of their mixed
+// 64-bit hashes. A lookup is one probe of a flat array, usually within one
+// cache line, and answers exactly up to 64-bit hash collisions. The set
+// takes 10.7 to 21 bytes per key, grows and shrinks with its contents, and
+// forgets everything once max_keys hashes are recorded, so a flood of
+// distinct misses cannot grow it without bound. A key recorded absent
+// stays rejected until mark_present() or a reset.
+//
+// An approximate filter in front of the set does not pay here: the exact
+// hashes are needed anyway for removals, and a filter either hides the
+// keys whose fingerprints collide or sends its hits on to the set, a
+// second cache line for every known-absent key.
+template <Hashable K>
+class NegativeCache {
+public:
+    explicit NegativeCache(size_t expected_keys = 1024, size_t max_keys = 1 << 22)
+        : hashes_(expected_keys * 4 / 3), max_keys_(max_keys) {}
+
+    bool known_absent(const K& key) const noexcept { return hashes_.contains(key_hash(key)); }
+
+    void mark_absent(const K& key);
+    void mark_present(const K& key) { (void)hashes_.erase(key_hash(key)); }
+
+    size_t size() const noexcept { return hashes_.size(); }
+    size_t memory_bytes() const noexcept { return hashes_.bytes(); }
+    size_t resets() const noexcept { return resets_; }
+
+private:
+    HashSet64 hashes_;
+    size_t max_keys_;
+    size_t resets_ = 0;
+
+    // Spread hash<K> (the identity for integers) over all 64 bits; never 0,
+    // which HashSet64 reserves
+    static uint64_t key_hash(const K& key) noexcept {
+        uint64_t x = hash<K>{}(key);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        x ^= x >> 31;
+        return x == 0 ? 1 : x;
+    }
+};
+
+template <Hashable K>
+void NegativeCache<K>::mark_absent(const K& key) {
+    const auto hash_value = key_hash(key);
+    if (hashes_.insert(hash_value) && hashes_.size() > max_keys_) {
+        ++resets_;
+        hashes_.clear();
+        hashes_.insert(hash_value);
+    }
+}
+
+// LRUCache with a NegativeCache in front of its misses. get() rejects a key
+// recorded absent before the LRU index is probed, so a known-absent lookup
+// costs one probe of the absent set and never reaches the loader. Any
+// other key is looked up in the LRUCache and, on a miss, asked of the
+// loader: what it returns is cached, and a nullopt is recorded absent.
+// Resident and absent keys never overlap, since a key is only recorded
+// after a miss and set() clears its mark.
+template <Hashable K, typename V>
+class NegativeCachingLRU {
+public:
+    explicit NegativeCachingLRU(size_t capacity, size_t expected_absent = 1024)
+        : entries_(capacity), absent_(expected_absent) {}
+
+    template <typename Loader>
+        requires invocable<Loader&, const K&> && same_as<invoke_result_t<Loader&, const K&>, optional<V>>
+    V* get(const K& key, Loader&& loader) {
+        if (absent_.known_absent(key)) {
+            return nullptr;
+        }
+        if (auto* value = entries_.get(key)) {
+            return value;
+        }
+        auto loaded = loader(key);
+        if (!loaded) {
+            absent_.mark_absent(key);
+            return nullptr;
+        }
+        (void)entries_.set(key, std::move(*loaded));
+        return entries_.get(key);
+    }
+
+    template <typename KType, typename VType>
+    bool set(KType&& key, VType&& value) {
+        absent_.mark_present(key);
+        return entries_.set(std::forward<KType>(key), std::forward<VType>(value));
+    }
+
+    const LRUCache<K, V>& entries() const noexcept { return entries_; }
+    const NegativeCache<K>& absent() const noexcept { return absent_; }
+
+private:
+    LRUCache<K, V> entries_;
+    NegativeCache<K> absent_;
+};
+
+#endif
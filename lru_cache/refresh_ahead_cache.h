@@ -0,0 +1,222 @@
+#ifndef REFRESH_AHEAD_CACHE_H
+#define REFRESH_AHEAD_CACHE_H
+
+#include "lru_cache.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+struct RefreshOptions {
+    chrono::milliseconds ttl{1000};
+    // A hit this close to its deadline schedules a background reload
+    chrono::milliseconds refresh_window{200};
+    size_t max_batch = 64;
+};
+
+// TTL cache that reloads popular keys before they expire. A hit within
+// refresh_window of its deadline queues the key for a background worker and
+// returns the current value; the worker reloads queued keys in batches
+// through the loader. A key is queued at most once until its reload lands.
+// Every write stamps the entry with a generation; a reload only lands on the
+// entry that queued it, so a put() or eviction during the load discards it.
+// Only a cold miss or a fully expired entry loads on the caller's thread.
+// All cache access is under one mutex; loaders run outside it.
+template <Hashable K, typename V, typename Clock = chrono::steady_clock>
+class RefreshAheadCache {
+public:
+    using loader_type = function<V(const K&)>;
+    using batch_loader_type = function<vector<V>(const vector<K>&)>;
+
+    struct Stats {
+        size_t hits = 0;
+        size_t sync_loads = 0;
+        size_t refreshes_queued = 0;
+        size_t refreshes_deduplicated = 0;
+        size_t refresh_batches = 0;
+        size_t refreshes_completed = 0;
+        size_t refreshes_discarded = 0;
+        size_t refresh_failures = 0;
+    };
+
+    RefreshAheadCache(size_t capacity, batch_loader_type loader, RefreshOptions options = {})
+        : entries_(capacity), loader_(std::move(loader)), options_(options),
+          worker_([this](stop_token stop) { run_worker(stop); }) {}
+
+    RefreshAheadCache(size_t capacity, loader_type loader, RefreshOptions options = {})
+        : RefreshAheadCache(capacity, batch_of(std::move(loader)), options) {}
+
+    RefreshAheadCache(const RefreshAheadCache&) = delete;
+    RefreshAheadCache& operator=(const RefreshAheadCache&) = delete;
+
+    V get(const K& key);
+    void put(const K& key, V value);
+
+    // Blocks until every queued refresh has been applied
+    void wait_idle();
+
+    Stats stats() const {
+        lock_guard lock(mutex_);
+        return stats_;
+    }
+
+private:
+    struct Timed {
+        V value;
+        typename Clock::time_point deadline;
+        uint64_t generation;
+    };
+
+    struct Refresh {
+        K key;
+        uint64_t generation;
+    };
+
+    LRUCache<K, Timed> entries_;
+    batch_loader_type loader_;
+    RefreshOptions options_;
+    Stats stats_;
+    uint64_t next_generation_ = 0;
+
+    mutable mutex mutex_;
+    // _any so the worker's wait also wakes on the jthread's stop request
+    condition_variable_any work_ready_;
+    condition_variable idle_;
+    deque<Refresh> queue_;
+    // Key -> generation of the entry that queued it; put() cancels by erasing
+    unordered_map<K, uint64_t> pending_;
+    // Declared last so it starts after, and stops before, everything it uses
+    jthread worker_;
+
+    static batch_loader_type batch_of(loader_type loader) {
+        return [loader = std::move(loader)](const vector<K>& keys) {
+            vector<V> values;
+            values.reserve(keys.size());
+            for (const auto& key : keys) {
+                values.push_back(loader(key));
+            }
+            return values;
+        };
+    }
+
+    void run_worker(stop_token stop);
+};
+
+template <Hashable K, typename V, typename Clock>
+V RefreshAheadCache<K, V, Clock>::get(const K& key) {
+    {
+        lock_guard lock(mutex_);
+        if (auto* entry = entries_.get(key)) {
+            const auto now = Clock::now();
+            if (now < entry->deadline) {
+                ++stats_.hits;
+                if (now + options_.refresh_window >= entry->deadline) {
+                    if (pending_.try_emplace(key, entry->generation).second) {
+                        queue_.push_back(Refresh{key, entry->generation});
+                        ++stats_.refreshes_queued;
+                        work_ready_.notify_one();
+                    } else {
+                        ++stats_.refreshes_deduplicated;
+                    }
+                }
+                return entry->value;
+            }
+        }
+        ++stats_.sync_loads;
+    }
+
+    auto value = loader_(vector<K>{key}).at(0);
+    put(key, value);
+    return value;
+}
+
+template <Hashable K, typename V, typename Clock>
+void RefreshAheadCache<K, V, Clock>::put(const K& key, V value) {
+    lock_guard lock(mutex_);
+    (void)entries_.set(key, Timed{std::move(value), Clock::now() + options_.ttl, ++next_generation_});
+    // Any reload already queued or in flight for key is now stale
+    if (pending_.erase(key) > 0 && pending_.empty()) {
+        idle_.notify_all();
+    }
+}
+
+template <Hashable K, typename V, typename Clock>
+void RefreshAheadCache<K, V, Clock>::wait_idle() {
+    unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return pending_.empty(); });
+}
+
+template <Hashable K, typename V, typename Clock>
+void RefreshAheadCache<K, V, Clock>::run_worker(stop_token stop) {
+    vector<Refresh> batch;
+    vector<K> keys;
+    while (true) {
+        {
+            unique_lock lock(mutex_);
+            if (!work_ready_.wait(lock, stop, [&] { return !queue_.empty(); })) {
+                return;
+            }
+            batch.clear();
+            keys.clear();
+            while (!queue_.empty() && batch.size() < options_.max_batch) {
+                auto refresh = std::move(queue_.front());
+                queue_.pop_front();
+                // Skip refreshes a put() cancelled before they were picked up
+                auto it = pending_.find(refresh.key);
+                if (it != pending_.end() && it->second == refresh.generation) {
+                    keys.push_back(refresh.key);
+                    batch.push_back(std::move(refresh));
+                }
+            }
+            if (batch.empty()) {
+                continue;
+            }
+            ++stats_.refresh_batches;
+        }
+
+        vector<V> values;
+        bool loaded = true;
+        try {
+            values = loader_(keys);
+            loaded = values.size() == keys.size();
+        } catch (...) {
+            loaded = false;
+        }
+
+        lock_guard lock(mutex_);
+        const auto deadline = Clock::now() + options_.ttl;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const auto& refresh = batch[i];
+            auto it = pending_.find(refresh.key);
+            const bool current = it != pending_.end() && it->second == refresh.generation;
+            if (current) {
+                pending_.erase(it);
+            }
+            // A failed reload leaves the old value to expire normally
+            if (!loaded) {
+                ++stats_.refresh_failures;
+                continue;
+            }
+            // Only the entry that queued the refresh may take the reload: an
+            // evicted key stays out, and a newer put() keeps its value
+            auto* entry = current ? entries_.get(refresh.key) : nullptr;
+            if (entry != nullptr && entry->generation == refresh.generation) {
+                *entry = Timed{std::move(values[i]), deadline, ++next_generation_};
+                ++stats_.refreshes_completed;
+            } else {
+                ++stats_.refreshes_discarded;
+            }
+        }
+        if (pending_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+#endif
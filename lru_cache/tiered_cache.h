@@ -0,0 +1,370 @@
+#ifndef TIERED_CACHE_H
+#define TIERED_CACHE_H
+
+#include "lru_cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <span>
+#include <system_error>
+
+using namespace std;
+
+// Types the file tier can write as raw bytes
+template <typename T>
+concept TierStorable = is_trivially_copyable_v<T> || same_as<T, string>;
+
+template <TierStorable T>
+span<const byte> tier_bytes(const T& value) noexcept {
+    if constexpr (same_as<T, string>) {
+        return as_bytes(span(value.data(), value.size()));
+    } else {
+        return as_bytes(span(&value, 1));
+    }
+}
+
+template <TierStorable T>
+T tier_load(span<const byte> bytes) {
+    if constexpr (same_as<T, string>) {
+        return string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    } else {
+        T value;
+        memcpy(&value, bytes.data(), sizeof(T));
+        return value;
+    }
+}
+
+// Log-structured victim store in a single file used as a ring. Records are
+// appended through a write buffer and flushed with one pwrite per buffer;
+// when the ring wraps, the oldest records are dropped from the index before
+// their bytes are overwritten. The index maps a key hash to its newest
+// record, so two keys with colliding hashes shadow each other (a miss, never
+// a wrong value: the stored key is compared on read).
+class FileTier {
+public:
+    FileTier(const filesystem::path& path, size_t capacity_bytes, size_t write_buffer_bytes = 64 * 1024);
+    ~FileTier();
+    FileTier(const FileTier&) = delete;
+    FileTier& operator=(const FileTier&) = delete;
+
+    // False when the record can never fit in the ring
+    bool append(size_t hash_value, span<const byte> key, span<const byte> value);
+    // Copies the value of the record matching hash and key into value_out
+    bool read(size_t hash_value, span<const byte> key, vector<byte>& value_out) const;
+    void erase(size_t hash_value);
+
+    size_t size() const noexcept { return index_.size(); }
+    size_t capacity_bytes() const noexcept { return capacity_; }
+    void flush();
+
+private:
+    struct RecordHeader {
+        uint64_t hash;
+        uint32_t key_size;
+        uint32_t value_size;
+    };
+
+    // hash -> newest record, linear probing with backward-shift erase
+    class OffsetIndex {
+    public:
+        struct Slot {
+            uint64_t hash = 0;
+            uint64_t offset = EMPTY;
+            uint32_t length = 0;
+        };
+        static constexpr uint64_t EMPTY = numeric_limits<uint64_t>::max();
+
+        const Slot* find(uint64_t hash_value) const;
+        void assign(uint64_t hash_value, uint64_t offset, uint32_t length);
+        // Erases hash's slot; with only_offset set, only if it still points there
+        void erase(uint64_t hash_value, uint64_t only_offset = EMPTY);
+        size_t size() const noexcept { return size_; }
+
+    private:
+        vector<Slot> slots_;
+        size_t size_ = 0;
+
+        size_t locate(uint64_t hash_value) const;
+        void grow();
+    };
+
+    struct LogEntry {
+        uint64_t offset;
+        uint64_t hash;
+    };
+
+    filesystem::path path_;
+    int fd_ = -1;
+    size_t capacity_;
+    size_t write_buffer_limit_;
+    // Logical offsets grow forever; physical = logical % capacity_
+    uint64_t head_ = 0;
+    uint64_t buffer_start_ = 0;
+    vector<byte> buffer_;
+    deque<LogEntry> log_;
+    OffsetIndex index_;
+
+    void drop_before(uint64_t logical);
+};
+
+inline FileTier::FileTier(const filesystem::path& path, size_t capacity_bytes, size_t write_buffer_bytes)
+    : path_(path), capacity_(capacity_bytes), write_buffer_limit_(min(write_buffer_bytes, capacity_bytes)) {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) {
+        throw system_error(errno, generic_category(), "FileTier: open " + path_.string());
+    }
+    buffer_.reserve(write_buffer_limit_);
+}
+
+inline FileTier::~FileTier() {
+    ::close(fd_);
+    error_code ignored;
+    filesystem::remove(path_, ignored);
+}
+
+inline void FileTier::flush() {
+    const auto* data = buffer_.data();
+    auto remaining = buffer_.size();
+    auto physical = static_cast<off_t>(buffer_start_ % capacity_);
+    while (remaining > 0) {
+        const auto written = ::pwrite(fd_, data, remaining, physical);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw system_error(errno, generic_category(), "FileTier: pwrite");
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+        physical += written;
+    }
+    buffer_start_ = head_;
+    buffer_.clear();
+}
+
+inline void FileTier::drop_before(uint64_t logical) {
+    while (!log_.empty() && log_.front().offset < logical) {
+        index_.erase(log_.front().hash, log_.front().offset);
+        log_.pop_front();
+    }
+}
+
+inline bool FileTier::append(size_t hash_value, span<const byte> key, span<const byte> value) {
+    const auto length = sizeof(RecordHeader) + key.size() + value.size();
+    if (length > write_buffer_limit_ || length > numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    // Records never straddle the end of the ring or the write buffer
+    if (head_ % capacity_ + length > capacity_) {
+        flush();
+        head_ += capacity_ - head_ % capacity_;
+        buffer_start_ = head_;
+    } else if (buffer_.size() + length > write_buffer_limit_) {
+        flush();
+    }
+
+    // Forget whatever the ring is about to overwrite
+    drop_before(head_ + length > capacity_ ? head_ + length - capacity_ : 0);
+
+    const RecordHeader header{hash_value, static_cast<uint32_t>(key.size()), static_cast<uint32_t>(value.size())};
+    const auto* header_bytes = reinterpret_cast<const byte*>(&header);
+    buffer_.insert(buffer_.end(), header_bytes, header_bytes + sizeof(header));
+    buffer_.insert(buffer_.end(), key.begin(), key.end());
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+
+    index_.assign(hash_value, head_, static_cast<uint32_t>(length));
+    log_.push_back({head_, hash_value});
+    head_ += length;
+    return true;
+}
+
+inline bool FileTier::read(size_t hash_value, span<const byte> key, vector<byte>& value_out) const {
+    const auto* slot = index_.find(hash_value);
+    if (slot == nullptr) {
+        return false;
+    }
+
+    value_out.resize(slot->length);
+    if (slot->offset >= buffer_start_) {
+        // Still in the write buffer
+        const auto* source = buffer_.data() + (slot->offset - buffer_start_);
+        copy(source, source + slot->length, value_out.begin());
+    } else {
+        auto* target = value_out.data();
+        size_t remaining = slot->length;
+        auto physical = static_cast<off_t>(slot->offset % capacity_);
+        while (remaining > 0) {
+            const auto got = ::pread(fd_, target, remaining, physical);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got <= 0) {
+                throw system_error(got < 0 ? errno : EIO, generic_category(), "FileTier: pread");
+            }
+            target += got;
+            remaining -= static_cast<size_t>(got);
+            physical += got;
+        }
+    }
+
+    RecordHeader header;
+    memcpy(&header, value_out.data(), sizeof(header));
+    const auto stored_key = span(value_out).subspan(sizeof(header), header.key_size);
+    if (header.hash != hash_value || !ranges::equal(stored_key, key)) {
+        return false;
+    }
+
+    // Shift the value to the front so value_out holds only the value bytes
+    const auto value_begin = value_out.begin() + static_cast<ptrdiff_t>(sizeof(header) + header.key_size);
+    copy(value_begin, value_begin + header.value_size, value_out.begin());
+    value_out.resize(header.value_size);
+    return true;
+}
+
+inline void FileTier::erase(size_t hash_value) {
+    // The log entry stays until the ring passes it; its index check then fails
+    index_.erase(hash_value);
+}
+
+inline size_t FileTier::OffsetIndex::locate(uint64_t hash_value) const {
+    const auto mask = slots_.size() - 1;
+    auto index = hash_value & mask;
+    while (slots_[index].offset != EMPTY && slots_[index].hash != hash_value) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+inline const FileTier::OffsetIndex::Slot* FileTier::OffsetIndex::find(uint64_t hash_value) const {
+    if (slots_.empty()) {
+        return nullptr;
+    }
+    const auto& slot = slots_[locate(hash_value)];
+    return slot.offset == EMPTY ? nullptr : &slot;
+}
+
+inline void FileTier::OffsetIndex::grow() {
+    auto old = std::move(slots_);
+    slots_.assign(old.empty() ? 64 : old.size() * 2, Slot{});
+    size_ = 0;
+    for (const auto& slot : old) {
+        if (slot.offset != EMPTY) {
+            assign(slot.hash, slot.offset, slot.length);
+        }
+    }
+}
+
+inline void FileTier::OffsetIndex::assign(uint64_t hash_value, uint64_t offset, uint32_t length) {
+    if ((size_ + 1) * 2 > slots_.size()) {
+        grow();
+    }
+    auto& slot = slots_[locate(hash_value)];
+    if (slot.offset == EMPTY) {
+        ++size_;
+    }
+    slot = {hash_value, offset, length};
+}
+
+inline void FileTier::OffsetIndex::erase(uint64_t hash_value, uint64_t only_offset) {
+    if (slots_.empty()) {
+        return;
+    }
+
+    auto hole = locate(hash_value);
+    if (slots_[hole].offset == EMPTY || (only_offset != EMPTY && slots_[hole].offset != only_offset)) {
+        return;
+    }
+
+    const auto mask = slots_.size() - 1;
+    for (auto next = (hole + 1) & mask; slots_[next].offset != EMPTY; next = (next + 1) & mask) {
+        const auto ideal = slots_[next].hash & mask;
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = Slot{};
+    --size_;
+}
+
+// LRUCache in memory with a FileTier catching its evictions. A DRAM miss
+// checks the file tier and promotes a hit back into memory; a set makes
+// any file copy of the key stale.
+template <Hashable K, TierStorable V>
+    requires TierStorable<K>
+class TieredCache {
+public:
+    struct Stats {
+        size_t dram_hits = 0;
+        size_t file_hits = 0;
+        size_t misses = 0;
+        size_t demotions = 0;
+    };
+
+    TieredCache(size_t dram_items, const filesystem::path& file, size_t file_bytes)
+        : dram_(dram_items), file_(file, file_bytes) {
+        dram_.set_eviction_handler([this](K&& key, V&& value) {
+            if (file_.append(hash<K>{}(key), tier_bytes(key), tier_bytes(value))) {
+                ++stats_.demotions;
+            }
+        });
+    }
+
+    // The eviction handler points back at this object
+    TieredCache(const TieredCache&) = delete;
+    TieredCache& operator=(const TieredCache&) = delete;
+
+    V* get(const K& key);
+
+    template <typename KType, typename VType>
+    bool set(KType&& key, VType&& value) {
+        file_.erase(hash<K>{}(key));
+        return dram_.set(std::forward<KType>(key), std::forward<VType>(value));
+    }
+
+    bool has(const K& key) const {
+        if (dram_.has(key)) {
+            return true;
+        }
+        return file_.read(hash<K>{}(key), tier_bytes(key), scratch_);
+    }
+
+    const Stats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = {}; }
+    size_t dram_size() const noexcept { return dram_.size(); }
+    size_t file_size() const noexcept { return file_.size(); }
+
+private:
+    LRUCache<K, V> dram_;
+    FileTier file_;
+    Stats stats_;
+    mutable vector<byte> scratch_;
+};
+
+template <Hashable K, TierStorable V>
+    requires TierStorable<K>
+V* TieredCache<K, V>::get(const K& key) {
+    if (auto* value = dram_.get(key)) {
+        ++stats_.dram_hits;
+        return value;
+    }
+
+    const auto hash_value = hash<K>{}(key);
+    if (!file_.read(hash_value, tier_bytes(key), scratch_)) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    ++stats_.file_hits;
+    file_.erase(hash_value);
+    (void)dram_.set(key, tier_load<V>(scratch_));
+    return dram_.get(key);
+}
+
+#endif
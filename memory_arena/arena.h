@@ -0,0 +1,413 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__APPLE__) || defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace arena {
+
+// ============================================================================
+// Shared Allocation Resources
+// ============================================================================
+//
+// Three std::pmr::memory_resource implementations that every allocating
+// container in the repo accepts (customvector::vector, LRUCache/ARCCache,
+// duan::PartialOrderDS), so a caller can point a whole request's worth of
+// containers at one arena:
+//
+// - MonotonicArena: bump allocation, nothing freed until reset()/release().
+//   reset() keeps the memory, so a request-scoped arena stops calling
+//   upstream once it has seen its largest request.
+// - SizeClassPool: free lists per size class, one set per thread, so
+//   allocate/deallocate of small nodes never takes a lock.
+// - HugePageSlab: one fixed mmap'd region backed by 2 MiB pages where the
+//   OS provides them, as the upstream of the other two for large working
+//   sets whose cost is TLB misses rather than malloc.
+
+inline constexpr size_t MAX_ALIGN = alignof(std::max_align_t);
+
+// ============================================================================
+// Monotonic Arena
+// ============================================================================
+
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t FIRST_BLOCK = 4 * 1024;
+    // Block sizes double up to this; a larger request gets a block of its own
+    static constexpr size_t MAX_BLOCK = 1024 * 1024;
+
+    explicit MonotonicArena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream) {}
+    ~MonotonicArena() override { release(); }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // Forgets every allocation but keeps the memory. If the last round
+    // spilled into several blocks they are merged into one of their total
+    // size, so a repeated workload settles into a single block.
+    void reset();
+
+    // Forgets every allocation and returns all memory upstream
+    void release() noexcept;
+
+    // Bytes handed out since the last reset, and bytes held from upstream
+    [[nodiscard]] size_t bytes_used() const noexcept { return used_; }
+    [[nodiscard]] size_t bytes_reserved() const noexcept { return reserved_; }
+
+private:
+    struct alignas(MAX_ALIGN) Block {
+        Block* next;
+        size_t size;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    Block* blocks_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    size_t next_block_ = FIRST_BLOCK;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        auto* aligned = reinterpret_cast<std::byte*>(
+            (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(uintptr_t{alignment} - 1));
+        if (cursor_ == nullptr || aligned > end_ || bytes > static_cast<size_t>(end_ - aligned)) {
+            add_block(bytes + alignment);
+            aligned = reinterpret_cast<std::byte*>(
+                (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(uintptr_t{alignment} - 1));
+        }
+        cursor_ = aligned + bytes;
+        used_ += bytes;
+        return aligned;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void add_block(size_t at_least) {
+        const size_t size = std::max(next_block_, at_least + sizeof(Block));
+        auto* block = static_cast<Block*>(upstream_->allocate(size, alignof(Block)));
+        block->next = blocks_;
+        block->size = size;
+        blocks_ = block;
+        reserved_ += size;
+        cursor_ = reinterpret_cast<std::byte*>(block + 1);
+        end_ = reinterpret_cast<std::byte*>(block) + size;
+        next_block_ = std::min(next_block_ * 2, MAX_BLOCK);
+    }
+};
+
+inline void MonotonicArena::reset() {
+    used_ = 0;
+    if (blocks_ == nullptr) {
+        return;
+    }
+    if (blocks_->next != nullptr) {
+        const size_t total = reserved_;
+        release();
+        add_block(total - sizeof(Block));
+    }
+    cursor_ = reinterpret_cast<std::byte*>(blocks_ + 1);
+}
+
+inline void MonotonicArena::release() noexcept {
+    while (blocks_ != nullptr) {
+        Block* next = blocks_->next;
+        upstream_->deallocate(blocks_, blocks_->size, alignof(Block));
+        blocks_ = next;
+    }
+    cursor_ = nullptr;
+    end_ = nullptr;
+    next_block_ = FIRST_BLOCK;
+    used_ = 0;
+    reserved_ = 0;
+}
+
+// ============================================================================
+// Size-Class Pool
+// ============================================================================
+//
+// Requests up to MAX_POOLED bytes (alignment up to 16) are rounded to a
+// size class: 16-byte steps up to 256, then powers of two. Each thread
+// owns a cache of per-class free lists and a bump chunk carved from
+// CHUNK-byte upstream allocations, so the fast path is a thread-local
+// lookup and a list pop. A block freed on another thread joins that
+// thread's lists. Caches belong to the pool and are handed to the next
+// thread that gets the same std::thread::id; chunks go back upstream only
+// in release() or the destructor.
+
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t SMALL_LIMIT = 256;
+    static constexpr size_t MAX_POOLED = 16 * 1024;
+    static constexpr size_t CHUNK = 64 * 1024;
+
+    explicit SizeClassPool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream), id_(next_pool_id()) {}
+    ~SizeClassPool() override;
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    // Returns every chunk upstream. No thread may be using the pool.
+    void release() noexcept;
+
+    [[nodiscard]] size_t bytes_reserved() const {
+        std::lock_guard lock(mutex_);
+        return chunks_.size() * CHUNK;
+    }
+
+private:
+    static constexpr size_t SMALL_CLASSES = SMALL_LIMIT / GRANULARITY;
+    static constexpr size_t CLASSES = SMALL_CLASSES + 6;
+    static constexpr size_t MEMO_SLOTS = 4;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct alignas(64) ThreadCache {
+        std::array<FreeNode*, CLASSES> free_lists{};
+        std::byte* cursor = nullptr;
+        std::byte* end = nullptr;
+    };
+
+    struct Memo {
+        uint64_t pool_id = 0;
+        ThreadCache* cache = nullptr;
+    };
+
+    struct LocalMemo {
+        std::array<Memo, MEMO_SLOTS> slots{};
+        size_t next = 0;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    const uint64_t id_;
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::thread::id, ThreadCache*>> caches_;
+    std::vector<void*> chunks_;
+
+    static uint64_t next_pool_id() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static LocalMemo& local_memo() {
+        thread_local LocalMemo memo;
+        return memo;
+    }
+
+    static size_t class_of(size_t bytes) noexcept {
+        if (bytes <= SMALL_LIMIT) {
+            return (std::max<size_t>(bytes, 1) - 1) / GRANULARITY;
+        }
+        return SMALL_CLASSES + std::bit_width(bytes - 1) - std::bit_width(SMALL_LIMIT);
+    }
+
+    static size_t class_size(size_t size_class) noexcept {
+        if (size_class < SMALL_CLASSES) {
+            return (size_class + 1) * GRANULARITY;
+        }
+        return SMALL_LIMIT << (size_class - SMALL_CLASSES + 1);
+    }
+
+    // Pool ids are never reused, so a memo entry for a destroyed pool can
+    // never match a live one
+    ThreadCache& local_cache() {
+        LocalMemo& memo = local_memo();
+        for (const Memo& slot : memo.slots) {
+            if (slot.pool_id == id_) return *slot.cache;
+        }
+        ThreadCache& cache = register_thread();
+        memo.slots[memo.next] = {id_, &cache};
+        memo.next = (memo.next + 1) % MEMO_SLOTS;
+        return cache;
+    }
+
+    ThreadCache& register_thread();
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+inline SizeClassPool::ThreadCache& SizeClassPool::register_thread() {
+    const auto self = std::this_thread::get_id();
+    std::lock_guard lock(mutex_);
+    for (auto& [owner, cache] : caches_) {
+        if (owner == self) return *cache;
+    }
+    caches_.reserve(caches_.size() + 1);
+    auto* cache = new ThreadCache;
+    caches_.emplace_back(self, cache);
+    return *cache;
+}
+
+// Every upstream call, pass-through ones included, is made under mutex_,
+// so an unsynchronized upstream such as HugePageSlab can back the pool
+inline void* SizeClassPool::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes > MAX_POOLED || alignment > GRANULARITY) {
+        std::lock_guard lock(mutex_);
+        return upstream_->allocate(bytes, alignment);
+    }
+    ThreadCache& cache = local_cache();
+    const size_t size_class = class_of(bytes);
+    if (FreeNode* node = cache.free_lists[size_class]) {
+        cache.free_lists[size_class] = node->next;
+        return node;
+    }
+    const size_t rounded = class_size(size_class);
+    if (static_cast<size_t>(cache.end - cache.cursor) < rounded) {
+        std::lock_guard lock(mutex_);
+        chunks_.reserve(chunks_.size() + 1);
+        void* chunk = upstream_->allocate(CHUNK, GRANULARITY);
+        chunks_.push_back(chunk);
+        cache.cursor = static_cast<std::byte*>(chunk);
+        cache.end = cache.cursor + CHUNK;
+    }
+    void* result = cache.cursor;
+    cache.cursor += rounded;
+    return result;
+}
+
+inline void SizeClassPool::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (bytes > MAX_POOLED || alignment > GRANULARITY) {
+        std::lock_guard lock(mutex_);
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+    ThreadCache& cache = local_cache();
+    const size_t size_class = class_of(bytes);
+    auto* node = static_cast<FreeNode*>(p);
+    node->next = cache.free_lists[size_class];
+    cache.free_lists[size_class] = node;
+}
+
+inline void SizeClassPool::release() noexcept {
+    std::lock_guard lock(mutex_);
+    for (void* chunk : chunks_) upstream_->deallocate(chunk, CHUNK, GRANULARITY);
+    chunks_.clear();
+    for (auto& entry : caches_) *entry.second = ThreadCache{};
+}
+
+inline SizeClassPool::~SizeClassPool() {
+    release();
+    for (auto& entry : caches_) delete entry.second;
+}
+
+// ============================================================================
+// Huge-Page Slab
+// ============================================================================
+//
+// A fixed region mapped once and bump-allocated; exhausting it throws
+// std::bad_alloc. On Linux it asks for explicit huge pages (MAP_HUGETLB)
+// and falls back to a 2 MiB-aligned mapping with MADV_HUGEPAGE, which
+// transparent huge pages back when enabled. Not synchronized: share it
+// between threads through a SizeClassPool, which calls upstream under
+// its lock.
+
+class HugePageSlab : public std::pmr::memory_resource {
+public:
+    static constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+    enum class Backing : uint8_t { huge_pages, transparent_huge_pages, normal_pages };
+
+    // capacity is rounded up to a multiple of 2 MiB
+    explicit HugePageSlab(size_t capacity);
+    ~HugePageSlab() override;
+
+    HugePageSlab(const HugePageSlab&) = delete;
+    HugePageSlab& operator=(const HugePageSlab&) = delete;
+
+    // Forgets every allocation; the pages stay mapped
+    void release() noexcept { used_ = 0; }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_t bytes_used() const noexcept { return used_; }
+    [[nodiscard]] Backing backing() const noexcept { return backing_; }
+
+private:
+    std::byte* base_ = nullptr;
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    Backing backing_ = Backing::normal_pages;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        const size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+        if (start > capacity_ || bytes > capacity_ - start) {
+            throw std::bad_alloc();
+        }
+        used_ = start + bytes;
+        return base_ + start;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+inline HugePageSlab::HugePageSlab(size_t capacity)
+    : capacity_((std::max<size_t>(capacity, 1) + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1)) {
+#if defined(__APPLE__) || defined(__linux__)
+#if defined(MAP_HUGETLB)
+    mapping_ = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping_ != MAP_FAILED) {
+        mapping_size_ = capacity_;
+        base_ = static_cast<std::byte*>(mapping_);
+        backing_ = Backing::huge_pages;
+        return;
+    }
+#endif
+    // Over-map by one huge page so the usable range can start on a 2 MiB
+    // boundary, which transparent huge pages need
+    mapping_size_ = capacity_ + HUGE_PAGE;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::bad_alloc();
+    }
+    const auto address = reinterpret_cast<uintptr_t>(mapping_);
+    base_ = reinterpret_cast<std::byte*>((address + HUGE_PAGE - 1) & ~(uintptr_t{HUGE_PAGE} - 1));
+#if defined(MADV_HUGEPAGE)
+    if (madvise(base_, capacity_, MADV_HUGEPAGE) == 0) {
+        backing_ = Backing::transparent_huge_pages;
+    }
+#endif
+#else
+    mapping_size_ = capacity_;
+    mapping_ = ::operator new(capacity_, std::align_val_t{HUGE_PAGE});
+    base_ = static_cast<std::byte*>(mapping_);
+#endif
+}
+
+inline HugePageSlab::~HugePageSlab() {
+#if defined(__APPLE__) || defined(__linux__)
+    munmap(mapping_, mapping_size_);
+#else
+    ::operator delete(mapping_, std::align_val_t{HUGE_PAGE});
+#endif
+}
+
+} // namespace arena
+
+#endif // ARENA_H
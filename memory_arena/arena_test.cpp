@@ -0,0 +1,310 @@
+#include "arena.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace arena;
+
+namespace {
+
+// Upstream that counts the calls reaching it
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t outstanding_bytes = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        outstanding_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        outstanding_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+bool aligned(const void* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("MonotonicArena bumps, aligns and never overlaps", "[arena]") {
+    CountingResource upstream;
+    {
+        MonotonicArena arena(&upstream);
+        std::vector<std::pair<unsigned char*, size_t>> blocks;
+        for (size_t i = 0; i < 2000; ++i) {
+            const size_t bytes = 1 + i % 97;
+            const size_t alignment = size_t{1} << (i % 7);
+            auto* p = static_cast<unsigned char*>(arena.allocate(bytes, alignment));
+            REQUIRE(aligned(p, alignment));
+            std::memset(p, static_cast<int>(i & 0xff), bytes);
+            blocks.emplace_back(p, bytes);
+        }
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            const auto [p, bytes] = blocks[i];
+            for (size_t b = 0; b < bytes; ++b) REQUIRE(p[b] == static_cast<unsigned char>(i & 0xff));
+        }
+        REQUIRE(upstream.allocations > 1);
+        REQUIRE(arena.bytes_reserved() == upstream.outstanding_bytes);
+
+        // Over-sized requests get a block of their own
+        void* big = arena.allocate(4 * MonotonicArena::MAX_BLOCK, 64);
+        REQUIRE(aligned(big, 64));
+        std::memset(big, 0, 4 * MonotonicArena::MAX_BLOCK);
+    }
+    REQUIRE(upstream.outstanding_bytes == 0);
+    REQUIRE(upstream.deallocations == upstream.allocations);
+}
+
+TEST_CASE("MonotonicArena::reset settles into one block", "[arena]") {
+    CountingResource upstream;
+    MonotonicArena arena(&upstream);
+    auto request = [&] {
+        std::pmr::vector<int> values(&arena);
+        std::pmr::map<int, int> index(&arena);
+        for (int i = 0; i < 5000; ++i) {
+            values.push_back(i);
+            index.emplace(i, i * 2);
+        }
+        REQUIRE(index.at(4999) == 9998);
+    };
+
+    request();
+    const size_t first_round = upstream.allocations;
+    REQUIRE(first_round > 1);
+    arena.reset();
+    REQUIRE(arena.bytes_used() == 0);
+    REQUIRE(upstream.outstanding_bytes == arena.bytes_reserved());
+
+    const size_t after_merge = upstream.allocations;
+    for (int round = 0; round < 5; ++round) {
+        request();
+        arena.reset();
+    }
+    REQUIRE(upstream.allocations == after_merge);
+
+    arena.release();
+    REQUIRE(arena.bytes_reserved() == 0);
+    REQUIRE(upstream.outstanding_bytes == 0);
+}
+
+TEST_CASE("SizeClassPool reuses freed blocks per class", "[arena]") {
+    CountingResource upstream;
+    {
+        SizeClassPool pool(&upstream);
+        void* a = pool.allocate(24, 8);
+        void* b = pool.allocate(32, 8);
+        REQUIRE(a != b);
+        REQUIRE(aligned(a, 16));
+        pool.deallocate(a, 24, 8);
+        // 17..32 bytes share a class
+        REQUIRE(pool.allocate(20, 4) == a);
+        REQUIRE(upstream.allocations == 1);
+
+        // Larger than MAX_POOLED or over-aligned goes straight upstream
+        void* big = pool.allocate(SizeClassPool::MAX_POOLED + 1, 8);
+        void* wide = pool.allocate(64, 64);
+        REQUIRE(aligned(wide, 64));
+        REQUIRE(upstream.allocations == 3);
+        pool.deallocate(big, SizeClassPool::MAX_POOLED + 1, 8);
+        pool.deallocate(wide, 64, 64);
+        REQUIRE(upstream.deallocations == 2);
+
+        std::pmr::list<std::string> names(&pool);
+        for (int i = 0; i < 10'000; ++i) names.push_back("name-" + std::to_string(i));
+        names.remove_if([](const std::string& s) { return s.back() % 2 == 0; });
+        REQUIRE(names.size() == 5000);
+        REQUIRE(pool.bytes_reserved() % SizeClassPool::CHUNK == 0);
+    }
+    REQUIRE(upstream.outstanding_bytes == 0);
+}
+
+TEST_CASE("SizeClassPool gives each thread its own lists", "[arena]") {
+    SizeClassPool pool;
+    constexpr size_t kThreads = 4;
+    constexpr size_t kRounds = 20'000;
+
+    std::atomic<size_t> corrupted{0};
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::pair<uint64_t*, size_t>>> handoff(kThreads);
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<std::pair<uint64_t*, size_t>> live;
+            for (size_t i = 0; i < kRounds; ++i) {
+                const size_t words = 1 + (i * 7 + t) % 40;
+                auto* p = static_cast<uint64_t*>(pool.allocate(words * 8, 8));
+                for (size_t w = 0; w < words; ++w) p[w] = t << 32 | i;
+                live.emplace_back(p, words);
+                if (i % 3 == 2) {
+                    const auto [q, n] = live[live.size() / 2];
+                    for (size_t w = 0; w < n; ++w) {
+                        if (q[w] >> 32 != t) corrupted.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    pool.deallocate(q, n * 8, 8);
+                    live[live.size() / 2] = live.back();
+                    live.pop_back();
+                }
+            }
+            for (const auto& [p, n] : live) {
+                for (size_t w = 0; w < n; ++w) {
+                    if (p[w] >> 32 != t) corrupted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            // Hand a few blocks to the main thread to free there
+            for (size_t i = 0; i < 100; ++i) handoff[t].push_back(live[i]);
+            for (size_t i = 100; i < live.size(); ++i) pool.deallocate(live[i].first, live[i].second * 8, 8);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    REQUIRE(corrupted.load() == 0);
+    for (auto& blocks : handoff) {
+        for (const auto& [p, n] : blocks) pool.deallocate(p, n * 8, 8);
+    }
+    const auto [last, words] = handoff.back().back();
+    REQUIRE(pool.allocate(words * 8, 8) == last);
+}
+
+TEST_CASE("HugePageSlab maps whole huge pages", "[arena]") {
+    HugePageSlab slab(3 * 1024 * 1024);
+    REQUIRE(slab.capacity() == 2 * HugePageSlab::HUGE_PAGE);
+    INFO("backing " << static_cast<int>(slab.backing()));
+
+    void* first = slab.allocate(100, 8);
+    REQUIRE(aligned(first, HugePageSlab::HUGE_PAGE));
+    void* second = slab.allocate(8, 4096);
+    REQUIRE(aligned(second, 4096));
+    std::memset(second, 0xab, 8);
+    REQUIRE(slab.bytes_used() == 4096 + 8);
+
+    REQUIRE_THROWS_AS(slab.allocate(slab.capacity(), 8), std::bad_alloc);
+    slab.release();
+    REQUIRE(slab.allocate(slab.capacity(), 8) == first);
+
+    // As upstream of the other resources
+    slab.release();
+    MonotonicArena arena(&slab);
+    std::pmr::vector<uint64_t> values(1000, 7, &arena);
+    REQUIRE(values[999] == 7);
+    REQUIRE(slab.bytes_used() >= MonotonicArena::FIRST_BLOCK);
+}
+
+TEST_CASE("SizeClassPool serializes pass-through requests to a HugePageSlab", "[arena]") {
+    // Large and over-aligned requests bypass the thread caches; the slab
+    // behind them is unsynchronized, so the pool must lock around them
+    HugePageSlab slab(64 * 1024 * 1024);
+    SizeClassPool pool(&slab);
+    constexpr size_t kThreads = 4;
+    constexpr size_t kRounds = 200;
+    constexpr size_t kLarge = SizeClassPool::MAX_POOLED + 4096;
+
+    struct Block {
+        std::byte* p;
+        size_t bytes;
+        size_t alignment;
+    };
+    std::vector<std::vector<Block>> blocks(kThreads);
+    std::atomic<size_t> corrupted{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kRounds; ++i) {
+                const bool large = i % 2 == 0;
+                const size_t bytes = large ? kLarge : 64;
+                const size_t alignment = large ? 16 : 128;
+                auto* p = static_cast<std::byte*>(pool.allocate(bytes, alignment));
+                if (!aligned(p, alignment)) corrupted.fetch_add(1, std::memory_order_relaxed);
+                std::memset(p, static_cast<int>(t + 1), bytes);
+                blocks[t].push_back({p, bytes, alignment});
+                if (i % 10 == 9) {
+                    const Block freed = blocks[t][blocks[t].size() - 2];
+                    blocks[t].erase(blocks[t].end() - 2);
+                    pool.deallocate(freed.p, freed.bytes, freed.alignment);
+                }
+            }
+            for (const Block& block : blocks[t]) {
+                for (size_t b = 0; b < block.bytes; ++b) {
+                    if (block.p[b] != static_cast<std::byte>(t + 1)) {
+                        corrupted.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    REQUIRE(corrupted.load() == 0);
+
+    // The slab never frees, so no two live blocks may overlap
+    std::vector<Block> all;
+    for (const auto& list : blocks) all.insert(all.end(), list.begin(), list.end());
+    std::sort(all.begin(), all.end(), [](const Block& a, const Block& b) { return a.p < b.p; });
+    for (size_t i = 1; i < all.size(); ++i) {
+        REQUIRE(all[i - 1].p + all[i - 1].bytes <= all[i].p);
+    }
+    for (const Block& block : all) pool.deallocate(block.p, block.bytes, block.alignment);
+}
+
+TEST_CASE("Allocation cost by resource", "[benchmark]") {
+    constexpr size_t kOps = 8'000'000;
+    constexpr size_t kBatch = 256;
+
+    auto ns_per = [](auto start) {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kOps;
+    };
+    // Allocate a batch of mixed small nodes, then free it; what a container
+    // of short-lived nodes does per request
+    auto run = [&](std::pmr::memory_resource& resource, auto&& after_batch) {
+        std::vector<std::pair<void*, size_t>> batch(kBatch);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t done = 0; done < kOps; done += kBatch) {
+            for (size_t i = 0; i < kBatch; ++i) {
+                const size_t bytes = 16 + (i * 24) % 112;
+                batch[i] = {resource.allocate(bytes, 8), bytes};
+                static_cast<volatile char*>(batch[i].first)[0] = 1;
+            }
+            for (auto& [p, bytes] : batch) resource.deallocate(p, bytes, 8);
+            after_batch();
+        }
+        return ns_per(start);
+    };
+    auto nothing = [] {};
+
+    const double heap_ns = run(*std::pmr::new_delete_resource(), nothing);
+    std::pmr::unsynchronized_pool_resource std_pool;
+    const double std_pool_ns = run(std_pool, nothing);
+    std::pmr::synchronized_pool_resource std_sync_pool;
+    const double std_sync_ns = run(std_sync_pool, nothing);
+    SizeClassPool pool;
+    const double pool_ns = run(pool, nothing);
+    MonotonicArena arena;
+    const double arena_ns = run(arena, [&] { arena.reset(); });
+    HugePageSlab slab(64 * 1024 * 1024);
+    MonotonicArena slab_arena(&slab);
+    const double slab_ns = run(slab_arena, [&] { slab_arena.reset(); });
+
+    std::cout << "\nAllocate + free of 16-128 byte blocks in batches of " << kBatch << " (ns per block)\n"
+              << std::fixed << std::setprecision(1);
+    std::cout << "  new/delete                           " << std::setw(8) << heap_ns << "\n";
+    std::cout << "  std::pmr::unsynchronized_pool        " << std::setw(8) << std_pool_ns << "\n";
+    std::cout << "  std::pmr::synchronized_pool          " << std::setw(8) << std_sync_ns << "\n";
+    std::cout << "  SizeClassPool (thread-safe)          " << std::setw(8) << pool_ns << "\n";
+    std::cout << "  MonotonicArena, reset per batch      " << std::setw(8) << arena_ns << "\n";
+    std::cout << "  MonotonicArena on HugePageSlab       " << std::setw(8) << slab_ns << "\n";
+}
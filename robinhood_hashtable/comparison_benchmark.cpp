@@ -1,18 +1,29 @@
 #include "robin_hood.h"
+#include "concurrent_robin_hood.h"
+#include "flat_map.hpp"
+#include "intern.h"
+#include "topology.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <numeric>
 #include <random>
+#include <span>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Platform-specific includes
@@ -272,12 +283,14 @@ public:
     }
 
     static void flush_caches() {
-        constexpr size_t FLUSH_BUFFER_SIZE = 32 * 1024 * 1024;
+        // Twice the LLC, so every level is evicted on the larger server parts
+        static const size_t FLUSH_BUFFER_SIZE = std::max<size_t>(32 * 1024 * 1024, 2 * topology::host().llc_size);
+        static const size_t stride = topology::host().cache_line_size;
         static std::vector<uint8_t> flush_buffer(FLUSH_BUFFER_SIZE);
         volatile uint8_t sink = 0;
-        for (size_t i = 0; i < FLUSH_BUFFER_SIZE; i += 64) {
+        for (size_t i = 0; i < FLUSH_BUFFER_SIZE; i += stride) {
             flush_buffer[i] = static_cast<uint8_t>(i);
-            sink += flush_buffer[i];
+            sink = sink + flush_buffer[i];
         }
         (void)sink;
         memory_barrier();
@@ -461,6 +474,179 @@ BenchResult benchmark_std(const std::vector<uint64_t>& keys, double load_factor,
         [](auto& t, uint64_t k, uint64_t v) { t[k] = v; }, cfg);
 }
 
+template<size_t Cap>
+BenchResult benchmark_robin_hood_set(const std::vector<uint64_t>& keys, double load_factor, const BenchConfig& cfg) {
+    RobinHoodSet<uint64_t, Cap> set;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys && i < keys.size(); ++i) (void)set.insert(keys[i]);
+    return run_benchmark(set, keys, num_keys,
+        [](auto& s, uint64_t k) { escape_sink = s.contains(k) ? &s : nullptr; },
+        [](auto& s, uint64_t k, uint64_t) { (void)s.insert(k); }, cfg);
+}
+
+// The set idiom the dedicated RobinHoodSet replaces
+template<size_t Cap>
+BenchResult benchmark_robin_hood_as_set(const std::vector<uint64_t>& keys, double load_factor, const BenchConfig& cfg) {
+    RobinHoodTable<uint64_t, uint8_t, Cap> table;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys && i < keys.size(); ++i) (void)table.put(keys[i], 1);
+    return run_benchmark(table, keys, num_keys,
+        [](auto& t, uint64_t k) { escape_sink = t.get(k); },
+        [](auto& t, uint64_t k, uint64_t) { (void)t.put(k, 1); }, cfg);
+}
+
+BenchResult benchmark_std_set(const std::vector<uint64_t>& keys, double load_factor, const BenchConfig& cfg) {
+    std::unordered_set<uint64_t> set;
+    set.reserve(CAPACITY);
+    size_t num_keys = static_cast<size_t>(load_factor * CAPACITY);
+    for (size_t i = 0; i < num_keys && i < keys.size(); ++i) set.insert(keys[i]);
+    return run_benchmark(set, keys, num_keys,
+        [](auto& s, uint64_t k) { escape_sink = s.contains(k) ? &s : nullptr; },
+        [](auto& s, uint64_t k, uint64_t) { s.insert(k); }, cfg);
+}
+
+static constexpr size_t VALUES_PER_KEY = 4;
+
+// Sums every value of a key so the whole run (or vector) is read
+template<size_t Cap>
+BenchResult benchmark_multimap(const std::vector<uint64_t>& keys, size_t num_keys, const BenchConfig& cfg) {
+    RobinHoodMultiMap<uint64_t, uint64_t, Cap> table;
+    for (size_t i = 0; i < num_keys; ++i) {
+        for (size_t v = 0; v < VALUES_PER_KEY; ++v) (void)table.insert(keys[i], keys[i] + v);
+    }
+    static uint64_t sum;
+    return run_benchmark(table, keys, num_keys,
+        [](auto& t, uint64_t k) { for (uint64_t v : t.equal_range(k)) sum += v; escape_sink = &sum; },
+        [](auto&, uint64_t, uint64_t) {}, cfg);
+}
+
+BenchResult benchmark_map_of_vectors(const std::vector<uint64_t>& keys, size_t num_keys, const BenchConfig& cfg) {
+    std::unordered_map<uint64_t, std::vector<uint64_t>> table;
+    table.reserve(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+        for (size_t v = 0; v < VALUES_PER_KEY; ++v) table[keys[i]].push_back(keys[i] + v);
+    }
+    static uint64_t sum;
+    return run_benchmark(table, keys, num_keys,
+        [](auto& t, uint64_t k) {
+            auto it = t.find(k);
+            if (it != t.end()) for (uint64_t v : it->second) sum += v;
+            escape_sink = &sum;
+        },
+        [](auto&, uint64_t, uint64_t) {}, cfg);
+}
+
+BenchResult benchmark_perfect_hash(const PerfectHashTable<uint64_t, uint64_t>& table, const std::vector<uint64_t>& keys,
+                                   size_t num_keys, const BenchConfig& cfg) {
+    return run_benchmark(table, keys, num_keys,
+        [](const auto& t, uint64_t k) { escape_sink = t.get(k); },
+        [](const auto&, uint64_t, uint64_t) {}, cfg);
+}
+
+// Each lookup pins and unpins, as a reader taking one value at a time would
+template<size_t Cap>
+BenchResult benchmark_concurrent_robin_hood(const std::vector<uint64_t>& keys, double load_factor, const BenchConfig& cfg) {
+    ConcurrentRobinHoodTable<uint64_t, uint64_t, Cap> table;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys && i < keys.size(); ++i) (void)table.put(keys[i], keys[i]);
+    return run_benchmark(table, keys, num_keys,
+        [](auto& t, uint64_t k) { auto guard = t.pin(); escape_sink = t.get(k, guard); },
+        [](auto& t, uint64_t k, uint64_t v) { (void)t.put(k, v); }, cfg);
+}
+
+BenchResult benchmark_flat_map(const std::vector<uint64_t>& keys, size_t num_keys, const BenchConfig& cfg) {
+    customvector::vector<uint64_t> map_keys, map_values;
+    for (size_t i = 0; i < num_keys; ++i) {
+        map_keys.push_back(keys[i]);
+        map_values.push_back(keys[i]);
+    }
+    customvector::flat_map<uint64_t, uint64_t> map(std::move(map_keys), std::move(map_values));
+    return run_benchmark(map, keys, num_keys,
+        [](auto& m, uint64_t k) { escape_sink = m.find(k); },
+        [](auto& m, uint64_t k, uint64_t v) { m.insert_or_assign(k, v); }, cfg);
+}
+
+BenchResult benchmark_std_map(const std::vector<uint64_t>& keys, size_t num_keys, const BenchConfig& cfg) {
+    std::map<uint64_t, uint64_t> map;
+    for (size_t i = 0; i < num_keys; ++i) map[keys[i]] = keys[i];
+    return run_benchmark(map, keys, num_keys,
+        [](auto& m, uint64_t k) { auto it = m.find(k); escape_sink = (it != m.end()) ? &it->second : nullptr; },
+        [](auto& m, uint64_t k, uint64_t v) { m[k] = v; }, cfg);
+}
+
+// Tables keyed by text. The harness keys are indices into texts and
+// symbols, so both tables pay the same indirection per operation.
+template<size_t Cap>
+BenchResult benchmark_string_keys(const std::vector<std::string>& texts, const std::vector<uint64_t>& indices,
+                                  double load_factor, const BenchConfig& cfg) {
+    RobinHoodTable<std::string, uint64_t, Cap> table;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys; ++i) (void)table.put(texts[i], i);
+    return run_benchmark(table, indices, num_keys,
+        [&texts](auto& t, uint64_t k) { escape_sink = t.get(texts[k]); },
+        [&texts](auto& t, uint64_t k, uint64_t v) { (void)t.put(texts[k], v); }, cfg);
+}
+
+// Interned keys: std::hash<Symbol> is the stored hash and equality is a
+// pointer compare, so the text is never read
+template<size_t Cap>
+BenchResult benchmark_symbol_keys(const std::vector<intern::Symbol>& symbols, const std::vector<uint64_t>& indices,
+                                  double load_factor, const BenchConfig& cfg) {
+    RobinHoodTable<intern::Symbol, uint64_t, Cap> table;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys; ++i) (void)table.put(symbols[i], i);
+    return run_benchmark(table, indices, num_keys,
+        [&symbols](auto& t, uint64_t k) { escape_sink = t.get(symbols[k]); },
+        [&symbols](auto& t, uint64_t k, uint64_t v) { (void)t.put(symbols[k], v); }, cfg);
+}
+
+// Text arriving at the table: intern it (a lock-free hit in the pool), then
+// look the symbol up
+template<size_t Cap>
+BenchResult benchmark_intern_then_get(intern::Pool& pool, const std::vector<std::string>& texts,
+                                      const std::vector<uint64_t>& indices, double load_factor, const BenchConfig& cfg) {
+    RobinHoodTable<intern::Symbol, uint64_t, Cap> table;
+    size_t num_keys = static_cast<size_t>(load_factor * Cap);
+    for (size_t i = 0; i < num_keys; ++i) (void)table.put(pool.intern(texts[i]), i);
+    return run_benchmark(table, indices, num_keys,
+        [&](auto& t, uint64_t k) { escape_sink = t.get(pool.intern(texts[k])); },
+        [&](auto& t, uint64_t k, uint64_t v) { (void)t.put(pool.intern(texts[k]), v); }, cfg);
+}
+
+// Tables far past the LLC, where every lookup misses to DRAM and only
+// overlapping the misses helps
+static constexpr size_t BATCH_CAPACITY = size_t{1} << 22;
+static constexpr double BATCH_LOAD_FACTOR = 0.70;
+static constexpr size_t BATCH_SIZE = 64;
+
+// Looks up `lookups` random resident keys in batches of BATCH_SIZE through
+// batch_get(keys, out, distance); returns the callable calibrate_prefetch_distance takes
+template<typename BatchGet>
+auto make_batched_run(const std::vector<uint64_t>& probes, BatchGet batch_get) {
+    return [&probes, batch_get](size_t distance) mutable {
+        std::array<const uint64_t*, BATCH_SIZE> out;
+        size_t found = 0;
+        for (size_t i = 0; i + BATCH_SIZE <= probes.size(); i += BATCH_SIZE) {
+            found += batch_get(std::span<const uint64_t>(probes.data() + i, BATCH_SIZE), std::span(out), distance);
+        }
+        escape_sink = found ? out.back() : nullptr;
+    };
+}
+
+// Median ns per lookup over five runs
+template<typename Run>
+double time_batched(Run& run, size_t distance, size_t lookups) {
+    std::array<double, 5> ns;
+    run(distance);
+    for (double& sample : ns) {
+        const auto start = std::chrono::steady_clock::now();
+        run(distance);
+        sample = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / lookups;
+    }
+    std::nth_element(ns.begin(), ns.begin() + 2, ns.end());
+    return ns[2];
+}
+
 void print_result_header() {
     std::cout << std::left << std::setw(20) << "Table" << std::right
               << std::setw(8) << "min" << std::setw(8) << "p50" << std::setw(8) << "p90" << std::setw(8) << "p95"
@@ -480,7 +666,13 @@ int main() {
     std::cout << std::string(100, '=') << "\n  RESEARCH-GRADE HFT HASH TABLE BENCHMARK\n" << std::string(100, '=') << "\n\n";
 
     timing::CycleTimer::calibrate();
-    std::cout << "Environment:\n  Timer resolution:  " << std::fixed << std::setprecision(2) << timing::CycleTimer::resolution_ns() << " ns\n\n";
+    const topology::Topology& machine = topology::host();
+    std::cout << "Environment:\n  Timer resolution:  " << std::fixed << std::setprecision(2) << timing::CycleTimer::resolution_ns() << " ns\n"
+              << "  Caches:            L1d " << (machine.l1d_size >> 10) << " KiB, L2 " << (machine.l2_size >> 10)
+              << " KiB, LLC " << (machine.llc_size >> 20) << " MiB, " << machine.cache_line_size << "-byte lines\n"
+              << "  CPUs:              " << machine.logical_cpus << " logical, " << machine.numa_nodes << " NUMA node(s)\n"
+              << "  Build constants:   cache line " << DEFAULT_CACHE_LINE_SIZE << ", prefetch distance "
+              << DEFAULT_PREFETCH_DISTANCE << "\n\n";
 
     BenchConfig cfg;
     cfg.ops_per_trial = 1000000;
@@ -517,5 +709,198 @@ int main() {
         print_result_row("std::unordered_map", std_agg.mean);
         std::cout << "\n";
     }
+
+    // Start-of-day symbol universe: every key known up front, lookups only
+    constexpr double STATIC_LOAD_FACTOR = 0.90;
+    const size_t static_keys = static_cast<size_t>(STATIC_LOAD_FACTOR * CAPACITY);
+    const std::vector<uint64_t> static_symbols(keys.begin(), keys.begin() + static_keys);
+    auto build_start = std::chrono::steady_clock::now();
+    auto perfect = build_static(static_symbols, static_symbols);  // each symbol maps to itself
+    auto build_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - build_start).count();
+    if (!perfect) {
+        std::cerr << "build_static failed\n";
+        return 1;
+    }
+    for (size_t i = 0; i < static_keys; ++i) {
+        const uint64_t* found = perfect->get(keys[i]);
+        if (found == nullptr || *found != keys[i]) {
+            std::cerr << "build_static lost key " << keys[i] << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << std::string(95, '=') << "\nStatic key set: " << static_keys << " keys, 100% lookups (build_static took "
+              << build_us << " us)\n" << std::string(95, '=') << "\n\n";
+    BenchConfig read_cfg = cfg;
+    read_cfg.read_percent = 100;
+    std::vector<BenchResult> robin_trials, perfect_trials, std_trials;
+    for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+        std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+        robin_trials.push_back(benchmark_robin_hood<CAPACITY>(keys, STATIC_LOAD_FACTOR, read_cfg));
+        perfect_trials.push_back(benchmark_perfect_hash(*perfect, keys, static_keys, read_cfg));
+        std_trials.push_back(benchmark_std(keys, STATIC_LOAD_FACTOR, read_cfg));
+    }
+    std::cout << std::string(30, ' ') << "\r";
+    print_result_header();
+    print_result_row("RobinHoodTable", aggregate_trials(robin_trials).mean);
+    print_result_row("PerfectHashTable", aggregate_trials(perfect_trials).mean);
+    print_result_row("std::unordered_map", aggregate_trials(std_trials).mean);
+    std::cout << "\n";
+
+    std::cout << std::string(95, '=') << "\nSet membership (bucket bytes: RobinHoodSet "
+              << sizeof(RobinHoodSet<uint64_t, CAPACITY>) / CAPACITY << ", RobinHoodTable<uint64_t, uint8_t> "
+              << sizeof(RobinHoodTable<uint64_t, uint8_t, CAPACITY>) / CAPACITY << ")\n"
+              << std::string(95, '=') << "\n\n";
+    for (double lf : LOAD_FACTORS) {
+        std::cout << "Load Factor: " << static_cast<int>(lf * 100) << "%\n";
+        std::vector<BenchResult> set_trials, table_trials, std_set_trials;
+        for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+            std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+            set_trials.push_back(benchmark_robin_hood_set<CAPACITY>(keys, lf, cfg));
+            table_trials.push_back(benchmark_robin_hood_as_set<CAPACITY>(keys, lf, cfg));
+            std_set_trials.push_back(benchmark_std_set(keys, lf, cfg));
+        }
+        std::cout << std::string(30, ' ') << "\r";
+        print_result_header();
+        print_result_row("RobinHoodSet", aggregate_trials(set_trials).mean);
+        print_result_row("Table<K, uint8_t>", aggregate_trials(table_trials).mean);
+        print_result_row("std::unordered_set", aggregate_trials(std_set_trials).mean);
+        std::cout << "\n";
+    }
+
+    const size_t multi_keys = CAPACITY * 7 / 10 / VALUES_PER_KEY;
+    std::cout << std::string(95, '=') << "\nMultimap: " << multi_keys << " keys x " << VALUES_PER_KEY
+              << " values, lookups read every value\n" << std::string(95, '=') << "\n\n";
+    std::vector<BenchResult> multi_trials, vector_trials;
+    for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+        std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+        multi_trials.push_back(benchmark_multimap<CAPACITY>(keys, multi_keys, read_cfg));
+        vector_trials.push_back(benchmark_map_of_vectors(keys, multi_keys, read_cfg));
+    }
+    std::cout << std::string(30, ' ') << "\r";
+    print_result_header();
+    print_result_row("RobinHoodMultiMap", aggregate_trials(multi_trials).mean);
+    print_result_row("map<K, vector<V>>", aggregate_trials(vector_trials).mean);
+    std::cout << "\n";
+
+    constexpr double CONCURRENT_LOAD_FACTOR = 0.85;
+    std::cout << std::string(95, '=') << "\nEpoch-guarded reads: ConcurrentRobinHoodTable vs RobinHoodTable, "
+              << static_cast<int>(CONCURRENT_LOAD_FACTOR * 100) << "% load, one thread\n"
+              << std::string(95, '=') << "\n\n";
+    for (const BenchConfig* mix : {&read_cfg, &cfg}) {
+        std::cout << mix->read_percent << "% reads" << (mix->read_percent < 100 ? " (writes replace and retire a node)" : "")
+                  << "\n";
+        std::vector<BenchResult> plain_trials, guarded_trials;
+        for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+            std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+            plain_trials.push_back(benchmark_robin_hood<CAPACITY>(keys, CONCURRENT_LOAD_FACTOR, *mix));
+            guarded_trials.push_back(benchmark_concurrent_robin_hood<CAPACITY>(keys, CONCURRENT_LOAD_FACTOR, *mix));
+        }
+        std::cout << std::string(30, ' ') << "\r";
+        print_result_header();
+        print_result_row("RobinHoodTable", aggregate_trials(plain_trials).mean);
+        print_result_row("Concurrent + pin", aggregate_trials(guarded_trials).mean);
+        std::cout << "\n";
+    }
+
+    // Read-mostly maps small enough that a sorted array is a contender; the
+    // RobinHoodTable keeps its fixed capacity, so its load factor varies
+    constexpr size_t FLAT_SIZES[] = {256, 1024, 4096, 6963};
+    std::cout << std::string(95, '=') << "\nRead-mostly maps: flat_map vs std::map vs RobinHoodTable<" << CAPACITY
+              << ">, " << cfg.read_percent << "% reads (writes assign existing keys)\n"
+              << std::string(95, '=') << "\n\n";
+    for (size_t n : FLAT_SIZES) {
+        std::cout << n << " keys (bytes/key: flat_map " << 2 * sizeof(uint64_t) << ", RobinHoodTable "
+                  << sizeof(RobinHoodTable<uint64_t, uint64_t, CAPACITY>) / n << ")\n";
+        std::vector<BenchResult> flat_trials, map_trials, robin_trials;
+        for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+            std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+            flat_trials.push_back(benchmark_flat_map(keys, n, cfg));
+            map_trials.push_back(benchmark_std_map(keys, n, cfg));
+            robin_trials.push_back(benchmark_robin_hood<CAPACITY>(keys, static_cast<double>(n) / CAPACITY, cfg));
+        }
+        std::cout << std::string(30, ' ') << "\r";
+        print_result_header();
+        print_result_row("flat_map", aggregate_trials(flat_trials).mean);
+        print_result_row("std::map", aggregate_trials(map_trials).mean);
+        print_result_row("RobinHoodTable", aggregate_trials(robin_trials).mean);
+        std::cout << "\n";
+    }
+
+    // Request-path keys longer than the small-string buffer
+    constexpr double STRING_LOAD_FACTOR = 0.70;
+    intern::Pool pool;
+    std::vector<std::string> texts;
+    std::vector<intern::Symbol> symbols;
+    std::vector<uint64_t> indices;
+    size_t heap_bytes = 0;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        texts.push_back("/api/v2/accounts/" + std::to_string(keys[i] % 100000000) + "/positions?view=full");
+        symbols.push_back(pool.intern(texts.back()));
+        indices.push_back(i);
+        heap_bytes += texts.back().capacity() + 1;
+    }
+    std::cout << std::string(95, '=') << "\nString keys vs interned symbols, " << texts[0].size() << "-byte keys, "
+              << static_cast<int>(STRING_LOAD_FACTOR * 100) << "% load\n(bytes/key: std::string bucket "
+              << sizeof(RobinHoodTable<std::string, uint64_t, CAPACITY>) / CAPACITY << " + heap " << heap_bytes / CAPACITY
+              << ", Symbol bucket " << sizeof(RobinHoodTable<intern::Symbol, uint64_t, CAPACITY>) / CAPACITY
+              << " + pool " << pool.memory_bytes() / CAPACITY << ", shared by every table)\n"
+              << std::string(95, '=') << "\n\n";
+    std::vector<BenchResult> string_trials, symbol_trials, intern_trials;
+    for (size_t trial = 0; trial < NUM_TRIALS; ++trial) {
+        std::cout << "Trial " << (trial + 1) << "/" << NUM_TRIALS << "...\r" << std::flush;
+        string_trials.push_back(benchmark_string_keys<CAPACITY>(texts, indices, STRING_LOAD_FACTOR, cfg));
+        symbol_trials.push_back(benchmark_symbol_keys<CAPACITY>(symbols, indices, STRING_LOAD_FACTOR, cfg));
+        intern_trials.push_back(benchmark_intern_then_get<CAPACITY>(pool, texts, indices, STRING_LOAD_FACTOR, cfg));
+    }
+    std::cout << std::string(30, ' ') << "\r";
+    print_result_header();
+    print_result_row("std::string keys", aggregate_trials(string_trials).mean);
+    print_result_row("Symbol keys", aggregate_trials(symbol_trials).mean);
+    print_result_row("intern + Symbol", aggregate_trials(intern_trials).mean);
+    std::cout << "\n";
+
+    const size_t batch_keys = static_cast<size_t>(BATCH_LOAD_FACTOR * BATCH_CAPACITY);
+    auto big_table = std::make_unique<RobinHoodTable<uint64_t, uint64_t, BATCH_CAPACITY>>();
+    auto big_concurrent = std::make_unique<ConcurrentRobinHoodTable<uint64_t, uint64_t, BATCH_CAPACITY>>();
+    std::vector<uint64_t> batch_universe;
+    batch_universe.reserve(batch_keys);
+    for (size_t i = 0; i < batch_keys; ++i) {
+        const uint64_t key = key_generator_rng();
+        batch_universe.push_back(key);
+        (void)big_table->put(key, i);
+        (void)big_concurrent->put(key, i);
+    }
+    std::vector<uint64_t> probes(size_t{1} << 20);
+    for (auto& probe : probes) probe = batch_universe[key_generator_rng() % batch_keys];
+
+    auto plain_run = make_batched_run(probes, [&](std::span<const uint64_t> k, std::span<const uint64_t*> out, size_t d) {
+        return big_table->get_batch(k, out, d);
+    });
+    auto concurrent_run = make_batched_run(probes, [&](std::span<const uint64_t> k, std::span<const uint64_t*> out, size_t d) {
+        auto guard = big_concurrent->pin();
+        return big_concurrent->get_batch(k, out, guard, d);
+    });
+    const auto calibration = topology::calibrate_prefetch_distance(plain_run, probes.size());
+
+    std::cout << std::string(95, '=') << "\nBatched lookups past the LLC: " << batch_keys << " keys in "
+              << BATCH_CAPACITY << " buckets (" << (sizeof(RobinHoodTable<uint64_t, uint64_t, BATCH_CAPACITY>) >> 20)
+              << " MiB), batches of " << BATCH_SIZE << "\n" << std::string(95, '=') << "\n\n";
+    std::cout << "Calibration (ns/lookup by prefetch distance):";
+    for (size_t c = 0; c < calibration.distances.size(); ++c) {
+        std::cout << " " << calibration.distances[c] << ":" << std::setprecision(1) << calibration.ns_by_distance[c];
+    }
+    std::cout << "\n\n" << std::left << std::setw(28) << "Table" << std::right << std::setw(12) << "no prefetch"
+              << std::setw(16) << "default (" + std::to_string(DEFAULT_PREFETCH_DISTANCE) + ")"
+              << std::setw(16) << "calibrated (" + std::to_string(calibration.distance) + ")" << "\n"
+              << std::string(72, '-') << "\n";
+    for (auto [name, run] : {std::pair<const char*, std::function<void(size_t)>>{"RobinHoodTable", plain_run},
+                             {"Concurrent + pin per batch", concurrent_run}}) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::setprecision(1)
+                  << std::setw(12) << time_batched(run, 0, probes.size())
+                  << std::setw(16) << time_batched(run, DEFAULT_PREFETCH_DISTANCE, probes.size())
+                  << std::setw(16) << time_batched(run, calibration.distance, probes.size()) << "\n";
+    }
+    std::cout << "\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+#ifndef CONCURRENT_ROBIN_HOOD_H
+#define CONCURRENT_ROBIN_HOOD_H
+
+#include "robin_hood.h"
+#include "epoch.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace robin_hood {
+
+// ============================================================================
+// Concurrent Robin Hood Table
+// ============================================================================
+//
+// RobinHoodTable for many readers and serialized writers. Slots hold
+// pointers to immutable nodes, so a reader's Value* never changes under it:
+// put on an existing key swaps in a new node and erase unlinks the old one,
+// and either way the old node is retired to the epoch domain rather than
+// deleted. get() takes the caller's Guard as proof of a pin, and the
+// pointer it returns stays valid until that guard is released.
+//
+// Displacement on insert and backward shift on erase move several slots at
+// once, so a reader could walk past a key in transit. Writers bump a
+// sequence counter around those moves (odd while one is in progress) and
+// readers retry a probe that overlapped one; replacing a value is a single
+// pointer store and does not bump it.
+
+template<TableKey Key, TableValue Value, size_t Capacity,
+         size_t CacheLineSize = DEFAULT_CACHE_LINE_SIZE>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+class ConcurrentRobinHoodTable {
+    struct Node {
+        Key key;
+        Value value;
+        size_t home;
+    };
+
+public:
+    static constexpr size_t INDEX_MASK = Capacity - 1;
+
+    explicit ConcurrentRobinHoodTable(epoch::Domain& domain = epoch::default_domain()) : domain_(domain) {}
+
+    // No reader may be inside get() once the table is destroyed
+    ~ConcurrentRobinHoodTable() {
+        for (auto& slot : slots_) delete slot.load(std::memory_order_relaxed);
+    }
+
+    ConcurrentRobinHoodTable(const ConcurrentRobinHoodTable&) = delete;
+    ConcurrentRobinHoodTable& operator=(const ConcurrentRobinHoodTable&) = delete;
+
+    [[nodiscard]] epoch::Guard pin() const { return domain_.pin(); }
+
+    // Same contract as RobinHoodTable::put: true when a new key was added,
+    // false when an existing value was replaced or the table is full
+    [[nodiscard]] bool put(const Key& key, const Value& value);
+
+    [[nodiscard]] bool erase(const Key& key);
+
+    [[nodiscard]] const Value* get(const Key& key, const epoch::Guard&) const noexcept {
+        while (true) {
+            const uint64_t before = version_.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            const Node* node = find_node(key);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_.load(std::memory_order_relaxed) == before) {
+                return node == nullptr ? nullptr : &node->value;
+            }
+        }
+    }
+
+    // RobinHoodTable::get_batch under one guard: the slot of the key
+    // prefetch_distance positions ahead is prefetched. Only the slot; the
+    // node it points to is a second miss, left to the probe itself.
+    size_t get_batch(std::span<const Key> keys, std::span<const Value*> out, const epoch::Guard& guard,
+                     size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE) const noexcept {
+        const size_t count = keys.size();
+        const size_t lead = std::min(prefetch_distance, count);
+        for (size_t i = 0; i < lead; ++i) __builtin_prefetch(&slots_[home_of(keys[i])], 0, 3);
+
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (prefetch_distance != 0 && i + prefetch_distance < count) {
+                __builtin_prefetch(&slots_[home_of(keys[i + prefetch_distance])], 0, 3);
+            }
+            out[i] = get(keys[i], guard);
+            found += out[i] != nullptr;
+        }
+        return found;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    alignas(CacheLineSize) std::array<std::atomic<Node*>, Capacity> slots_{};
+    alignas(CacheLineSize) std::atomic<uint64_t> version_{0};
+    alignas(CacheLineSize) std::mutex write_mutex_;
+    std::atomic<size_t> size_{0};
+    epoch::Domain& domain_;
+
+    static size_t home_of(const Key& key) noexcept {
+        if constexpr (std::is_integral_v<Key>) {
+            return splitmix64_hash(static_cast<uint64_t>(key)) & INDEX_MASK;
+        } else {
+            return std::hash<Key>{}(key) & INDEX_MASK;
+        }
+    }
+
+    static size_t distance_at(const Node* node, size_t idx) noexcept { return (idx - node->home) & INDEX_MASK; }
+
+    // A probe racing a shift may see a torn run; the walk is bounded so the
+    // caller's version check can reject it
+    const Node* find_node(const Key& key) const noexcept {
+        size_t idx = home_of(key);
+        __builtin_prefetch(&slots_[idx], 0, 3);
+        for (size_t distance = 0; distance < Capacity; ++distance) {
+            const Node* node = slots_[idx].load(std::memory_order_acquire);
+            if (node == nullptr || distance > distance_at(node, idx)) {
+                return nullptr;
+            }
+            if (node->key == key) {
+                return node;
+            }
+            idx = (idx + 1) & INDEX_MASK;
+        }
+        return nullptr;
+    }
+
+    size_t find_index(const Key& key) const noexcept {
+        size_t idx = home_of(key);
+        for (size_t distance = 0;; ++distance) {
+            const Node* node = slots_[idx].load(std::memory_order_relaxed);
+            if (node == nullptr || distance > distance_at(node, idx)) return Capacity;
+            if (node->key == key) return idx;
+            idx = (idx + 1) & INDEX_MASK;
+        }
+    }
+
+    void begin_write() noexcept {
+        version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void end_write() noexcept {
+        version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+template<TableKey Key, TableValue Value, size_t Capacity, size_t CacheLineSize>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+bool ConcurrentRobinHoodTable<Key, Value, Capacity, CacheLineSize>::put(const Key& key, const Value& value) {
+    std::lock_guard lock(write_mutex_);
+
+    const size_t home = home_of(key);
+    if (size_t idx = find_index(key); idx != Capacity) {
+        Node* old = slots_[idx].exchange(new Node{key, value, home}, std::memory_order_acq_rel);
+        domain_.retire(old);
+        return false;
+    }
+    if (size_.load(std::memory_order_relaxed) == Capacity) {
+        return false;
+    }
+
+    Node* carried = new Node{key, value, home};
+    size_t idx = home;
+    size_t distance = 0;
+    begin_write();
+    while (true) {
+        Node* resident = slots_[idx].load(std::memory_order_relaxed);
+        if (resident == nullptr) {
+            slots_[idx].store(carried, std::memory_order_release);
+            break;
+        }
+        const size_t resident_distance = distance_at(resident, idx);
+        if (distance > resident_distance) {
+            slots_[idx].store(carried, std::memory_order_release);
+            carried = resident;
+            distance = resident_distance;
+        }
+        idx = (idx + 1) & INDEX_MASK;
+        ++distance;
+    }
+    end_write();
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<TableKey Key, TableValue Value, size_t Capacity, size_t CacheLineSize>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+bool ConcurrentRobinHoodTable<Key, Value, Capacity, CacheLineSize>::erase(const Key& key) {
+    std::lock_guard lock(write_mutex_);
+
+    size_t hole = find_index(key);
+    if (hole == Capacity) {
+        return false;
+    }
+    Node* removed = slots_[hole].load(std::memory_order_relaxed);
+
+    // Backward shift: pull each displaced successor one slot toward home
+    begin_write();
+    while (true) {
+        const size_t next = (hole + 1) & INDEX_MASK;
+        Node* successor = slots_[next].load(std::memory_order_relaxed);
+        if (successor == nullptr || distance_at(successor, next) == 0) {
+            slots_[hole].store(nullptr, std::memory_order_release);
+            break;
+        }
+        slots_[hole].store(successor, std::memory_order_release);
+        hole = next;
+    }
+    end_write();
+
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    domain_.retire(removed);
+    return true;
+}
+
+} // namespace robin_hood
+
+#endif // CONCURRENT_ROBIN_HOOD_H
@@ -1,12 +1,21 @@
 #ifndef ROBIN_HOOD_H
 #define ROBIN_HOOD_H
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "topology.h"
 
 namespace robin_hood {
 
@@ -52,24 +61,148 @@ template<typename T>
 concept TableValue = std::movable<T> && std::copyable<T>;
 
 // ============================================================================
-// Robin Hood Hash Table
+// Robin Hood Probing Core
 // ============================================================================
 
-#if defined(__APPLE__) && defined(__aarch64__)
-inline constexpr size_t DEFAULT_CACHE_LINE_SIZE = 128;
-#else
-inline constexpr size_t DEFAULT_CACHE_LINE_SIZE = 64;
-#endif
+// Build-time values from hardware_topology: the platform default, or what
+// `make configure` there detected and calibrated for this machine
+inline constexpr size_t DEFAULT_CACHE_LINE_SIZE = topology::CACHE_LINE_SIZE;
+inline constexpr size_t DEFAULT_PREFETCH_DISTANCE = topology::PREFETCH_DISTANCE;
+
+inline constexpr uint8_t BUCKET_EMPTY = 0;
+inline constexpr uint8_t BUCKET_OCCUPIED = 1;
+
+// A bucket layout the core can probe: a key plus the state and probe
+// distance bytes. Whatever else the bucket carries (a value, padding) moves
+// with it on displacement.
+template<typename Bucket>
+concept ProbeBucket = std::movable<Bucket> && requires(Bucket bucket) {
+    requires TableKey<decltype(bucket.key)>;
+    { bucket.state } -> std::convertible_to<uint8_t>;
+    { bucket.probe_distance } -> std::convertible_to<uint8_t>;
+};
+
+// Open-addressing storage, hashing, Robin Hood displacement and prefetching
+// shared by RobinHoodTable, RobinHoodSet and RobinHoodMultiMap. The
+// containers define the bucket layout and what a key match means.
+template<ProbeBucket Bucket, size_t Capacity, size_t CacheLineSize>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+class RobinHoodCore {
+public:
+    using Key = decltype(Bucket::key);
+    static constexpr size_t INDEX_MASK = Capacity - 1;
+    static constexpr size_t NOT_FOUND = Capacity;
+    // A probe that runs on prefetches the next line, not the next bucket,
+    // which for small buckets is usually in the line already being read
+    static constexpr size_t PROBE_PREFETCH_STRIDE = std::max<size_t>(1, CacheLineSize / sizeof(Bucket));
+
+    RobinHoodCore() : size_(0) {
+        for (auto& bucket : buckets_) {
+            bucket.state = BUCKET_EMPTY;
+            bucket.probe_distance = 0;
+        }
+    }
+
+    size_t compute_bucket_index(const Key& key) const noexcept {
+        if constexpr (std::is_integral_v<Key>) {
+            return splitmix64_hash(static_cast<uint64_t>(key)) & INDEX_MASK;
+        } else {
+            return std::hash<Key>{}(key) & INDEX_MASK;
+        }
+    }
+
+    // Index of the first bucket holding key, or NOT_FOUND. The walk stops
+    // as soon as the resident's probe distance drops below ours.
+    size_t find_index(const Key& key) const noexcept {
+        size_t idx = compute_bucket_index(key);
+        __builtin_prefetch(&buckets_[idx], 0, 3);
+
+        uint8_t distance = 0;
+        while (buckets_[idx].state == BUCKET_OCCUPIED) {
+            if (distance > buckets_[idx].probe_distance) {
+                return NOT_FOUND;
+            }
+            if (buckets_[idx].key == key) {
+                return idx;
+            }
+            idx = (idx + 1) & INDEX_MASK;
+            if (distance < 255) ++distance;
+
+            __builtin_prefetch(&buckets_[(idx + PROBE_PREFETCH_STRIDE) & INDEX_MASK], 0, 3);
+        }
+        return NOT_FOUND;
+    }
+
+    // Starts loading key's home bucket; batched lookups issue this a few
+    // keys ahead so the misses of consecutive lookups overlap
+    void prefetch_home(const Key& key) const noexcept {
+        __builtin_prefetch(&buckets_[compute_bucket_index(key)], 0, 3);
+    }
+
+    // Inserts a bucket for a key not yet present, starting at its home
+    [[nodiscard]] bool insert_new(Bucket entry) {
+        size_t idx = compute_bucket_index(entry.key);
+        __builtin_prefetch(&buckets_[idx], 1, 3);
+        return displace_from(idx, std::move(entry), 0, false);
+    }
+
+    // Puts entry exactly at idx (probe distance `distance` from its home)
+    // and pushes the resident, if any, further along by the usual rule.
+    // The multimap uses this to keep equal keys adjacent.
+    [[nodiscard]] bool insert_at(size_t idx, Bucket entry, uint8_t distance) {
+        return displace_from(idx, std::move(entry), distance, true);
+    }
+
+    Bucket& bucket(size_t idx) noexcept { return buckets_[idx]; }
+    const Bucket& bucket(size_t idx) const noexcept { return buckets_[idx]; }
+
+    size_t size() const noexcept { return size_; }
+
+private:
+    alignas(CacheLineSize) std::array<Bucket, Capacity> buckets_;
+    size_t size_;
+
+    bool displace_from(size_t idx, Bucket entry, uint8_t distance, bool shifting) {
+        if (size_ == Capacity) {
+            return false;
+        }
+        entry.state = BUCKET_OCCUPIED;
+        while (true) {
+            Bucket& bucket = buckets_[idx];
+
+            if (bucket.state != BUCKET_OCCUPIED) {
+                entry.probe_distance = distance;
+                bucket = std::move(entry);
+                ++size_;
+                return true;
+            }
+
+            // Once an entry is displaced, every later resident moves up one
+            // slot too: the run shifts as a block, so entries keep their
+            // order (the multimap relies on this) instead of the carried
+            // entry skipping past residents with an equal probe distance
+            if (shifting || distance > bucket.probe_distance) {
+                entry.probe_distance = distance;
+                distance = bucket.probe_distance;
+                std::swap(entry, bucket);
+                shifting = true;
+            }
+
+            idx = (idx + 1) & INDEX_MASK;
+            if (distance < 255) ++distance;
+        }
+    }
+};
+
+// ============================================================================
+// Robin Hood Hash Table
+// ============================================================================
 
 template<TableKey Key, TableValue Value, size_t Capacity,
          size_t CacheLineSize = DEFAULT_CACHE_LINE_SIZE>
     requires (Capacity >= 16) && is_power_of_two<Capacity>
 class RobinHoodTable {
 
-    static constexpr size_t INDEX_MASK = Capacity - 1;
-    static constexpr uint8_t BUCKET_EMPTY = 0;
-    static constexpr uint8_t BUCKET_OCCUPIED = 1;
-
     struct TableBucket {
         Key key;
         Value value;
@@ -85,138 +218,434 @@ class RobinHoodTable {
         uint8_t padding[PAD_SIZE > 0 ? PAD_SIZE : 1];
     };
 
-    alignas(CacheLineSize) std::array<TableBucket, Capacity> buckets_;
-    size_t size_;
+    using Core = RobinHoodCore<TableBucket, Capacity, CacheLineSize>;
+    Core core_;
 
-    size_t compute_hash(const Key& key) const noexcept {
-        if constexpr (std::is_integral_v<Key>) {
-            return splitmix64_hash(static_cast<uint64_t>(key));
-        } else {
-            return std::hash<Key>{}(key);
+public:
+    RobinHoodTable() = default;
+
+    RobinHoodTable(const RobinHoodTable&) = delete;
+    RobinHoodTable& operator=(const RobinHoodTable&) = delete;
+    RobinHoodTable(RobinHoodTable&&) = delete;
+    RobinHoodTable& operator=(RobinHoodTable&&) = delete;
+
+    [[nodiscard]] bool put(const Key& key, const Value& value) {
+        size_t idx = core_.find_index(key);
+        if (idx != Core::NOT_FOUND) {
+            core_.bucket(idx).value = value;
+            return false;
         }
+        TableBucket entry{};
+        entry.key = key;
+        entry.value = value;
+        return core_.insert_new(std::move(entry));
     }
 
-    size_t compute_bucket_index(const Key& key) const noexcept {
-        return compute_hash(key) & INDEX_MASK;
+    [[nodiscard]] Value* get(const Key& key) noexcept {
+        size_t idx = core_.find_index(key);
+        return idx == Core::NOT_FOUND ? nullptr : &core_.bucket(idx).value;
     }
 
-    bool insert_with_displacement(size_t idx, Key key, Value value, uint8_t distance) {
-        size_t iterations = 0;
-        while (iterations < Capacity) {
-            TableBucket& bucket = buckets_[idx];
-
-            if (bucket.state != BUCKET_OCCUPIED) {
-                bucket.key = key;
-                bucket.value = value;
-                bucket.state = BUCKET_OCCUPIED;
-                bucket.probe_distance = distance;
-                return true;
-            }
+    [[nodiscard]] const Value* get(const Key& key) const noexcept {
+        size_t idx = core_.find_index(key);
+        return idx == Core::NOT_FOUND ? nullptr : &core_.bucket(idx).value;
+    }
 
-            if (distance > bucket.probe_distance) {
-                std::swap(key, bucket.key);
-                std::swap(value, bucket.value);
-                std::swap(distance, bucket.probe_distance);
+    // Looks up every key, writing its value's address (or nullptr) to the
+    // same position of out, which must be at least as long as keys. The home
+    // bucket of the key prefetch_distance positions ahead is prefetched;
+    // 0 turns that off. Returns how many keys were found.
+    size_t get_batch(std::span<const Key> keys, std::span<const Value*> out,
+                     size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE) const noexcept {
+        const size_t count = keys.size();
+        const size_t lead = std::min(prefetch_distance, count);
+        for (size_t i = 0; i < lead; ++i) core_.prefetch_home(keys[i]);
+
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (prefetch_distance != 0 && i + prefetch_distance < count) {
+                core_.prefetch_home(keys[i + prefetch_distance]);
             }
-
-            idx = (idx + 1) & INDEX_MASK;
-            if (distance < 255) ++distance;
-            ++iterations;
+            out[i] = get(keys[i]);
+            found += out[i] != nullptr;
         }
-        return false;
+        return found;
     }
 
+    [[nodiscard]] size_t size() const noexcept { return core_.size(); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+    [[nodiscard]] static constexpr size_t cache_line_size() noexcept { return CacheLineSize; }
+};
+
+// ============================================================================
+// Robin Hood Set
+// ============================================================================
+
+// Key-only table: buckets hold the key and the two probe bytes, unpadded,
+// so a uint64_t set packs four buckets per 64-byte line
+template<TableKey Key, size_t Capacity, size_t CacheLineSize = DEFAULT_CACHE_LINE_SIZE>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+class RobinHoodSet {
+
+    struct SetBucket {
+        Key key;
+        uint8_t state;
+        uint8_t probe_distance;
+    };
+
+    using Core = RobinHoodCore<SetBucket, Capacity, CacheLineSize>;
+    Core core_;
+
 public:
-    RobinHoodTable() : size_(0) {
-        for (auto& bucket : buckets_) {
-            bucket.state = BUCKET_EMPTY;
-            bucket.probe_distance = 0;
+    RobinHoodSet() = default;
+
+    RobinHoodSet(const RobinHoodSet&) = delete;
+    RobinHoodSet& operator=(const RobinHoodSet&) = delete;
+    RobinHoodSet(RobinHoodSet&&) = delete;
+    RobinHoodSet& operator=(RobinHoodSet&&) = delete;
+
+    // False if the key was already present or the set is full
+    [[nodiscard]] bool insert(const Key& key) {
+        if (core_.find_index(key) != Core::NOT_FOUND) {
+            return false;
         }
+        SetBucket entry{};
+        entry.key = key;
+        return core_.insert_new(std::move(entry));
     }
 
-    RobinHoodTable(const RobinHoodTable&) = delete;
-    RobinHoodTable& operator=(const RobinHoodTable&) = delete;
-    RobinHoodTable(RobinHoodTable&&) = delete;
-    RobinHoodTable& operator=(RobinHoodTable&&) = delete;
+    [[nodiscard]] bool contains(const Key& key) const noexcept { return core_.find_index(key) != Core::NOT_FOUND; }
 
-    [[nodiscard]] bool put(const Key& key, const Value& value) {
-        size_t idx = compute_bucket_index(key);
-        uint8_t distance = 0;
+    [[nodiscard]] size_t size() const noexcept { return core_.size(); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+};
 
-        __builtin_prefetch(&buckets_[idx], 1, 3);
+// ============================================================================
+// Robin Hood Multimap
+// ============================================================================
 
-        size_t probe_idx = idx;
-        while (buckets_[probe_idx].state == BUCKET_OCCUPIED) {
-            if (buckets_[probe_idx].probe_distance < distance) {
-                break;
-            }
+// One-to-many table. Every value of a key is its own bucket, and a new
+// value is inserted right after the key's last one, so equal keys always
+// form one contiguous run (wrapping at the end of the array). Lookups walk
+// the run in place instead of chasing a pointer to a per-key vector.
+template<TableKey Key, TableValue Value, size_t Capacity,
+         size_t CacheLineSize = DEFAULT_CACHE_LINE_SIZE>
+    requires (Capacity >= 16) && is_power_of_two<Capacity>
+class RobinHoodMultiMap {
+
+    struct MultiBucket {
+        Key key;
+        Value value;
+        uint8_t state;
+        uint8_t probe_distance;
+    };
+
+    using Core = RobinHoodCore<MultiBucket, Capacity, CacheLineSize>;
+    Core core_;
 
-            if (buckets_[probe_idx].key == key) {
-                buckets_[probe_idx].value = value;
-                return false;
+public:
+    // The values of one key, in insertion order
+    class ValueRange {
+    public:
+        class iterator {
+        public:
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const Core* core, size_t idx, size_t remaining) : core_(core), idx_(idx), remaining_(remaining) {}
+
+            const Value& operator*() const noexcept { return core_->bucket(idx_).value; }
+            iterator& operator++() noexcept {
+                idx_ = (idx_ + 1) & Core::INDEX_MASK;
+                --remaining_;
+                return *this;
+            }
+            iterator operator++(int) noexcept {
+                iterator copy = *this;
+                ++*this;
+                return copy;
             }
+            bool operator==(const iterator& other) const noexcept { return remaining_ == other.remaining_; }
+
+        private:
+            const Core* core_ = nullptr;
+            size_t idx_ = 0;
+            size_t remaining_ = 0;
+        };
+
+        ValueRange(const Core* core, size_t first, size_t count) : core_(core), first_(first), count_(count) {}
+
+        iterator begin() const noexcept { return iterator(core_, first_, count_); }
+        iterator end() const noexcept { return iterator(core_, first_, 0); }
+        size_t size() const noexcept { return count_; }
+        bool empty() const noexcept { return count_ == 0; }
+
+    private:
+        const Core* core_;
+        size_t first_;
+        size_t count_;
+    };
+
+    RobinHoodMultiMap() = default;
+
+    RobinHoodMultiMap(const RobinHoodMultiMap&) = delete;
+    RobinHoodMultiMap& operator=(const RobinHoodMultiMap&) = delete;
+    RobinHoodMultiMap(RobinHoodMultiMap&&) = delete;
+    RobinHoodMultiMap& operator=(RobinHoodMultiMap&&) = delete;
 
-            probe_idx = (probe_idx + 1) & INDEX_MASK;
+    // Adds one more value for key; false when the table is full
+    [[nodiscard]] bool insert(const Key& key, const Value& value) {
+        MultiBucket entry{};
+        entry.key = key;
+        entry.value = value;
+
+        size_t idx = core_.find_index(key);
+        if (idx == Core::NOT_FOUND) {
+            return core_.insert_new(std::move(entry));
+        }
+        uint8_t distance = core_.bucket(idx).probe_distance;
+        for (size_t run = run_length(idx); run > 0; --run) {
+            idx = (idx + 1) & Core::INDEX_MASK;
             if (distance < 255) ++distance;
+        }
+        return core_.insert_at(idx, std::move(entry), distance);
+    }
 
-            __builtin_prefetch(&buckets_[(probe_idx + 1) & INDEX_MASK], 0, 3);
+    [[nodiscard]] ValueRange equal_range(const Key& key) const noexcept {
+        size_t idx = core_.find_index(key);
+        if (idx == Core::NOT_FOUND) {
+            return ValueRange(&core_, 0, 0);
         }
+        return ValueRange(&core_, idx, run_length(idx));
+    }
 
-        if (!insert_with_displacement(idx, key, value, 0)) {
-            return false;
+    [[nodiscard]] size_t count(const Key& key) const noexcept { return equal_range(key).size(); }
+
+    [[nodiscard]] size_t size() const noexcept { return core_.size(); }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    size_t run_length(size_t first) const noexcept {
+        const Key& key = core_.bucket(first).key;
+        size_t count = 1;
+        for (size_t idx = (first + 1) & Core::INDEX_MASK;
+             count < Capacity && core_.bucket(idx).state == BUCKET_OCCUPIED && core_.bucket(idx).key == key;
+             idx = (idx + 1) & Core::INDEX_MASK) {
+            ++count;
         }
-        ++size_;
-        return true;
+        return count;
     }
+};
+
+// ============================================================================
+// Static Perfect Hash Table
+// ============================================================================
 
+// Maps h uniformly onto [0, n) using the high bits (Lemire's fastrange)
+inline size_t fast_range(uint64_t h, size_t n) noexcept {
+    return static_cast<size_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+}
+
+// Read-only table over a key set known up front, built with a minimal
+// perfect hash in the hash-and-displace style (CHD / PTHash): keys are split
+// into ~n/4 buckets, and each bucket gets a 16-bit pilot chosen so its keys
+// land in free positions. As in PTHash, positions range over n / 0.97
+// rather than n, so even the last buckets placed find a free position
+// within a few dozen pilots; the positions past n that end up used are
+// remapped onto the slots below n left free, keeping the table minimal. A
+// lookup reads one pilot (the pilot array is n/2 bytes and stays cached)
+// and exactly one slot, then verifies the key; about 3% of keys also read
+// their remap entry.
+template<TableKey Key, TableValue Value>
+class PerfectHashTable {
+public:
     [[nodiscard]] Value* get(const Key& key) noexcept {
-        size_t idx = compute_bucket_index(key);
+        return const_cast<Value*>(std::as_const(*this).get(key));
+    }
 
-        __builtin_prefetch(&buckets_[idx], 0, 3);
+    [[nodiscard]] const Value* get(const Key& key) const noexcept {
+        if (slots_.empty()) return nullptr;
+        const Slot& slot = slots_[slot_index(seeded_hash(key))];
+        return slot.key == key ? &slot.value : nullptr;
+    }
 
-        uint8_t distance = 0;
-        while (buckets_[idx].state == BUCKET_OCCUPIED) {
-            if (distance > buckets_[idx].probe_distance) {
-                return nullptr;
-            }
+    [[nodiscard]] size_t size() const noexcept { return slots_.size(); }
 
-            if (buckets_[idx].key == key) {
-                return &buckets_[idx].value;
-            }
+    template<TableKey K, TableValue V>
+    friend std::optional<PerfectHashTable<K, V>> build_static(std::span<const K> keys, std::span<const V> values);
 
-            idx = (idx + 1) & INDEX_MASK;
-            if (distance < 255) ++distance;
+private:
+    static constexpr size_t KEYS_PER_BUCKET = 4;
+    // Positions per key; the free fraction this leaves bounds the expected
+    // pilots for the last buckets placed at 1 / (1 - 0.97 * fill)^size
+    static constexpr double LOAD_FACTOR = 0.97;
+    static constexpr uint32_t MAX_PILOT = 0xFFFF;
+    static constexpr int MAX_SEEDS = 8;
+
+    struct Slot {
+        Key key;
+        Value value;
+    };
 
-            __builtin_prefetch(&buckets_[(idx + 1) & INDEX_MASK], 0, 3);
+    std::vector<Slot> slots_;
+    std::vector<uint16_t> pilots_;
+    std::vector<size_t> remap_;      // position - n -> slot, for positions >= n
+    size_t positions_ = 0;
+    uint64_t seed_ = 0;
+
+    uint64_t seeded_hash(const Key& key) const noexcept {
+        uint64_t h;
+        if constexpr (std::is_integral_v<Key>) {
+            h = static_cast<uint64_t>(key);
+        } else {
+            h = std::hash<Key>{}(key);
         }
+        return splitmix64_hash(h ^ seed_);
+    }
 
-        return nullptr;
+    // The bucket comes from the high bits of h; the position from the low
+    // bits rotated up, so keys sharing a bucket still spread over the table
+    static size_t position_for(uint64_t h, uint16_t pilot, size_t positions) noexcept {
+        return fast_range(((h << 32) | (h >> 32)) ^ (pilot * 0x9E3779B97F4A7C15ULL), positions);
     }
 
-    [[nodiscard]] const Value* get(const Key& key) const noexcept {
-        size_t idx = compute_bucket_index(key);
+    size_t slot_index(uint64_t h) const noexcept {
+        const size_t position = position_for(h, pilots_[fast_range(h, pilots_.size())], positions_);
+        return position < slots_.size() ? position : remap_[position - slots_.size()];
+    }
 
-        uint8_t distance = 0;
-        while (buckets_[idx].state == BUCKET_OCCUPIED) {
-            if (distance > buckets_[idx].probe_distance) {
-                return nullptr;
+    enum class SeedResult { placed, retry, duplicate_key };
+    SeedResult try_seed(std::span<const Key> keys, std::vector<size_t>& position_of_key);
+};
+
+template<TableKey Key, TableValue Value>
+typename PerfectHashTable<Key, Value>::SeedResult PerfectHashTable<Key, Value>::try_seed(std::span<const Key> keys, std::vector<size_t>& position_of_key) {
+    const size_t n = keys.size();
+    const size_t bucket_count = pilots_.size();
+
+    std::vector<uint64_t> hashes(n);
+    for (size_t i = 0; i < n; ++i) hashes[i] = seeded_hash(keys[i]);
+
+    // Key indices grouped by bucket (counting sort), then buckets ordered
+    // largest first (counting sort by size)
+    std::vector<size_t> bucket_start(bucket_count + 1, 0);
+    for (size_t i = 0; i < n; ++i) ++bucket_start[fast_range(hashes[i], bucket_count) + 1];
+    size_t largest = 0;
+    for (size_t b = 0; b < bucket_count; ++b) {
+        largest = std::max(largest, bucket_start[b + 1]);
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    std::vector<size_t> order(n);
+    {
+        std::vector<size_t> cursor(bucket_start.begin(), bucket_start.end() - 1);
+        for (size_t i = 0; i < n; ++i) order[cursor[fast_range(hashes[i], bucket_count)]++] = i;
+    }
+    std::vector<size_t> by_size_start(largest + 2, 0);
+    for (size_t b = 0; b < bucket_count; ++b) ++by_size_start[largest - (bucket_start[b + 1] - bucket_start[b]) + 1];
+    for (size_t size = 0; size <= largest; ++size) by_size_start[size + 1] += by_size_start[size];
+    std::vector<size_t> buckets(bucket_count);
+    for (size_t b = 0; b < bucket_count; ++b) {
+        buckets[by_size_start[largest - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+    }
+
+    // Keys with equal hashes collide under every pilot
+    for (size_t b = 0; b < bucket_count; ++b) {
+        for (size_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i) {
+            for (size_t j = i + 1; j < bucket_start[b + 1]; ++j) {
+                if (hashes[order[i]] != hashes[order[j]]) continue;
+                return keys[order[i]] == keys[order[j]] ? SeedResult::duplicate_key : SeedResult::retry;
             }
+        }
+    }
 
-            if (buckets_[idx].key == key) {
-                return &buckets_[idx].value;
+    // mark[position] is TAKEN once placed, otherwise the last trial that
+    // tried it, so a trial spots its own repeats without a search
+    constexpr uint64_t TAKEN = ~uint64_t{0};
+    std::vector<uint64_t> mark(positions_, 0);
+    uint64_t trial = 0;
+    for (size_t b : buckets) {
+        const size_t begin = bucket_start[b];
+        const size_t end = bucket_start[b + 1];
+        if (begin == end) break;  // only empty buckets remain
+
+        bool placed = false;
+        for (uint32_t pilot = 0; pilot <= MAX_PILOT && !placed; ++pilot) {
+            ++trial;
+            placed = true;
+            for (size_t i = begin; i < end; ++i) {
+                size_t& position = position_of_key[order[i]];
+                position = position_for(hashes[order[i]], static_cast<uint16_t>(pilot), positions_);
+                if (mark[position] == TAKEN || mark[position] == trial) {
+                    placed = false;
+                    break;
+                }
+                mark[position] = trial;
             }
+            if (placed) {
+                pilots_[b] = static_cast<uint16_t>(pilot);
+                for (size_t i = begin; i < end; ++i) mark[position_of_key[order[i]]] = TAKEN;
+            }
+        }
+        if (!placed) return SeedResult::retry;
+    }
+    return SeedResult::placed;
+}
 
-            idx = (idx + 1) & INDEX_MASK;
-            if (distance < 255) ++distance;
+// Builds a PerfectHashTable mapping keys[i] to values[i]. Returns nullopt
+// when the spans differ in length or a key repeats. A seed is retried only
+// when two different keys hash alike or a bucket exhausts its pilots, which
+// the spare positions make vanishingly rare.
+template<TableKey Key, TableValue Value>
+[[nodiscard]] std::optional<PerfectHashTable<Key, Value>> build_static(std::span<const Key> keys,
+                                                                       std::span<const Value> values) {
+    using Table = PerfectHashTable<Key, Value>;
+    if (keys.size() != values.size()) return std::nullopt;
+
+    Table table;
+    const size_t n = keys.size();
+    if (n == 0) return table;
+
+    table.pilots_.assign((n + Table::KEYS_PER_BUCKET - 1) / Table::KEYS_PER_BUCKET, 0);
+    table.positions_ = std::max(n, static_cast<size_t>(std::ceil(static_cast<double>(n) / Table::LOAD_FACTOR)));
+    std::vector<size_t> position_of_key(n);
+    for (int attempt = 0; attempt < Table::MAX_SEEDS; ++attempt) {
+        table.seed_ = splitmix64_hash(static_cast<uint64_t>(attempt));
+        std::fill(table.pilots_.begin(), table.pilots_.end(), uint16_t{0});
+        auto result = table.try_seed(keys, position_of_key);
+        if (result == Table::SeedResult::duplicate_key) return std::nullopt;
+        if (result == Table::SeedResult::retry) continue;
+
+        // Each used position past n takes the next slot below n left free
+        std::vector<uint8_t> used(n, 0);
+        for (size_t position : position_of_key) {
+            if (position < n) used[position] = 1;
+        }
+        table.remap_.assign(table.positions_ - n, 0);
+        size_t free_slot = 0;
+        for (size_t& position : position_of_key) {
+            if (position < n) continue;
+            while (used[free_slot]) ++free_slot;
+            used[free_slot] = 1;
+            table.remap_[position - n] = free_slot;
+            position = free_slot;
         }
 
-        return nullptr;
+        std::vector<std::optional<typename Table::Slot>> placed(n);
+        for (size_t i = 0; i < n; ++i) placed[position_of_key[i]].emplace(keys[i], values[i]);
+        table.slots_.reserve(n);
+        for (auto& slot : placed) table.slots_.push_back(std::move(*slot));
+        return table;
     }
+    return std::nullopt;
+}
 
-    [[nodiscard]] size_t size() const noexcept { return size_; }
-    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
-    [[nodiscard]] static constexpr size_t cache_line_size() noexcept { return CacheLineSize; }
-};
+// Same, deducing the key and value types from the vectors
+template<TableKey Key, TableValue Value>
+[[nodiscard]] std::optional<PerfectHashTable<Key, Value>> build_static(const std::vector<Key>& keys,
+                                                                       const std::vector<Value>& values) {
+    return build_static(std::span<const Key>(keys), std::span<const Value>(values));
+}
 
 } // namespace robin_hood
 
@@ -0,0 +1,333 @@
+#include "robin_hood.h"
+#include "concurrent_robin_hood.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace robin_hood;
+
+namespace {
+
+std::vector<uint64_t> distinct_keys(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::unordered_set<uint64_t> seen;
+    std::vector<uint64_t> keys;
+    keys.reserve(n);
+    while (keys.size() < n) {
+        uint64_t key = rng();
+        if (seen.insert(key).second) keys.push_back(key);
+    }
+    return keys;
+}
+
+// Value whose destructor poisons it, so a reader still holding a node the
+// epoch domain has freed sees a bad check word (and ASan sees the read)
+struct Payload {
+    static constexpr uint64_t POISON = 0xDEADDEADDEADDEADULL;
+
+    uint64_t key = 0;
+    uint64_t check = 0;
+    uint64_t generation = 0;
+
+    static uint64_t check_for(uint64_t key) noexcept { return splitmix64_hash(key) | 1; }
+
+    bool valid_for(uint64_t expected_key) const noexcept {
+        return key == expected_key && check == check_for(expected_key);
+    }
+
+    Payload(uint64_t k, uint64_t g) : key(k), check(check_for(k)), generation(g) {}
+    Payload(const Payload&) = default;
+    Payload& operator=(const Payload&) = default;
+    ~Payload() { *static_cast<volatile uint64_t*>(&check) = POISON; }
+};
+
+} // namespace
+
+TEST_CASE("RobinHoodTable matches a std::map reference", "[robin_hood]") {
+    RobinHoodTable<uint64_t, uint64_t, 1024> table;
+    std::map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(88);
+
+    // Up to 90% load, with a small key range so half the puts replace
+    for (int op = 0; op < 20'000 && reference.size() < 920; ++op) {
+        const uint64_t key = rng() % 1800;
+        const uint64_t value = rng();
+        const bool added = !reference.contains(key);
+        REQUIRE(table.put(key, value) == added);
+        reference[key] = value;
+    }
+    REQUIRE(table.size() == reference.size());
+    for (uint64_t key = 0; key < 1800; ++key) {
+        const uint64_t* value = table.get(key);
+        auto it = reference.find(key);
+        if (it == reference.end()) {
+            REQUIRE(value == nullptr);
+        } else {
+            REQUIRE((value != nullptr && *value == it->second));
+        }
+    }
+}
+
+TEST_CASE("RobinHoodTable refuses new keys when full but still replaces", "[robin_hood]") {
+    RobinHoodTable<int, int, 16> table;
+    for (int key = 0; key < 16; ++key) REQUIRE(table.put(key, key));
+    REQUIRE_FALSE(table.put(16, 16));
+    REQUIRE(table.get(16) == nullptr);
+    REQUIRE_FALSE(table.put(3, 30));
+    REQUIRE(*table.get(3) == 30);
+    REQUIRE(table.size() == 16);
+}
+
+TEST_CASE("RobinHoodSet inserts, finds and fills up", "[robin_hood]") {
+    RobinHoodSet<uint64_t, 16> set;
+    REQUIRE_FALSE(set.contains(7));
+    REQUIRE(set.insert(7));
+    REQUIRE(set.contains(7));
+    REQUIRE_FALSE(set.insert(7));
+    REQUIRE(set.size() == 1);
+
+    for (uint64_t key = 100; key < 115; ++key) REQUIRE(set.insert(key));
+    REQUIRE(set.size() == 16);
+    REQUIRE_FALSE(set.insert(1000));
+    REQUIRE_FALSE(set.insert(7));
+    REQUIRE_FALSE(set.contains(1000));
+    REQUIRE(set.contains(7));
+    for (uint64_t key = 100; key < 115; ++key) REQUIRE(set.contains(key));
+
+    RobinHoodSet<uint64_t, 1024> large;
+    std::set<uint64_t> reference;
+    std::mt19937_64 rng(8);
+    while (reference.size() < 900) {
+        const uint64_t key = rng() % 5000;
+        REQUIRE(large.insert(key) == reference.insert(key).second);
+    }
+    for (uint64_t key = 0; key < 5000; ++key) REQUIRE(large.contains(key) == reference.contains(key));
+}
+
+namespace {
+
+// Keys whose home bucket in a Capacity-bucket table is home
+template<size_t Capacity>
+std::vector<uint64_t> keys_with_home(size_t home, size_t count, uint64_t start = 0) {
+    std::vector<uint64_t> keys;
+    for (uint64_t key = start; keys.size() < count; ++key) {
+        if ((splitmix64_hash(key) & (Capacity - 1)) == home) keys.push_back(key);
+    }
+    return keys;
+}
+
+template<typename Range>
+std::vector<int> values_of(const Range& range) {
+    return std::vector<int>(range.begin(), range.end());
+}
+
+} // namespace
+
+TEST_CASE("RobinHoodMultiMap keeps each key's values in order across wraparound", "[robin_hood]") {
+    constexpr size_t kCapacity = 64;
+    RobinHoodMultiMap<uint64_t, int, kCapacity> map;
+    const uint64_t wrapping = keys_with_home<kCapacity>(kCapacity - 1, 1)[0];
+    const uint64_t at_zero = keys_with_home<kCapacity>(0, 1)[0];
+    const uint64_t at_one = keys_with_home<kCapacity>(1, 1)[0];
+    const std::vector<uint64_t> before_end = keys_with_home<kCapacity>(kCapacity - 2, 2);
+
+    // The run starts in the last bucket and wraps to the front
+    for (int v = 0; v < 3; ++v) REQUIRE(map.insert(wrapping, v));
+    REQUIRE(map.insert(at_zero, 100));
+    REQUIRE(map.insert(at_one, 200));
+    // Appended inside the wrapped run, shifting the two keys behind it
+    REQUIRE(map.insert(wrapping, 3));
+    // Keys homed just before the run displace all of it one bucket on
+    REQUIRE(map.insert(before_end[0], 300));
+    REQUIRE(map.insert(before_end[1], 301));
+    REQUIRE(map.insert(wrapping, 4));
+    REQUIRE(map.insert(at_zero, 101));
+
+    REQUIRE(values_of(map.equal_range(wrapping)) == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(values_of(map.equal_range(at_zero)) == std::vector<int>{100, 101});
+    REQUIRE(values_of(map.equal_range(at_one)) == std::vector<int>{200});
+    REQUIRE(map.count(before_end[0]) == 1);
+    REQUIRE(map.count(before_end[1]) == 1);
+    REQUIRE(map.size() == 10);
+
+    uint64_t absent = 0;
+    while (absent == wrapping || absent == at_zero || absent == at_one || absent == before_end[0] ||
+           absent == before_end[1]) {
+        ++absent;
+    }
+    REQUIRE(map.count(absent) == 0);
+    REQUIRE(map.equal_range(absent).empty());
+}
+
+TEST_CASE("RobinHoodMultiMap matches a reference under random inserts", "[robin_hood]") {
+    constexpr size_t kCapacity = 256;
+    RobinHoodMultiMap<uint64_t, int, kCapacity> map;
+    std::map<uint64_t, std::vector<int>> reference;
+    std::mt19937_64 rng(88);
+    for (int i = 0; i < 230; ++i) {
+        const uint64_t key = rng() % 60;
+        REQUIRE(map.insert(key, i));
+        reference[key].push_back(i);
+    }
+    REQUIRE(map.size() == 230);
+    for (uint64_t key = 0; key < 100; ++key) {
+        auto it = reference.find(key);
+        const std::vector<int> expected = it == reference.end() ? std::vector<int>{} : it->second;
+        REQUIRE(values_of(map.equal_range(key)) == expected);
+        REQUIRE(map.count(key) == expected.size());
+    }
+
+    // Full: one more value of any key is refused and nothing moves
+    for (int i = 230; i < 256; ++i) REQUIRE(map.insert(1000 + i, i));
+    REQUIRE_FALSE(map.insert(0, -1));
+    REQUIRE(values_of(map.equal_range(0)) == reference[0]);
+}
+
+TEST_CASE("build_static maps every key and rejects absent ones", "[robin_hood]") {
+    for (size_t n : {size_t{1}, size_t{2}, size_t{5}, size_t{1000}, size_t{100'000}, size_t{1'000'000}}) {
+        CAPTURE(n);
+        std::vector<uint64_t> keys = distinct_keys(n + 1000, n);
+        std::vector<uint64_t> absent(keys.end() - 1000, keys.end());
+        keys.resize(n);
+        std::vector<uint32_t> values(n);
+        for (size_t i = 0; i < n; ++i) values[i] = static_cast<uint32_t>(i);
+
+        auto start = std::chrono::steady_clock::now();
+        auto table = build_static(keys, values);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        REQUIRE(table.has_value());
+        REQUIRE(table->size() == n);
+        if (n >= 100'000) std::cout << "build_static(" << n << " keys): " << ms << " ms\n";
+
+        size_t wrong = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t* found = table->get(keys[i]);
+            wrong += found == nullptr || *found != i;
+        }
+        REQUIRE(wrong == 0);
+        for (uint64_t key : absent) REQUIRE(table->get(key) == nullptr);
+    }
+}
+
+TEST_CASE("build_static handles small integer keys", "[robin_hood]") {
+    // Sequential keys stress the hash rather than the placement
+    std::vector<int> keys(50'000);
+    for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int>(i);
+    auto table = build_static(keys, keys);
+    REQUIRE(table.has_value());
+    for (int key : keys) {
+        const int* found = table->get(key);
+        REQUIRE((found != nullptr && *found == key));
+    }
+    REQUIRE(table->get(-1) == nullptr);
+    REQUIRE(table->get(50'000) == nullptr);
+}
+
+TEST_CASE("build_static rejects bad input", "[robin_hood]") {
+    std::vector<uint64_t> keys{1, 2, 3, 2};
+    std::vector<uint64_t> values{10, 20, 30, 40};
+    REQUIRE_FALSE(build_static(keys, values).has_value());
+
+    keys.pop_back();
+    REQUIRE_FALSE(build_static(keys, values).has_value());
+
+    auto empty = build_static(std::vector<uint64_t>{}, std::vector<uint64_t>{});
+    REQUIRE(empty.has_value());
+    REQUIRE(empty->size() == 0);
+    REQUIRE(empty->get(1) == nullptr);
+}
+
+TEST_CASE("ConcurrentRobinHoodTable readers never miss a present key or see a freed node", "[robin_hood][concurrent]") {
+    // Stable keys stay in the table throughout (only their values are
+    // replaced); churn keys come and go around them, so every insert and
+    // erase displaces or shifts stable keys while readers probe for them
+    constexpr size_t kCapacity = 1024;
+    constexpr uint64_t kStable = 300;
+    constexpr uint64_t kChurn = 450;
+    constexpr int kWriterOps = 200'000;
+
+    epoch::Domain domain;
+    {
+        ConcurrentRobinHoodTable<uint64_t, Payload, kCapacity> table(domain);
+        for (uint64_t key = 0; key < kStable; ++key) REQUIRE(table.put(key, Payload(key, 0)));
+
+        std::atomic<bool> done{false};
+        std::atomic<int> misses{0};
+        std::atomic<int> bad_values{0};
+        std::atomic<uint64_t> reads{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&, r] {
+                std::mt19937_64 rng(r);
+                uint64_t local_reads = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto guard = table.pin();
+                    const uint64_t stable = rng() % kStable;
+                    const Payload* held = table.get(stable, guard);
+                    if (held == nullptr) {
+                        misses.fetch_add(1);
+                        continue;
+                    }
+                    if (!held->valid_for(stable)) bad_values.fetch_add(1);
+
+                    // Keep probing while holding the first node; the writer
+                    // may replace it meanwhile, but not free it under the pin
+                    for (int i = 0; i < 8; ++i) {
+                        const uint64_t churn = kStable + rng() % kChurn;
+                        if (const Payload* value = table.get(churn, guard); value != nullptr && !value->valid_for(churn)) {
+                            bad_values.fetch_add(1);
+                        }
+                        const uint64_t other = rng() % kStable;
+                        if (const Payload* value = table.get(other, guard); value == nullptr) {
+                            misses.fetch_add(1);
+                        } else if (!value->valid_for(other)) {
+                            bad_values.fetch_add(1);
+                        }
+                    }
+                    if (!held->valid_for(stable)) bad_values.fetch_add(1);
+                    local_reads += 17;
+                }
+                reads.fetch_add(local_reads);
+            });
+        }
+
+        std::mt19937_64 rng(99);
+        for (int op = 0; op < kWriterOps; ++op) {
+            const uint64_t roll = rng() % 10;
+            if (roll < 4) {
+                const uint64_t key = kStable + rng() % kChurn;
+                (void)table.put(key, Payload(key, op));
+            } else if (roll < 7) {
+                (void)table.erase(kStable + rng() % kChurn);
+            } else {
+                const uint64_t key = rng() % kStable;
+                REQUIRE_FALSE(table.put(key, Payload(key, op)));
+            }
+            if (op % 256 == 0) std::this_thread::yield();
+        }
+        done = true;
+        for (auto& reader : readers) reader.join();
+
+        REQUIRE(reads.load() > 0);
+        REQUIRE(misses == 0);
+        REQUIRE(bad_values == 0);
+        for (uint64_t key = 0; key < kStable; ++key) {
+            auto guard = table.pin();
+            const Payload* value = table.get(key, guard);
+            REQUIRE((value != nullptr && value->valid_for(key)));
+        }
+    }
+    domain.drain();
+    REQUIRE(domain.retired_count() > 0);
+    REQUIRE(domain.reclaimed_count() == domain.retired_count());
+}
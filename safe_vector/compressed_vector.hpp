@@ -0,0 +1,247 @@
+#ifndef CUSTOMVECTOR_COMPRESSED_VECTOR_HPP
+#define CUSTOMVECTOR_COMPRESSED_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace customvector {
+    using std::invalid_argument;
+
+    namespace compressed_detail {
+        inline constexpr size_t kBlock = 128;
+        // Values are packed in a vertical layout: value i goes to lane
+        // i % kLanes, and word w of lane l is stored at w * kLanes + l, so
+        // one step of the (un)packer does the same shift on kLanes adjacent
+        // words and the compiler emits it as vector instructions
+        inline constexpr size_t kLanes = 4;
+        inline constexpr size_t kPerLane = kBlock / kLanes;
+
+        template <typename T>
+        inline constexpr unsigned kBits = sizeof(T) * 8;
+
+        template <typename T>
+        constexpr size_t words_for(unsigned bits) noexcept {
+            return kLanes * ((kPerLane * bits + kBits<T> - 1) / kBits<T>);
+        }
+
+        template <typename T, unsigned B, size_t J>
+        inline void pack_step(const T* __restrict in, T* __restrict out) noexcept {
+            constexpr size_t bit = J * B;
+            constexpr size_t word = bit / kBits<T>;
+            constexpr unsigned shift = bit % kBits<T>;
+            for (size_t l = 0; l < kLanes; ++l) {
+                const T value = in[J * kLanes + l];
+                out[word * kLanes + l] |= static_cast<T>(value << shift);
+                if constexpr (shift + B > kBits<T>) {
+                    out[(word + 1) * kLanes + l] |= static_cast<T>(value >> (kBits<T> - shift));
+                }
+            }
+        }
+
+        template <typename T, unsigned B, size_t J>
+        inline void unpack_step(const T* __restrict in, T* __restrict out) noexcept {
+            constexpr size_t bit = J * B;
+            constexpr size_t word = bit / kBits<T>;
+            constexpr unsigned shift = bit % kBits<T>;
+            constexpr T mask = B == kBits<T> ? static_cast<T>(~T{0}) : static_cast<T>((T{1} << B) - 1);
+            for (size_t l = 0; l < kLanes; ++l) {
+                T value = static_cast<T>(in[word * kLanes + l] >> shift);
+                if constexpr (shift + B > kBits<T>) {
+                    value |= static_cast<T>(in[(word + 1) * kLanes + l] << (kBits<T> - shift));
+                }
+                out[J * kLanes + l] = static_cast<T>(value & mask);
+            }
+        }
+
+        // One fully unrolled kernel per bit width: every shift and word
+        // index is a compile-time constant
+        template <typename T, unsigned B>
+        void pack(const T* __restrict in, T* __restrict out) noexcept {
+            std::fill(out, out + words_for<T>(B), T{0});
+            if constexpr (B > 0) {
+                [&]<size_t... J>(std::index_sequence<J...>) {
+                    (pack_step<T, B, J>(in, out), ...);
+                }(std::make_index_sequence<kPerLane>{});
+            }
+        }
+
+        template <typename T, unsigned B>
+        void unpack(const T* __restrict in, T* __restrict out) noexcept {
+            if constexpr (B == 0) {
+                std::fill(out, out + kBlock, T{0});
+            } else {
+                [&]<size_t... J>(std::index_sequence<J...>) {
+                    (unpack_step<T, B, J>(in, out), ...);
+                }(std::make_index_sequence<kPerLane>{});
+            }
+        }
+
+        template <typename T>
+        using Kernel = void (*)(const T*, T*) noexcept;
+
+        template <typename T>
+        inline constexpr auto kPackers = []<unsigned... B>(std::integer_sequence<unsigned, B...>) {
+            return std::array<Kernel<T>, sizeof...(B)>{&pack<T, B>...};
+        }(std::make_integer_sequence<unsigned, kBits<T> + 1>{});
+
+        template <typename T>
+        inline constexpr auto kUnpackers = []<unsigned... B>(std::integer_sequence<unsigned, B...>) {
+            return std::array<Kernel<T>, sizeof...(B)>{&unpack<T, B>...};
+        }(std::make_integer_sequence<unsigned, kBits<T> + 1>{});
+    }
+
+    // Append-only vector of unsigned integers compressed in blocks of 128.
+    //
+    // Each block stores its deltas v[i] - v[i - 1] minus the block's
+    // smallest delta, bit-packed at the width of the largest result. Sorted
+    // ids with small gaps and timestamps at a near-regular interval pack to
+    // a few bits per value; a constant stride packs to zero bits. Deltas
+    // wrap modulo 2^N, so unsorted input round-trips too (at up to N bits).
+    //
+    // A block is two header words (the value before the first, and the
+    // smallest delta) followed by its packed words, so a lookup that finds
+    // the block's offset in the small per-block index then misses on one
+    // place in memory, not two. Random access unpacks one block; decode()
+    // streams whole blocks. Values appended after the last full block stay
+    // uncompressed until 128 of them have accumulated.
+    template <std::unsigned_integral T = uint64_t>
+    class compressed_vector {
+    public:
+        using value_type = T;
+        static constexpr size_t kBlockSize = compressed_detail::kBlock;
+
+        compressed_vector() = default;
+
+        // Blocks, index and tail all allocate from resource; null means the heap
+        explicit compressed_vector(std::pmr::memory_resource* resource)
+            : words_(resource), blocks_(resource), tail_(resource) {}
+
+        explicit compressed_vector(std::span<const T> values, std::pmr::memory_resource* resource = nullptr)
+            : compressed_vector(resource) {
+            for (T value : values) {
+                push_back(value);
+            }
+        }
+
+        explicit compressed_vector(const vector<T>& values, std::pmr::memory_resource* resource = nullptr)
+            : compressed_vector(std::span<const T>(values.data(), values.size()), resource) {}
+
+        void push_back(T value) {
+            tail_.push_back(value);
+            if (tail_.size() == kBlockSize) {
+                seal_tail();
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return blocks_.size() * kBlockSize + tail_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // Full blocks; the trailing partial block is not counted
+        [[nodiscard]] size_t block_count() const noexcept { return blocks_.size(); }
+
+        // Total footprint: blocks, block index and the tail
+        [[nodiscard]] size_t bytes() const noexcept {
+            return words_.size() * sizeof(T) + blocks_.size() * sizeof(uint64_t) + tail_.size() * sizeof(T);
+        }
+
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept { return words_.resource(); }
+
+        [[nodiscard]] T operator[](size_t index) const noexcept {
+            const size_t block = index / kBlockSize;
+            if (block == blocks_.size()) {
+                return tail_[index % kBlockSize];
+            }
+            // v[p] = base + (p + 1) * min_delta + the sum of packed[0..p],
+            // which is a plain (vectorizable) reduction over the block
+            const T* words = words_.data() + offset_of(block);
+            T packed[kBlockSize];
+            compressed_detail::kUnpackers<T>[bits_of(block)](words + kHeaderWords, packed);
+            const size_t position = index % kBlockSize;
+            T sum = 0;
+            for (size_t i = 0; i <= position; ++i) {
+                sum += packed[i];
+            }
+            return static_cast<T>(words[0] + static_cast<T>(position + 1) * words[1] + sum);
+        }
+
+        [[nodiscard]] T at(size_t index) const {
+            if (index >= size()) {
+                throw out_of_range("customvector::compressed_vector::at - index out of bounds");
+            }
+            return (*this)[index];
+        }
+
+        // Writes the kBlockSize values of a full block to out
+        void decode_block(size_t block, T* out) const noexcept {
+            const T* words = words_.data() + offset_of(block);
+            compressed_detail::kUnpackers<T>[bits_of(block)](words + kHeaderWords, out);
+            // Locals, so the stores to out cannot alias the header
+            const T min_delta = words[1];
+            T previous = words[0];
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                previous = static_cast<T>(previous + min_delta + out[i]);
+                out[i] = previous;
+            }
+        }
+
+        // Writes every value to out, which must hold exactly size() values
+        void decode(std::span<T> out) const {
+            if (out.size() != size()) {
+                throw invalid_argument("customvector::compressed_vector::decode - output size differs");
+            }
+            for (size_t block = 0; block < blocks_.size(); ++block) {
+                decode_block(block, out.data() + block * kBlockSize);
+            }
+            std::copy(tail_.begin(), tail_.end(), out.data() + blocks_.size() * kBlockSize);
+        }
+
+    private:
+        using Signed = std::make_signed_t<T>;
+        static constexpr size_t kHeaderWords = 2;
+
+        vector<T> words_;
+        // Per block: offset into words_ << 8 | packed bit width
+        vector<uint64_t> blocks_;
+        vector<T> tail_;
+
+        size_t offset_of(size_t block) const noexcept { return static_cast<size_t>(blocks_[block] >> 8); }
+        unsigned bits_of(size_t block) const noexcept { return static_cast<unsigned>(blocks_[block] & 0xff); }
+
+        void seal_tail() {
+            T packed[kBlockSize];
+            Signed min_delta = 0;
+            for (size_t i = 1; i < kBlockSize; ++i) {
+                const auto delta = static_cast<Signed>(static_cast<T>(tail_[i] - tail_[i - 1]));
+                min_delta = i == 1 ? delta : std::min(min_delta, delta);
+            }
+            T widest = 0;
+            packed[0] = 0;
+            for (size_t i = 1; i < kBlockSize; ++i) {
+                packed[i] = static_cast<T>(tail_[i] - tail_[i - 1] - static_cast<T>(min_delta));
+                widest |= packed[i];
+            }
+
+            const auto bits = static_cast<unsigned>(std::bit_width(widest));
+            const size_t offset = words_.size();
+            words_.push_back(static_cast<T>(tail_[0] - static_cast<T>(min_delta)));
+            words_.push_back(static_cast<T>(min_delta));
+            for (size_t i = 0; i < compressed_detail::words_for<T>(bits); ++i) {
+                words_.push_back(0);
+            }
+            compressed_detail::kPackers<T>[bits](packed, words_.data() + offset + kHeaderWords);
+            blocks_.push_back(static_cast<uint64_t>(offset) << 8 | bits);
+            tail_.clear();
+        }
+    };
+}
+
+#endif // CUSTOMVECTOR_COMPRESSED_VECTOR_HPP
@@ -0,0 +1,96 @@
+#include "compressed_vector.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+
+// Compression ratio, sequential decode throughput and random access latency
+// for 16M uint64 values of three shapes. The decode rate counts decoded
+// (uncompressed) bytes; memcpy of the raw array is the bandwidth baseline.
+TEST_CASE("compressed_vector: ratio, decode throughput and random access", "[benchmark][compressed_vector]") {
+    constexpr std::size_t kValues = std::size_t{1} << 24;
+    constexpr std::size_t kLookups = 2'000'000;
+
+    std::mt19937_64 rng(42);
+    customvector::vector<std::size_t> lookups;
+    for (std::size_t i = 0; i < kLookups; ++i) {
+        lookups.push_back(rng() % kValues);
+    }
+
+    struct Shape {
+        std::string name;
+        customvector::vector<std::uint64_t> values;
+    };
+    Shape shapes[3] = {{"sorted ids, gaps 1-256", {}}, {"timestamps, 1 ms +/- 2 us", {}}, {"random 64-bit", {}}};
+    std::uint64_t id = 0;
+    for (std::size_t i = 0; i < kValues; ++i) {
+        id += 1 + rng() % 256;
+        shapes[0].values.push_back(id);
+        shapes[1].values.push_back(1'700'000'000'000'000'000 + i * 1'000'000 + rng() % 4000);
+        shapes[2].values.push_back(rng());
+    }
+
+    customvector::vector<std::uint64_t> decoded;
+    for (std::size_t i = 0; i < kValues; ++i) {
+        decoded.push_back(0);
+    }
+    const std::span<std::uint64_t> out(decoded.data(), kValues);
+    constexpr double kRawBytes = kValues * sizeof(std::uint64_t);
+
+    auto best_seconds = [](auto&& body) {
+        double best = 0;
+        for (int rep = 0; rep < 5; ++rep) {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = rep == 0 ? seconds : std::min(best, seconds);
+        }
+        return best;
+    };
+
+    const double memcpy_s = best_seconds([&] {
+        std::memcpy(decoded.data(), shapes[0].values.data(), kValues * sizeof(std::uint64_t));
+    });
+    std::cout << "\n" << kValues << " uint64 values; memcpy baseline " << std::fixed << std::setprecision(2)
+              << kRawBytes / memcpy_s / 1e9 << " GB/s\n";
+
+    for (const Shape& shape : shapes) {
+        const auto encode_start = std::chrono::steady_clock::now();
+        customvector::compressed_vector<std::uint64_t> compressed(shape.values);
+        const double encode_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - encode_start).count();
+
+        const double decode_s = best_seconds([&] { compressed.decode(out); });
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), shape.values.begin()));
+
+        std::uint64_t raw_sum = 0;
+        std::uint64_t compressed_sum = 0;
+        const double raw_lookup_s = best_seconds([&] {
+            raw_sum = 0;
+            for (std::size_t index : lookups) {
+                raw_sum += shape.values[index];
+            }
+        });
+        const double compressed_lookup_s = best_seconds([&] {
+            compressed_sum = 0;
+            for (std::size_t index : lookups) {
+                compressed_sum += compressed[index];
+            }
+        });
+        REQUIRE(compressed_sum == raw_sum);
+
+        std::cout << "  " << std::left << std::setw(26) << shape.name << std::right << std::setprecision(2)
+                  << " ratio " << std::setw(6) << kRawBytes / static_cast<double>(compressed.bytes())
+                  << "x (" << std::setw(5) << compressed.bytes() * 8.0 / kValues << " bits/value)"
+                  << "  encode " << std::setw(6) << kRawBytes / encode_s / 1e9 << " GB/s"
+                  << "  decode " << std::setw(6) << kRawBytes / decode_s / 1e9 << " GB/s"
+                  << "  random get " << std::setw(6) << compressed_lookup_s / kLookups * 1e9 << " ns (raw "
+                  << raw_lookup_s / kLookups * 1e9 << " ns)\n";
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include "arena.h"
+#include "compressed_vector.hpp"
+using customvector::compressed_vector;
+using customvector::vector;
+
+namespace {
+    template <typename T>
+    void require_round_trip(const vector<T>& values) {
+        compressed_vector<T> compressed(values);
+        REQUIRE(compressed.size() == values.size());
+
+        vector<T> decoded;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            decoded.push_back(0);
+        }
+        compressed.decode(std::span<T>(decoded.data(), decoded.size()));
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), values.begin(), values.end()));
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            REQUIRE(compressed[i] == values[i]);
+        }
+    }
+}
+
+TEST_CASE("compressed_vector round-trips sorted, strided and random data", "[compressed_vector]") {
+    std::mt19937_64 rng(5);
+    for (std::size_t n : {0u, 1u, 127u, 128u, 129u, 1000u, 4096u}) {
+        vector<std::uint64_t> sorted;
+        vector<std::uint64_t> strided;
+        vector<std::uint64_t> random;
+        vector<std::uint64_t> descending;
+        std::uint64_t id = rng();
+        for (std::size_t i = 0; i < n; ++i) {
+            id += rng() % 300;
+            sorted.push_back(id);
+            strided.push_back(1'000'000 + i * 1000);
+            random.push_back(rng());
+            descending.push_back(std::numeric_limits<std::uint64_t>::max() - i * 7);
+        }
+        require_round_trip(sorted);
+        require_round_trip(strided);
+        require_round_trip(random);
+        require_round_trip(descending);
+    }
+}
+
+TEST_CASE("compressed_vector packs every bit width", "[compressed_vector]") {
+    // Block b holds deltas spanning exactly b bits
+    std::mt19937_64 rng(9);
+    vector<std::uint64_t> values;
+    std::uint64_t value = 0;
+    for (unsigned bits = 0; bits <= 64; ++bits) {
+        const std::uint64_t mask = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+        for (std::size_t i = 0; i < 128; ++i) {
+            std::uint64_t delta = rng() & mask;
+            if (i == 1) {
+                delta = 0;
+            } else if (i == 2) {
+                delta = mask;
+            }
+            value += delta;
+            values.push_back(value);
+        }
+    }
+    require_round_trip(values);
+}
+
+TEST_CASE("compressed_vector works for narrower integer types", "[compressed_vector]") {
+    std::mt19937 rng(1);
+    vector<std::uint32_t> narrow;
+    vector<std::uint16_t> narrower;
+    for (std::size_t i = 0; i < 3000; ++i) {
+        narrow.push_back(static_cast<std::uint32_t>(rng()));
+        narrower.push_back(static_cast<std::uint16_t>(i * 3 + rng() % 2));
+    }
+    require_round_trip(narrow);
+    require_round_trip(narrower);
+}
+
+TEST_CASE("compressed_vector shrinks regular data and checks bounds", "[compressed_vector]") {
+    compressed_vector<std::uint64_t> timestamps;
+    for (std::uint64_t i = 0; i < 128 * 100; ++i) {
+        timestamps.push_back(1'700'000'000'000'000'000 + i * 1'000'000);
+    }
+    REQUIRE(timestamps.block_count() == 100);
+    // Constant stride: zero packed bits, only the block headers remain
+    REQUIRE(timestamps.bytes() * 32 < timestamps.size() * sizeof(std::uint64_t));
+
+    timestamps.push_back(42);
+    REQUIRE(timestamps.size() == 128 * 100 + 1);
+    REQUIRE(timestamps.at(128 * 100) == 42);
+    REQUIRE(timestamps.at(5) == 1'700'000'000'005'000'000);
+    REQUIRE_THROWS_AS(timestamps.at(128 * 100 + 1), std::out_of_range);
+
+    vector<std::uint64_t> too_small;
+    REQUIRE_THROWS_AS(timestamps.decode(std::span<std::uint64_t>(too_small.data(), too_small.size())),
+                      std::invalid_argument);
+}
+
+TEST_CASE("compressed_vector allocates from a memory resource", "[compressed_vector][resource]") {
+    arena::MonotonicArena arena;
+    vector<std::uint32_t> values;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        values.push_back(i * 3);
+    }
+
+    compressed_vector<std::uint32_t> compressed(values, &arena);
+    REQUIRE(compressed.resource() == &arena);
+    REQUIRE(arena.bytes_used() > 0);
+    REQUIRE(compressed.block_count() == 7);
+    REQUIRE(compressed.at(999) == 2997);
+
+    compressed_vector<std::uint32_t> heap(values);
+    REQUIRE(heap.resource() == std::pmr::new_delete_resource());
+}
@@ -0,0 +1,331 @@
+#ifndef CUSTOMVECTOR_COW_VECTOR_HPP
+#define CUSTOMVECTOR_COW_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace customvector {
+
+    // Vector with copy-on-write value semantics for publishing one large
+    // array to many readers. Copies and snapshot() are O(1): they share a
+    // reference-counted spine of fixed-size chunks. The first write through
+    // a copy clones the spine (one pointer per chunk) and then only the
+    // chunk holding the element written, so an edit costs O(n / ChunkSize +
+    // ChunkSize) instead of O(n), and every other chunk stays shared.
+    //
+    // Sharing is safe across threads in the way std::shared_ptr is: distinct
+    // cow_vector objects may be read and written concurrently even when they
+    // share buffers, but one object must not be written while another thread
+    // reads or copies it. A publisher keeps the writable copy and hands each
+    // reader its own snapshot; a shared buffer is never written in place.
+    //
+    // Spines and chunks come from a std::pmr::memory_resource when given
+    // one. Each buffer remembers its resource, and copies share buffers and
+    // keep the source's resource, which must outlive every copy.
+    template <typename T, size_t ChunkSize = std::max<size_t>(4096 / sizeof(T), 1)>
+        requires copy_constructible<T> && (ChunkSize > 0)
+    class cow_vector {
+        struct Chunk {
+            std::atomic<size_t> refs{1};
+            size_t size = 0;
+            std::pmr::memory_resource* resource;
+            alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+
+            explicit Chunk(std::pmr::memory_resource* from) noexcept : resource(from) {}
+
+            T* items() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+            const T* items() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+        };
+
+        struct Spine {
+            std::atomic<size_t> refs{1};
+            size_t size = 0;
+            std::pmr::memory_resource* resource;
+            vector<Chunk*> chunks;
+
+            explicit Spine(std::pmr::memory_resource* from) : resource(from), chunks(from) {}
+        };
+
+    public:
+        class const_iterator;
+        using value_type = T;
+        static constexpr size_t kChunkSize = ChunkSize;
+
+        cow_vector() = default;
+
+        explicit cow_vector(std::pmr::memory_resource* resource) noexcept : resource_(resource) {}
+
+        explicit cow_vector(const vector<T>& items, std::pmr::memory_resource* resource = nullptr)
+            : resource_(resource) {
+            for (const T& item : items) {
+                push_back(item);
+            }
+        }
+
+        cow_vector(const cow_vector& other) noexcept
+            : resource_(other.resource_), spine_(acquire(other.spine_)) {}
+
+        cow_vector(cow_vector&& other) noexcept
+            : resource_(other.resource_), spine_(std::exchange(other.spine_, nullptr)) {}
+
+        cow_vector& operator=(const cow_vector& other) noexcept {
+            Spine* old = std::exchange(spine_, acquire(other.spine_));
+            resource_ = other.resource_;
+            release(old);
+            return *this;
+        }
+
+        cow_vector& operator=(cow_vector&& other) noexcept {
+            if (this != &other) {
+                resource_ = other.resource_;
+                release(std::exchange(spine_, std::exchange(other.spine_, nullptr)));
+            }
+            return *this;
+        }
+
+        ~cow_vector() { release(spine_); }
+
+        // O(1) immutable view of the current contents; later writes to
+        // either side do not show through to the other
+        [[nodiscard]] cow_vector snapshot() const noexcept { return *this; }
+
+        [[nodiscard]] size_t size() const noexcept { return spine_ ? spine_->size : 0; }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // Where new spines and chunks come from; new_delete_resource() for the global heap
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+            return resource_ ? resource_ : std::pmr::new_delete_resource();
+        }
+
+        [[nodiscard]] const T& operator[](size_t index) const noexcept {
+            return spine_->chunks[index / ChunkSize]->items()[index % ChunkSize];
+        }
+
+        [[nodiscard]] const T& at(size_t index) const {
+            if (index >= size()) {
+                throw out_of_range("customvector::cow_vector::at - index out of bounds");
+            }
+            return (*this)[index];
+        }
+
+        // Elements [c * ChunkSize, (c + 1) * ChunkSize) as one contiguous
+        // span; scanning chunk by chunk runs at plain array speed
+        [[nodiscard]] size_t chunk_count() const noexcept { return spine_ ? spine_->chunks.size() : 0; }
+
+        [[nodiscard]] std::span<const T> chunk(size_t c) const noexcept {
+            const Chunk* found = spine_->chunks[c];
+            return {found->items(), found->size};
+        }
+
+        // Writable reference to one element, unsharing its chunk first. The
+        // reference is invalidated by the next copy or write of this vector.
+        [[nodiscard]] T& write_at(size_t index) {
+            if (index >= size()) {
+                throw out_of_range("customvector::cow_vector::write_at - index out of bounds");
+            }
+            return unique_chunk(index / ChunkSize)->items()[index % ChunkSize];
+        }
+
+        void set(size_t index, const T& value) { write_at(index) = value; }
+
+        void push_back(const T& value) {
+            unique_spine();
+            const size_t chunk = spine_->size / ChunkSize;
+            if (chunk == spine_->chunks.size()) {
+                Chunk* fresh = make_node<Chunk>();
+                try {
+                    new (fresh->items()) T(value);
+                    fresh->size = 1;
+                    spine_->chunks.push_back(fresh);
+                } catch (...) {
+                    release(fresh);
+                    throw;
+                }
+                ++spine_->size;
+                return;
+            }
+            Chunk* last = unique_chunk(chunk);
+            new (last->items() + last->size) T(value);
+            ++last->size;
+            ++spine_->size;
+        }
+
+        void pop_back() {
+            if (empty()) {
+                throw out_of_range("customvector::cow_vector::pop_back - vector is empty");
+            }
+            unique_spine();
+            const size_t chunk = (spine_->size - 1) / ChunkSize;
+            if (spine_->chunks[chunk]->size == 1) {
+                release(spine_->chunks[chunk]);
+                spine_->chunks.pop_back();
+            } else {
+                Chunk* last = unique_chunk(chunk);
+                last->items()[--last->size].~T();
+            }
+            --spine_->size;
+        }
+
+        void clear() noexcept { release(std::exchange(spine_, nullptr)); }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(spine_, 0); }
+        [[nodiscard]] const_iterator end() const noexcept { return const_iterator(spine_, size()); }
+
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator() = default;
+
+            reference operator*() const noexcept { return *item_; }
+            pointer operator->() const noexcept { return item_; }
+
+            // Walks a chunk by pointer and looks up the spine only when
+            // crossing into the next one
+            const_iterator& operator++() noexcept {
+                ++index_;
+                item_ = index_ % ChunkSize != 0 ? item_ + 1 : locate(spine_, index_);
+                return *this;
+            }
+            const_iterator operator++(int) noexcept {
+                const_iterator before = *this;
+                ++*this;
+                return before;
+            }
+
+            bool operator==(const const_iterator& other) const noexcept { return index_ == other.index_; }
+
+        private:
+            friend class cow_vector;
+            const_iterator(const Spine* spine, size_t index) noexcept
+                : spine_(spine), index_(index), item_(locate(spine, index)) {}
+
+            static const T* locate(const Spine* spine, size_t index) noexcept {
+                return spine && index < spine->size ? spine->chunks[index / ChunkSize]->items() + index % ChunkSize
+                                                    : nullptr;
+            }
+
+            const Spine* spine_ = nullptr;
+            size_t index_ = 0;
+            const T* item_ = nullptr;
+        };
+
+    private:
+        std::pmr::memory_resource* resource_ = nullptr;  // null: ::operator new
+        Spine* spine_ = nullptr;
+
+        template <typename Node>
+        Node* make_node() const {
+            std::pmr::memory_resource* from = resource();
+            void* memory = from->allocate(sizeof(Node), alignof(Node));
+            try {
+                return new (memory) Node(from);
+            } catch (...) {
+                from->deallocate(memory, sizeof(Node), alignof(Node));
+                throw;
+            }
+        }
+
+        template <typename Node>
+        static void free_node(Node* node) noexcept {
+            std::pmr::memory_resource* from = node->resource;
+            node->~Node();
+            from->deallocate(node, sizeof(Node), alignof(Node));
+        }
+
+        template <typename Node>
+        static Node* acquire(Node* node) noexcept {
+            if (node) {
+                node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            return node;
+        }
+
+        // The acquire half of acq_rel orders the last owner's destruction
+        // after every other owner's reads
+        static void release(Chunk* chunk) noexcept {
+            if (chunk && chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                for (size_t i = 0; i < chunk->size; ++i) {
+                    chunk->items()[i].~T();
+                }
+                free_node(chunk);
+            }
+        }
+
+        static void release(Spine* spine) noexcept {
+            if (spine && spine->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                for (Chunk* chunk : spine->chunks) {
+                    release(chunk);
+                }
+                free_node(spine);
+            }
+        }
+
+        // A count of 1 read with acquire means every former co-owner has
+        // released, and its reads happen before our writes
+        template <typename Node>
+        static bool is_unique(const Node* node) noexcept {
+            return node->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        // Gives this vector its own spine: O(chunks) pointer copies, with
+        // every chunk still shared
+        void unique_spine() {
+            if (!spine_) {
+                spine_ = make_node<Spine>();
+                return;
+            }
+            if (is_unique(spine_)) {
+                return;
+            }
+            Spine* copy = make_node<Spine>();
+            copy->size = spine_->size;
+            copy->chunks.reserve(spine_->chunks.size());
+            for (Chunk* chunk : spine_->chunks) {
+                copy->chunks.push_back(acquire(chunk));
+            }
+            release(std::exchange(spine_, copy));
+        }
+
+        Chunk* unique_chunk(size_t index) {
+            unique_spine();
+            Chunk*& chunk = spine_->chunks[index];
+            if (is_unique(chunk)) {
+                return chunk;
+            }
+            Chunk* copy = make_node<Chunk>();
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memcpy(copy->storage, chunk->storage, chunk->size * sizeof(T));
+                copy->size = chunk->size;
+            } else {
+                try {
+                    for (; copy->size < chunk->size; ++copy->size) {
+                        new (copy->items() + copy->size) T(chunk->items()[copy->size]);
+                    }
+                } catch (...) {
+                    release(copy);
+                    throw;
+                }
+            }
+            release(std::exchange(chunk, copy));
+            return chunk;
+        }
+    };
+}
+
+#endif // CUSTOMVECTOR_COW_VECTOR_HPP
@@ -0,0 +1,102 @@
+#include "cow_vector.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// A publisher holds a large vector, hands out a snapshot, then edits a few
+// elements: deep copy of customvector::vector against cow_vector, where the
+// first edit after a snapshot clones the spine and one chunk per chunk
+// edited. The scan row shows what the chunk indirection costs a reader.
+TEST_CASE("Snapshot and update latency: cow_vector vs deep copy", "[benchmark][cow_vector]") {
+    constexpr std::size_t kRounds = 200;
+    constexpr std::size_t kEditsPerRound = 16;
+
+    for (std::size_t n : {std::size_t{1} << 12, std::size_t{1} << 17, std::size_t{1} << 22}) {
+        customvector::vector<std::uint64_t> base;
+        base.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            base.push_back(i);
+        }
+        customvector::cow_vector<std::uint64_t> cow(base);
+
+        std::mt19937_64 rng(n);
+        customvector::vector<std::size_t> edits;
+        for (std::size_t i = 0; i < kRounds * kEditsPerRound; ++i) {
+            edits.push_back(rng() % n);
+        }
+
+        auto time_us_per_round = [&](auto&& round) {
+            std::uint64_t checksum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t r = 0; r < kRounds; ++r) {
+                round(r, checksum);
+            }
+            const double us =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kRounds;
+            return std::pair{us, checksum};
+        };
+
+        const auto [deep_snapshot_us, deep_snapshot_sum] = time_us_per_round([&](std::size_t, std::uint64_t& sum) {
+            customvector::vector<std::uint64_t> copy(base);
+            sum += copy[sum % n];
+        });
+        const auto [cow_snapshot_us, cow_snapshot_sum] = time_us_per_round([&](std::size_t, std::uint64_t& sum) {
+            auto copy = cow.snapshot();
+            sum += copy[sum % n];
+        });
+
+        // Snapshot for readers, then the writer applies a batch of edits
+        const auto [deep_update_us, deep_update_sum] = time_us_per_round([&](std::size_t r, std::uint64_t& sum) {
+            customvector::vector<std::uint64_t> published(base);
+            for (std::size_t e = 0; e < kEditsPerRound; ++e) {
+                base[edits[r * kEditsPerRound + e]] += 1;
+            }
+            sum += published[edits[r * kEditsPerRound]];
+        });
+        const auto [cow_update_us, cow_update_sum] = time_us_per_round([&](std::size_t r, std::uint64_t& sum) {
+            auto published = cow.snapshot();
+            for (std::size_t e = 0; e < kEditsPerRound; ++e) {
+                cow.write_at(edits[r * kEditsPerRound + e]) += 1;
+            }
+            sum += published[edits[r * kEditsPerRound]];
+        });
+
+        const auto [vector_scan_us, vector_scan_sum] = time_us_per_round([&](std::size_t, std::uint64_t& sum) {
+            for (auto value : base) {
+                sum += value;
+            }
+        });
+        const auto [cow_scan_us, cow_scan_sum] = time_us_per_round([&](std::size_t, std::uint64_t& sum) {
+            for (auto value : cow) {
+                sum += value;
+            }
+        });
+        const auto [chunk_scan_us, chunk_scan_sum] = time_us_per_round([&](std::size_t, std::uint64_t& sum) {
+            for (std::size_t c = 0; c < cow.chunk_count(); ++c) {
+                for (auto value : cow.chunk(c)) {
+                    sum += value;
+                }
+            }
+        });
+
+        REQUIRE(deep_snapshot_sum == cow_snapshot_sum);
+        REQUIRE(deep_update_sum == cow_update_sum);
+        REQUIRE(vector_scan_sum == cow_scan_sum);
+        REQUIRE(vector_scan_sum == chunk_scan_sum);
+
+        std::cout << "\n" << n << " x uint64 (" << n * sizeof(std::uint64_t) / 1024 << " KiB), "
+                  << customvector::cow_vector<std::uint64_t>::kChunkSize << "-element chunks\n"
+                  << std::fixed << std::setprecision(2)
+                  << "  snapshot            deep copy " << std::setw(10) << deep_snapshot_us
+                  << " us   cow_vector " << std::setw(8) << cow_snapshot_us << " us\n"
+                  << "  snapshot + " << kEditsPerRound << " edits deep copy " << std::setw(10) << deep_update_us
+                  << " us   cow_vector " << std::setw(8) << cow_update_us << " us\n"
+                  << "  full scan           vector    " << std::setw(10) << vector_scan_us
+                  << " us   cow_vector " << std::setw(8) << cow_scan_us << " us (iterator), " << chunk_scan_us
+                  << " us (chunks)\n";
+    }
+}
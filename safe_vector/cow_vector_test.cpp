@@ -0,0 +1,184 @@
+#include <catch_amalgamated.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "arena.h"
+#include "cow_vector.hpp"
+using customvector::cow_vector;
+
+TEST_CASE("cow_vector push_back, pop_back and element access", "[cow_vector]") {
+    cow_vector<int, 4> v;
+    REQUIRE(v.empty());
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i * 10);
+    }
+
+    REQUIRE(v.size() == 10);
+    REQUIRE(v[0] == 0);
+    REQUIRE(v.at(9) == 90);
+    REQUIRE_THROWS_AS(v.at(10), std::out_of_range);
+    REQUIRE_THROWS_AS(v.write_at(10), std::out_of_range);
+
+    v.set(5, -5);
+    v.write_at(6) += 1;
+    REQUIRE(v[5] == -5);
+    REQUIRE(v[6] == 61);
+
+    for (int i = 0; i < 6; ++i) {
+        v.pop_back();
+    }
+    REQUIRE(v.size() == 4);
+    REQUIRE(v[3] == 30);
+    v.push_back(99);
+    REQUIRE(v[4] == 99);
+
+    int expected[] = {0, 10, 20, 30, 99};
+    REQUIRE(std::equal(v.begin(), v.end(), std::begin(expected), std::end(expected)));
+    REQUIRE(v.chunk_count() == 2);
+    REQUIRE(v.chunk(0).size() == 4);
+    REQUIRE(v.chunk(1).size() == 1);
+    REQUIRE(v.chunk(1)[0] == 99);
+
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE_THROWS_AS(v.pop_back(), std::out_of_range);
+}
+
+TEST_CASE("cow_vector snapshots share buffers until written", "[cow_vector]") {
+    customvector::vector<std::string> items;
+    for (int i = 0; i < 12; ++i) {
+        items.push_back("item" + std::to_string(i));
+    }
+    cow_vector<std::string, 4> writer(items);
+    const auto snapshot = writer.snapshot();
+
+    // Same storage until the first write
+    REQUIRE(&snapshot[0] == &writer[0]);
+    REQUIRE(&snapshot[11] == &writer[11]);
+
+    writer.set(5, "edited");
+    REQUIRE(snapshot[5] == "item5");
+    REQUIRE(writer[5] == "edited");
+
+    // Only the chunk holding element 5 was cloned
+    REQUIRE(&snapshot[5] != &writer[5]);
+    REQUIRE(&snapshot[4] != &writer[4]);
+    REQUIRE(&snapshot[3] == &writer[3]);
+    REQUIRE(&snapshot[8] == &writer[8]);
+
+    // A second write to the now-private chunk does not copy again
+    const std::string* cloned = &writer[4];
+    writer.set(4, "again");
+    REQUIRE(&writer[4] == cloned);
+
+    writer.push_back("tail");
+    writer.pop_back();
+    writer.pop_back();
+    REQUIRE(snapshot.size() == 12);
+    REQUIRE(snapshot[11] == "item11");
+    REQUIRE(writer.size() == 11);
+}
+
+TEST_CASE("cow_vector copies stay independent under random edits", "[cow_vector]") {
+    std::mt19937 rng(3);
+    cow_vector<int, 8> v;
+    std::vector<int> reference;
+    std::vector<std::pair<cow_vector<int, 8>, std::vector<int>>> snapshots;
+
+    for (int step = 0; step < 5000; ++step) {
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            v.push_back(step);
+            reference.push_back(step);
+            break;
+        case 2:
+            if (!reference.empty()) {
+                const size_t index = rng() % reference.size();
+                v.set(index, -step);
+                reference[index] = -step;
+            }
+            break;
+        default:
+            if (!reference.empty()) {
+                v.pop_back();
+                reference.pop_back();
+            }
+        }
+        if (step % 250 == 0) {
+            snapshots.emplace_back(v.snapshot(), reference);
+        }
+    }
+
+    REQUIRE(std::equal(v.begin(), v.end(), reference.begin(), reference.end()));
+    for (const auto& [snapshot, expected] : snapshots) {
+        REQUIRE(std::equal(snapshot.begin(), snapshot.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST_CASE("cow_vector snapshots are stable while the writer edits", "[cow_vector]") {
+    constexpr int kSize = 20000;
+    constexpr int kReaders = 4;
+    cow_vector<long> writer;
+    for (int i = 0; i < kSize; ++i) {
+        writer.push_back(0);
+    }
+
+    // Each version has every element equal to the version number, so a
+    // reader can tell a torn snapshot from a consistent one
+    std::vector<cow_vector<long>> published(kReaders, writer.snapshot());
+    std::vector<std::thread> readers;
+    std::vector<int> torn(kReaders, 0);
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&, r, snapshot = published[r]]() {
+            const long version = snapshot[0];
+            for (long value : snapshot) {
+                torn[r] += value != version;
+            }
+        });
+    }
+    for (long version = 1; version <= 3; ++version) {
+        for (int i = 0; i < kSize; ++i) {
+            writer.set(i, version);
+        }
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (int r = 0; r < kReaders; ++r) {
+        REQUIRE(torn[r] == 0);
+        REQUIRE(published[r][kSize - 1] == 0);
+    }
+    REQUIRE(writer[kSize / 2] == 3);
+}
+
+TEST_CASE("cow_vector allocates from a memory resource", "[cow_vector][resource]") {
+    arena::MonotonicArena arena;
+    {
+        cow_vector<std::string, 4> names(&arena);
+        REQUIRE(names.resource() == &arena);
+        for (int i = 0; i < 20; ++i) {
+            names.push_back("name-" + std::to_string(i));
+        }
+        const std::size_t used = arena.bytes_used();
+        REQUIRE(used > 0);
+
+        // A snapshot shares the buffers and the resource; its first write
+        // copies one chunk and the spine into the same resource
+        auto snapshot = names.snapshot();
+        REQUIRE(snapshot.resource() == &arena);
+        REQUIRE(arena.bytes_used() == used);
+        snapshot.set(5, "changed");
+        REQUIRE(arena.bytes_used() > used);
+        REQUIRE(names[5] == "name-5");
+        REQUIRE(snapshot[5] == "changed");
+
+        cow_vector<std::string, 4> heap_names;
+        heap_names = snapshot;
+        REQUIRE(heap_names.resource() == &arena);
+        REQUIRE(heap_names[19] == "name-19");
+    }
+    REQUIRE(cow_vector<int>().resource() == std::pmr::new_delete_resource());
+}
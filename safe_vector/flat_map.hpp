@@ -0,0 +1,208 @@
+#ifndef CUSTOMVECTOR_FLAT_MAP_HPP
+#define CUSTOMVECTOR_FLAT_MAP_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace customvector {
+    using std::invalid_argument;
+
+    // Index of the first element of sorted [first, first + count) not less
+    // than key. The loop runs a fixed log2(count) steps and the step choice
+    // is a conditional move, so there is no branch to mispredict; both
+    // candidates for the next probe are prefetched.
+    template <typename Key, typename Compare>
+    [[nodiscard]] size_t branchless_lower_bound(const Key* first, size_t count, const Key& key,
+                                                Compare comp) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        const Key* base = first;
+        while (count > 1) {
+            const size_t half = count / 2;
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+            base = comp(base[half], key) ? base + half : base;
+            count -= half;
+        }
+        return static_cast<size_t>(base - first) + (comp(*base, key) ? 1 : 0);
+    }
+
+    // Sorted set in one contiguous key array. Lookups are O(log n) with
+    // branchless_lower_bound; insert and erase shift the tail, so the type
+    // suits read-mostly sets of up to a few thousand keys. Construction from
+    // a bulk vector sorts and deduplicates once and keeps that vector's
+    // memory resource.
+    template <typename Key, typename Compare = std::less<Key>>
+        requires destructible<Key>
+    class flat_set {
+    public:
+        flat_set() = default;
+
+        explicit flat_set(std::pmr::memory_resource* resource, Compare comp = Compare())
+            : keys_(resource), comp_(comp) {}
+
+        explicit flat_set(vector<Key> keys, Compare comp = Compare())
+            : keys_(std::move(keys)), comp_(comp) {
+            std::sort(keys_.begin(), keys_.end(), comp_);
+            auto* last = std::unique(keys_.begin(), keys_.end(), [this](const Key& a, const Key& b) {
+                return !comp_(a, b) && !comp_(b, a);
+            });
+            while (keys_.end() != last) {
+                keys_.pop_back();
+            }
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const noexcept {
+            const size_t index = lower_bound_index(key);
+            return index < keys_.size() && !comp_(key, keys_[index]);
+        }
+
+        // False if the key was already present
+        bool insert(const Key& key) {
+            const size_t index = lower_bound_index(key);
+            if (index < keys_.size() && !comp_(key, keys_[index])) {
+                return false;
+            }
+            keys_.insert(index, key);
+            return true;
+        }
+
+        bool erase(const Key& key) {
+            const size_t index = lower_bound_index(key);
+            if (index == keys_.size() || comp_(key, keys_[index])) {
+                return false;
+            }
+            keys_.erase(index);
+            return true;
+        }
+
+        [[nodiscard]] size_t lower_bound_index(const Key& key) const noexcept {
+            return branchless_lower_bound(keys_.data(), keys_.size(), key, comp_);
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return keys_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+        [[nodiscard]] const vector<Key>& keys() const noexcept { return keys_; }
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept { return keys_.resource(); }
+
+        [[nodiscard]] const Key* begin() const noexcept { return keys_.begin(); }
+        [[nodiscard]] const Key* end() const noexcept { return keys_.end(); }
+
+    private:
+        vector<Key> keys_;
+        [[no_unique_address]] Compare comp_;
+    };
+
+    // Sorted map with keys and values in separate arrays: the search touches
+    // only the key array (more keys per cache line), and the value at the
+    // same index is read once on a hit. Same costs as flat_set otherwise.
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+        requires destructible<Key> && destructible<Value>
+    class flat_map {
+    public:
+        flat_map() = default;
+
+        // Both arrays allocate from resource
+        explicit flat_map(std::pmr::memory_resource* resource, Compare comp = Compare())
+            : keys_(resource), values_(resource), comp_(comp) {}
+
+        // Bulk construction: sorts once and keeps the last value given for
+        // a repeated key, as a sequence of insert_or_assign calls would.
+        // Each array is rebuilt in the resource of the vector it came from.
+        flat_map(vector<Key> keys, vector<Value> values, Compare comp = Compare());
+
+        [[nodiscard]] Value* find(const Key& key) noexcept {
+            const size_t index = lower_bound_index(key);
+            return index < keys_.size() && !comp_(key, keys_[index]) ? &values_[index] : nullptr;
+        }
+
+        [[nodiscard]] const Value* find(const Key& key) const noexcept {
+            const size_t index = lower_bound_index(key);
+            return index < keys_.size() && !comp_(key, keys_[index]) ? &values_[index] : nullptr;
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const noexcept { return find(key) != nullptr; }
+
+        // True if the key was inserted, false if its value was replaced
+        template <typename V>
+        bool insert_or_assign(const Key& key, V&& value) {
+            const size_t index = lower_bound_index(key);
+            if (index < keys_.size() && !comp_(key, keys_[index])) {
+                values_[index] = std::forward<V>(value);
+                return false;
+            }
+            values_.insert(index, Value(std::forward<V>(value)));
+            try {
+                keys_.insert(index, key);
+            } catch (...) {
+                values_.erase(index);
+                throw;
+            }
+            return true;
+        }
+
+        bool erase(const Key& key) {
+            const size_t index = lower_bound_index(key);
+            if (index == keys_.size() || comp_(key, keys_[index])) {
+                return false;
+            }
+            keys_.erase(index);
+            values_.erase(index);
+            return true;
+        }
+
+        [[nodiscard]] size_t lower_bound_index(const Key& key) const noexcept {
+            return branchless_lower_bound(keys_.data(), keys_.size(), key, comp_);
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return keys_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+        // Parallel arrays in key order
+        [[nodiscard]] const vector<Key>& keys() const noexcept { return keys_; }
+        [[nodiscard]] const vector<Value>& values() const noexcept { return values_; }
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept { return keys_.resource(); }
+
+    private:
+        vector<Key> keys_;
+        vector<Value> values_;
+        [[no_unique_address]] Compare comp_;
+    };
+
+    template <typename Key, typename Value, typename Compare>
+        requires destructible<Key> && destructible<Value>
+    flat_map<Key, Value, Compare>::flat_map(vector<Key> keys, vector<Value> values, Compare comp)
+        : keys_(keys.resource()), values_(values.resource()), comp_(comp) {
+        if (keys.size() != values.size()) {
+            throw invalid_argument("customvector::flat_map - key and value counts differ");
+        }
+
+        // Sort a permutation so each key and value is moved exactly once
+        vector<size_t> order;
+        order.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            order.push_back(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return comp_(keys[a], keys[b]);
+        });
+
+        keys_.reserve(keys.size());
+        values_.reserve(values.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            // Within a run of equal keys the stable sort kept input order
+            if (i + 1 < order.size() && !comp_(keys[order[i]], keys[order[i + 1]])) {
+                continue;
+            }
+            keys_.push_back(std::move(keys[order[i]]));
+            values_.push_back(std::move(values[order[i]]));
+        }
+    }
+}
+
+#endif // CUSTOMVECTOR_FLAT_MAP_HPP
@@ -0,0 +1,158 @@
+#include <catch_amalgamated.hpp>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include "arena.h"
+#include "flat_map.hpp"
+using customvector::flat_map;
+using customvector::flat_set;
+using customvector::vector;
+
+TEST_CASE("branchless_lower_bound matches std::lower_bound", "[flat_map]") {
+    vector<int> sorted;
+    for (int i = 0; i < 100; ++i) {
+        sorted.push_back(i * 2);
+    }
+
+    for (std::size_t count : {0u, 1u, 2u, 3u, 7u, 64u, 100u}) {
+        for (int key = -1; key <= 201; ++key) {
+            const auto expected = std::lower_bound(sorted.begin(), sorted.begin() + count, key) - sorted.begin();
+            REQUIRE(customvector::branchless_lower_bound(sorted.data(), count, key, std::less<int>()) ==
+                    static_cast<std::size_t>(expected));
+        }
+    }
+}
+
+TEST_CASE("flat_set bulk construction sorts and deduplicates", "[flat_map]") {
+    vector<int> keys;
+    for (int key : {5, 3, 9, 3, 1, 9, 7}) {
+        keys.push_back(key);
+    }
+    flat_set<int> set(std::move(keys));
+
+    REQUIRE(set.size() == 5);
+    int expected[] = {1, 3, 5, 7, 9};
+    REQUIRE(std::equal(set.begin(), set.end(), std::begin(expected)));
+    REQUIRE(set.contains(7));
+    REQUIRE_FALSE(set.contains(4));
+
+    REQUIRE(set.insert(4));
+    REQUIRE_FALSE(set.insert(4));
+    REQUIRE(set.erase(1));
+    REQUIRE_FALSE(set.erase(1));
+    REQUIRE(set.keys().at(0) == 3);
+    REQUIRE(set.keys().at(1) == 4);
+}
+
+TEST_CASE("flat_map bulk construction keeps the last value for a repeated key", "[flat_map]") {
+    vector<std::string> keys;
+    vector<int> values;
+    for (auto [key, value] : {std::pair{"b", 1}, {"a", 2}, {"b", 3}, {"c", 4}, {"a", 5}}) {
+        keys.push_back(key);
+        values.push_back(value);
+    }
+    flat_map<std::string, int> map(std::move(keys), std::move(values));
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.keys().at(0) == "a");
+    REQUIRE(map.keys().at(2) == "c");
+    REQUIRE(*map.find("a") == 5);
+    REQUIRE(*map.find("b") == 3);
+    REQUIRE(map.find("d") == nullptr);
+
+    SECTION("mismatched arrays throw") {
+        vector<std::string> one_key;
+        one_key.push_back("x");
+        REQUIRE_THROWS_AS((flat_map<std::string, int>(std::move(one_key), vector<int>())), std::invalid_argument);
+    }
+}
+
+TEST_CASE("flat_map insert_or_assign and erase keep arrays in step", "[flat_map]") {
+    flat_map<int, std::string, std::greater<int>> map;
+    REQUIRE(map.insert_or_assign(2, "two"));
+    REQUIRE(map.insert_or_assign(5, "five"));
+    REQUIRE(map.insert_or_assign(3, "three"));
+    REQUIRE_FALSE(map.insert_or_assign(5, "FIVE"));
+
+    // Descending order under std::greater
+    REQUIRE(map.keys().at(0) == 5);
+    REQUIRE(map.values().at(0) == "FIVE");
+    REQUIRE(map.values().at(1) == "three");
+
+    REQUIRE(map.erase(3));
+    REQUIRE_FALSE(map.erase(3));
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.values().at(1) == "two");
+}
+
+TEST_CASE("flat_map agrees with std::map under random operations", "[flat_map]") {
+    flat_map<int, int> map;
+    std::map<int, int> reference;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 20000; ++step) {
+        const int key = static_cast<int>(rng() % 500);
+        switch (rng() % 3) {
+        case 0:
+            REQUIRE(map.insert_or_assign(key, step) == !reference.contains(key));
+            reference[key] = step;
+            break;
+        case 1:
+            REQUIRE(map.erase(key) == (reference.erase(key) == 1));
+            break;
+        default: {
+            const int* found = map.find(key);
+            auto it = reference.find(key);
+            REQUIRE((found != nullptr) == (it != reference.end()));
+            if (found != nullptr) {
+                REQUIRE(*found == it->second);
+            }
+        }
+        }
+    }
+
+    REQUIRE(map.size() == reference.size());
+    std::size_t i = 0;
+    for (const auto& [key, value] : reference) {
+        REQUIRE(map.keys().at(i) == key);
+        REQUIRE(map.values().at(i) == value);
+        ++i;
+    }
+}
+
+TEST_CASE("flat_set and flat_map allocate from a memory resource", "[flat_map][resource]") {
+    arena::MonotonicArena arena;
+    {
+        flat_map<int, std::string> map(&arena);
+        REQUIRE(map.resource() == &arena);
+        const std::size_t before = arena.bytes_used();
+        for (int i = 0; i < 100; ++i) {
+            map.insert_or_assign(i, std::to_string(i));
+        }
+        REQUIRE(arena.bytes_used() > before);
+        REQUIRE(*map.find(42) == "42");
+
+        // Bulk construction keeps the arrays in the resource they came from
+        vector<int> keys(&arena);
+        vector<int> values(&arena);
+        for (int i = 50; i > 0; --i) {
+            keys.push_back(i % 20);
+            values.push_back(i);
+        }
+        flat_map<int, int> bulk(std::move(keys), std::move(values));
+        REQUIRE(bulk.resource() == &arena);
+        REQUIRE(bulk.values().resource() == &arena);
+        REQUIRE(bulk.size() == 20);
+        REQUIRE(*bulk.find(0) == 20);
+
+        flat_set<int> set(&arena);
+        for (int i = 0; i < 100; ++i) {
+            set.insert(99 - i);
+        }
+        REQUIRE(set.resource() == &arena);
+        REQUIRE(set.keys()[0] == 0);
+    }
+    REQUIRE(flat_map<int, int>().resource() == std::pmr::new_delete_resource());
+}
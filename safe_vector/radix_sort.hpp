@@ -0,0 +1,239 @@
+#ifndef CUSTOMVECTOR_RADIX_SORT_HPP
+#define CUSTOMVECTOR_RADIX_SORT_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+namespace customvector {
+
+    // Keys the radix sorts accept: integers and floating point, ordered as
+    // operator< orders them (NaNs go to the ends by sign bit)
+    template <typename K>
+    concept RadixKey = (std::integral<K> || std::floating_point<K>) && !std::same_as<K, bool>;
+
+    template <typename T>
+    concept RadixSortable = std::movable<T> && std::default_initializable<T>;
+
+    namespace radix_detail {
+        // Below this a comparison sort wins over the fixed cost of the passes
+        inline constexpr size_t kSmallSort = 256;
+
+        // 11-bit digits for 32- and 64-bit keys: six passes instead of
+        // eight for a 64-bit key, and the 2048 counters still fit in L1
+        template <typename Key>
+        struct Digits {
+            static constexpr size_t bits = sizeof(Key) >= 4 ? 11 : 8;
+            static constexpr size_t buckets = size_t{1} << bits;
+            static constexpr size_t passes = (sizeof(Key) * 8 + bits - 1) / bits;
+            using Histogram = std::array<size_t, buckets>;
+        };
+
+        // Maps a key to an unsigned integer with the same order
+        template <RadixKey K>
+        constexpr auto ordered_bits(K key) noexcept {
+            if constexpr (std::floating_point<K>) {
+                using Bits = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+                const auto bits = std::bit_cast<Bits>(key);
+                constexpr Bits sign = Bits{1} << (sizeof(Bits) * 8 - 1);
+                // Negative: flip everything so larger magnitudes sort first
+                return (bits & sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+            } else {
+                using Bits = std::make_unsigned_t<K>;
+                if constexpr (std::is_signed_v<K>) {
+                    return static_cast<Bits>(static_cast<Bits>(key) ^ (Bits{1} << (sizeof(Bits) * 8 - 1)));
+                } else {
+                    return static_cast<Bits>(key);
+                }
+            }
+        }
+
+        template <typename Key, typename T, typename KeyFn>
+        size_t digit_of(const T& element, KeyFn& key, size_t pass) noexcept {
+            using D = Digits<Key>;
+            return static_cast<size_t>(ordered_bits(std::invoke(key, element)) >> (pass * D::bits)) & (D::buckets - 1);
+        }
+
+        // The digit histograms do not depend on element order, so one read
+        // decides up front which passes would leave everything in one bucket
+        template <typename Key, typename T, typename KeyFn>
+        vector<size_t> passes_needed(const T* data, size_t n, KeyFn& key) {
+            using D = Digits<Key>;
+            vector<typename D::Histogram> counts;
+            for (size_t pass = 0; pass < D::passes; ++pass) {
+                counts.emplace_back();
+                counts[pass].fill(0);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const auto bits = ordered_bits(std::invoke(key, data[i]));
+                for (size_t pass = 0; pass < D::passes; ++pass) {
+                    ++counts[pass][static_cast<size_t>(bits >> (pass * D::bits)) & (D::buckets - 1)];
+                }
+            }
+            vector<size_t> passes;
+            for (size_t pass = 0; pass < D::passes; ++pass) {
+                if (std::ranges::find(counts[pass], n) == counts[pass].end()) {
+                    passes.push_back(pass);
+                }
+            }
+            return passes;
+        }
+
+        // From data's own resource: after an odd number of passes the
+        // scratch buffer becomes data's storage
+        template <typename T>
+        vector<T> scratch_for(const vector<T>& data) {
+            const size_t n = data.size();
+            vector<T> scratch(data.resource());
+            scratch.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                scratch.emplace_back();
+            }
+            return scratch;
+        }
+    }
+
+    // Stable LSD radix sort by key(element), one digit per pass. Uses one
+    // scratch vector the size of data; after an odd number of passes the
+    // sorted elements end up in it and the two vectors trade buffers, so
+    // nothing is copied back. Passes whose digit is the same for every key
+    // are skipped.
+    template <RadixSortable T, typename KeyFn = std::identity>
+        requires RadixKey<std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>>
+    void radix_sort(vector<T>& data, KeyFn key = {}) {
+        using Key = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+        using D = radix_detail::Digits<Key>;
+        const size_t n = data.size();
+
+        if (n < radix_detail::kSmallSort) {
+            std::stable_sort(data.begin(), data.end(), [&](const T& a, const T& b) {
+                return radix_detail::ordered_bits(std::invoke(key, a)) < radix_detail::ordered_bits(std::invoke(key, b));
+            });
+            return;
+        }
+
+        const auto passes = radix_detail::passes_needed<Key>(data.data(), n, key);
+        if (passes.empty()) {
+            return;
+        }
+
+        auto scratch = radix_detail::scratch_for(data);
+        T* src = data.data();
+        T* dst = scratch.data();
+        for (size_t pass : passes) {
+            typename D::Histogram offsets{};
+            for (size_t i = 0; i < n; ++i) {
+                ++offsets[radix_detail::digit_of<Key>(src[i], key, pass)];
+            }
+            size_t running = 0;
+            for (auto& offset : offsets) {
+                running += std::exchange(offset, running);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                dst[offsets[radix_detail::digit_of<Key>(src[i], key, pass)]++] = std::move(src[i]);
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != data.data()) {
+            data = std::move(scratch);
+        }
+    }
+
+    // radix_sort split over threads (hardware_concurrency() when 0). Each
+    // pass, every thread histograms its own slice; the per-thread counts
+    // are prefix-summed digit-major, thread-minor, which gives each thread
+    // a disjoint output range per digit, and the threads then scatter their
+    // slices without synchronizing. Stable, like radix_sort.
+    template <RadixSortable T, typename KeyFn = std::identity>
+        requires RadixKey<std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>>
+    void parallel_radix_sort(vector<T>& data, KeyFn key = {}, size_t threads = 0) {
+        using Key = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+        using D = radix_detail::Digits<Key>;
+        // Slices smaller than this do not repay a thread
+        constexpr size_t kMinSlice = size_t{1} << 16;
+        const size_t n = data.size();
+
+        if (threads == 0) {
+            threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+        threads = std::min(threads, std::max<size_t>(n / kMinSlice, 1));
+        if (threads == 1) {
+            radix_sort(data, key);
+            return;
+        }
+
+        const auto passes = radix_detail::passes_needed<Key>(data.data(), n, key);
+        if (passes.empty()) {
+            return;
+        }
+
+        auto scratch = radix_detail::scratch_for(data);
+        T* src = data.data();
+        T* dst = scratch.data();
+        vector<typename D::Histogram> counts;
+        for (size_t t = 0; t < threads; ++t) {
+            counts.emplace_back();
+        }
+        size_t pass_index = 0;
+
+        // Runs on one thread between phases: turn the counts into offsets,
+        // or after a scatter, flip the buffers and move to the next pass
+        bool scattering = false;
+        std::barrier sync(static_cast<std::ptrdiff_t>(threads), [&]() noexcept {
+            if (!scattering) {
+                size_t running = 0;
+                for (size_t digit = 0; digit < D::buckets; ++digit) {
+                    for (size_t t = 0; t < threads; ++t) {
+                        running += std::exchange(counts[t][digit], running);
+                    }
+                }
+            } else {
+                std::swap(src, dst);
+                ++pass_index;
+            }
+            scattering = !scattering;
+        });
+
+        auto work = [&](size_t t) {
+            const size_t begin = n * t / threads;
+            const size_t end = n * (t + 1) / threads;
+            while (pass_index < passes.size()) {
+                const size_t pass = passes[pass_index];
+                auto& local = counts[t];
+                local.fill(0);
+                for (size_t i = begin; i < end; ++i) {
+                    ++local[radix_detail::digit_of<Key>(src[i], key, pass)];
+                }
+                sync.arrive_and_wait();
+                for (size_t i = begin; i < end; ++i) {
+                    dst[local[radix_detail::digit_of<Key>(src[i], key, pass)]++] = std::move(src[i]);
+                }
+                sync.arrive_and_wait();
+            }
+        };
+
+        {
+            vector<std::jthread> workers;
+            workers.reserve(threads - 1);
+            for (size_t t = 1; t < threads; ++t) {
+                workers.emplace_back(work, t);
+            }
+            work(0);
+        }
+
+        if (src != data.data()) {
+            data = std::move(scratch);
+        }
+    }
+}
+
+#endif // CUSTOMVECTOR_RADIX_SORT_HPP
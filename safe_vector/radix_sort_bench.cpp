@@ -0,0 +1,59 @@
+#include "radix_sort.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace {
+    template <typename T, typename Sort>
+    double time_ms(const customvector::vector<T>& input, Sort sort) {
+        customvector::vector<T> data(input);
+        const auto start = std::chrono::steady_clock::now();
+        sort(data);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        REQUIRE(data.size() == input.size());
+        return ms;
+    }
+
+    template <typename T, typename KeyFn>
+    void compare_sorts(const char* title, const customvector::vector<T>& input, KeyFn key) {
+        auto less = [&](const T& a, const T& b) { return key(a) < key(b); };
+        std::cout << "\n" << title << ", " << input.size() << " elements\n" << std::fixed << std::setprecision(1)
+                  << "  std::sort             " << std::setw(8)
+                  << time_ms(input, [&](auto& d) { std::sort(d.begin(), d.end(), less); }) << " ms\n"
+                  << "  std::stable_sort      " << std::setw(8)
+                  << time_ms(input, [&](auto& d) { std::stable_sort(d.begin(), d.end(), less); }) << " ms\n"
+                  << "  radix_sort            " << std::setw(8)
+                  << time_ms(input, [&](auto& d) { customvector::radix_sort(d, key); }) << " ms\n"
+                  << "  parallel_radix_sort   " << std::setw(8)
+                  << time_ms(input, [&](auto& d) { customvector::parallel_radix_sort(d, key); }) << " ms  ("
+                  << std::thread::hardware_concurrency() << " hardware threads)\n";
+    }
+}
+
+TEST_CASE("Radix sort vs comparison sorts", "[benchmark][radix_sort]") {
+    constexpr std::size_t kElements = 10'000'000;
+    std::mt19937_64 rng(1);
+
+    customvector::vector<std::uint64_t> keys;
+    customvector::vector<std::pair<std::uint64_t, std::uint64_t>> records;
+    customvector::vector<double> reals;
+    std::normal_distribution<double> normal(0.0, 1e3);
+    keys.reserve(kElements);
+    records.reserve(kElements);
+    reals.reserve(kElements);
+    for (std::size_t i = 0; i < kElements; ++i) {
+        keys.push_back(rng());
+        records.push_back({rng(), i});
+        reals.push_back(normal(rng));
+    }
+
+    compare_sorts("uint64_t keys", keys, std::identity());
+    compare_sorts("(uint64_t key, uint64_t payload) by key", records, [](const auto& r) { return r.first; });
+    compare_sorts("double keys", reals, std::identity());
+}
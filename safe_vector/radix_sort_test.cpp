@@ -0,0 +1,118 @@
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include "arena.h"
+#include "radix_sort.hpp"
+using customvector::vector;
+
+namespace {
+    template <typename T, typename Less>
+    void require_same_as_stable_sort(vector<T> actual, vector<T> expected, Less less) {
+        std::stable_sort(expected.begin(), expected.end(), less);
+        REQUIRE(actual.size() == expected.size());
+        REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin()));
+    }
+}
+
+TEST_CASE("radix_sort orders unsigned and signed integers", "[radix_sort]") {
+    std::mt19937_64 rng(11);
+    for (std::size_t n : {0u, 1u, 100u, 255u, 256u, 5000u, 200000u}) {
+        vector<std::uint64_t> unsigned_keys;
+        vector<std::int32_t> signed_keys;
+        for (std::size_t i = 0; i < n; ++i) {
+            unsigned_keys.push_back(rng());
+            signed_keys.push_back(static_cast<std::int32_t>(rng()));
+        }
+        signed_keys.push_back(std::numeric_limits<std::int32_t>::min());
+        signed_keys.push_back(std::numeric_limits<std::int32_t>::max());
+
+        auto sorted_unsigned = unsigned_keys;
+        customvector::radix_sort(sorted_unsigned);
+        require_same_as_stable_sort(std::move(sorted_unsigned), std::move(unsigned_keys), std::less<>());
+
+        auto sorted_signed = signed_keys;
+        customvector::radix_sort(sorted_signed);
+        require_same_as_stable_sort(std::move(sorted_signed), std::move(signed_keys), std::less<>());
+    }
+}
+
+TEST_CASE("radix_sort orders floating point keys", "[radix_sort]") {
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> spread(-1e6, 1e6);
+    vector<double> values;
+    for (int i = 0; i < 10000; ++i) {
+        values.push_back(spread(rng));
+    }
+    for (double special : {0.0, -0.0, 1e-300, -1e-300, std::numeric_limits<double>::infinity(),
+                           -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max()}) {
+        values.push_back(special);
+    }
+
+    customvector::radix_sort(values);
+    REQUIRE(std::is_sorted(values.begin(), values.end()));
+    REQUIRE(values.front() == -std::numeric_limits<double>::infinity());
+    REQUIRE(values.back() == std::numeric_limits<double>::infinity());
+
+    vector<float> floats;
+    for (int i = 0; i < 3000; ++i) {
+        floats.push_back(static_cast<float>(spread(rng)));
+    }
+    customvector::radix_sort(floats);
+    REQUIRE(std::is_sorted(floats.begin(), floats.end()));
+}
+
+TEST_CASE("radix_sort by key is stable for key/payload pairs", "[radix_sort]") {
+    std::mt19937_64 rng(2);
+    vector<std::pair<std::int64_t, std::uint32_t>> records;
+    for (std::uint32_t i = 0; i < 50000; ++i) {
+        records.push_back({static_cast<std::int64_t>(rng() % 1000) - 500, i});
+    }
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+
+    SECTION("single thread") {
+        auto sorted = records;
+        customvector::radix_sort(sorted, &std::pair<std::int64_t, std::uint32_t>::first);
+        require_same_as_stable_sort(std::move(sorted), std::move(records), by_key);
+    }
+
+    SECTION("parallel, more threads than slices") {
+        auto sorted = records;
+        customvector::parallel_radix_sort(sorted, [](const auto& r) { return r.first; }, 16);
+        require_same_as_stable_sort(std::move(sorted), std::move(records), by_key);
+    }
+}
+
+TEST_CASE("parallel_radix_sort matches std::stable_sort", "[radix_sort]") {
+    std::mt19937_64 rng(9);
+    vector<std::uint64_t> keys;
+    for (int i = 0; i < 600000; ++i) {
+        // Top bytes constant: those passes are skipped
+        keys.push_back(rng() & 0xffffffffffull);
+    }
+    for (std::size_t threads : {2u, 3u, 4u}) {
+        auto sorted = keys;
+        customvector::parallel_radix_sort(sorted, std::identity(), threads);
+        require_same_as_stable_sort(std::move(sorted), keys, std::less<>());
+    }
+}
+
+TEST_CASE("radix_sort keeps the vector in its memory resource", "[radix_sort][resource]") {
+    // Random 32-bit keys take three 11-bit passes, so the sorted elements
+    // land in the scratch buffer, which must come from the same arena
+    arena::MonotonicArena arena;
+    std::mt19937 rng(23);
+    for (const std::size_t threads : {1, 2}) {
+        vector<std::uint32_t> values(&arena);
+        for (std::size_t i = 0; i < (std::size_t{1} << 18); ++i) {
+            values.push_back(static_cast<std::uint32_t>(rng()));
+        }
+        vector<std::uint32_t> expected(values);
+
+        customvector::parallel_radix_sort(values, std::identity{}, threads);
+        REQUIRE(values.resource() == &arena);
+        require_same_as_stable_sort(values, expected, std::less<>{});
+    }
+}
@@ -0,0 +1,172 @@
+#ifndef CUSTOMVECTOR_SEARCH_INDEX_HPP
+#define CUSTOMVECTOR_SEARCH_INDEX_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace customvector {
+    using std::invalid_argument;
+
+    // Read-only lower_bound index over a sorted array of numeric keys, laid
+    // out as a static B+ tree ("S+ tree") with one cache line per node.
+    //
+    // The bottom layer is the sorted keys themselves, padded with the
+    // largest value of Key (+inf for floating point) to whole nodes, so a search ends at the key's rank in the
+    // original array. Above it each node holds B separator keys for B + 1
+    // children, stored layer by layer with no pointers: child i of node k is
+    // node k * (B + 1) + i of the layer below. A search reads one node per
+    // layer, about log_{B+1}(n) cache lines against log2(n) for binary
+    // search, and ranks the query within a node with one vector compare of
+    // all B keys. Batch queries descend a group of queries together and
+    // prefetch every query's next node before ranking any of them, so the
+    // cache misses of the group overlap.
+    template <typename Key>
+        requires std::is_arithmetic_v<Key>
+    class static_search_index {
+    public:
+        static constexpr size_t kNodeBytes = 64;
+        static constexpr size_t kNodeKeys = kNodeBytes / sizeof(Key);
+        static constexpr size_t kBatchGroup = 16;
+
+        explicit static_search_index(const vector<Key>& sorted_keys);
+
+        ~static_search_index() {
+            ::operator delete(tree_, std::align_val_t{kNodeBytes});
+        }
+
+        static_search_index(const static_search_index&) = delete;
+        static_search_index& operator=(const static_search_index&) = delete;
+
+        // Rank of the first key not less than key; size() if there is none
+        [[nodiscard]] size_t lower_bound(Key key) const noexcept {
+            size_t node = 0;
+            for (size_t layer = height_ - 1; layer > 0; --layer) {
+                node = node * (kNodeKeys + 1) + rank_in_node(node_at(layer, node), key);
+            }
+            return std::min(node * kNodeKeys + rank_in_node(node_at(0, node), key), size_);
+        }
+
+        // ranks[i] = lower_bound(queries[i]); ranks must be as long as queries
+        void lower_bound(std::span<const Key> queries, std::span<size_t> ranks) const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] size_t height() const noexcept { return height_; }
+        [[nodiscard]] size_t bytes() const noexcept { return offsets_[height_] * sizeof(Key); }
+
+    private:
+        static constexpr size_t kMaxLayers = 32;
+        typedef Key Block __attribute__((vector_size(kNodeBytes)));
+
+        Key* tree_ = nullptr;
+        size_t size_ = 0;
+        size_t height_ = 0;
+        // offsets_[h]: first key of layer h (layer 0 is the leaves)
+        size_t offsets_[kMaxLayers + 1] = {};
+
+        // No query compares above it, so a search never steps past the
+        // last real child; with max() a +inf query would
+        static constexpr Key kPadding = std::numeric_limits<Key>::has_infinity ? std::numeric_limits<Key>::infinity()
+                                                                                : std::numeric_limits<Key>::max();
+
+        static constexpr size_t nodes_for(size_t keys) noexcept {
+            return (keys + kNodeKeys - 1) / kNodeKeys;
+        }
+
+        const Key* node_at(size_t layer, size_t node) const noexcept {
+            return tree_ + offsets_[layer] + node * kNodeKeys;
+        }
+
+        // Number of keys in the node less than key: a lane-wise compare
+        // gives -1 per smaller key, and the lanes are summed
+        static size_t rank_in_node(const Key* node, Key key) noexcept {
+            Block keys;
+            __builtin_memcpy(&keys, __builtin_assume_aligned(node, kNodeBytes), kNodeBytes);
+            const auto less = keys < key;
+            int64_t sum = 0;
+            for (size_t i = 0; i < kNodeKeys; ++i) {
+                sum += less[i];
+            }
+            return static_cast<size_t>(-sum);
+        }
+    };
+
+    template <typename Key>
+        requires std::is_arithmetic_v<Key>
+    static_search_index<Key>::static_search_index(const vector<Key>& sorted_keys)
+        : size_(sorted_keys.size()) {
+        if (!std::is_sorted(sorted_keys.begin(), sorted_keys.end())) {
+            throw invalid_argument("customvector::static_search_index - keys must be sorted");
+        }
+        if constexpr (std::is_floating_point_v<Key>) {
+            if (std::any_of(sorted_keys.begin(), sorted_keys.end(), [](Key key) { return key != key; })) {
+                throw invalid_argument("customvector::static_search_index - keys must not be NaN");
+            }
+        }
+
+        // Layer h + 1 needs one separator per child beyond the first of
+        // each node, i.e. nodes(h) - 1 of them, rounded up to whole nodes
+        size_t layer_nodes[kMaxLayers];
+        layer_nodes[0] = std::max<size_t>(nodes_for(size_), 1);
+        height_ = 1;
+        while (layer_nodes[height_ - 1] > 1) {
+            layer_nodes[height_] = (layer_nodes[height_ - 1] + kNodeKeys) / (kNodeKeys + 1);
+            ++height_;
+        }
+        for (size_t h = 0; h < height_; ++h) {
+            offsets_[h + 1] = offsets_[h] + layer_nodes[h] * kNodeKeys;
+        }
+
+        tree_ = static_cast<Key*>(::operator new(offsets_[height_] * sizeof(Key), std::align_val_t{kNodeBytes}));
+        std::fill(tree_, tree_ + offsets_[height_], kPadding);
+        std::copy(sorted_keys.begin(), sorted_keys.end(), tree_);
+
+        // Separator j of node k is the first key of its child j + 1's
+        // subtree: follow leftmost children down to the leaves
+        for (size_t h = 1; h < height_; ++h) {
+            for (size_t k = 0; k < layer_nodes[h]; ++k) {
+                for (size_t j = 0; j < kNodeKeys; ++j) {
+                    size_t child = k * (kNodeKeys + 1) + j + 1;
+                    for (size_t level = h - 1; level > 0; --level) {
+                        child *= kNodeKeys + 1;
+                    }
+                    const size_t leaf = child * kNodeKeys;
+                    if (leaf < size_) {
+                        tree_[offsets_[h] + k * kNodeKeys + j] = tree_[leaf];
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Key>
+        requires std::is_arithmetic_v<Key>
+    void static_search_index<Key>::lower_bound(std::span<const Key> queries, std::span<size_t> ranks) const noexcept {
+        size_t nodes[kBatchGroup];
+        for (size_t begin = 0; begin < queries.size(); begin += kBatchGroup) {
+            const size_t count = std::min(kBatchGroup, queries.size() - begin);
+            const Key* group = queries.data() + begin;
+
+            for (size_t q = 0; q < count; ++q) {
+                nodes[q] = 0;
+            }
+            for (size_t layer = height_ - 1; layer > 0; --layer) {
+                for (size_t q = 0; q < count; ++q) {
+                    nodes[q] = nodes[q] * (kNodeKeys + 1) + rank_in_node(node_at(layer, nodes[q]), group[q]);
+                    __builtin_prefetch(node_at(layer - 1, nodes[q]));
+                }
+            }
+            for (size_t q = 0; q < count; ++q) {
+                ranks[begin + q] = std::min(nodes[q] * kNodeKeys + rank_in_node(node_at(0, nodes[q]), group[q]), size_);
+            }
+        }
+    }
+}
+
+#endif // CUSTOMVECTOR_SEARCH_INDEX_HPP
@@ -0,0 +1,88 @@
+#include "flat_map.hpp"
+#include "search_index.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+
+// Random lookups over sorted uint64 keys, from cache-resident to well past
+// the last-level cache. Each variant must produce the same rank checksum.
+TEST_CASE("Sorted-array search: S+ tree index vs binary search", "[benchmark][search_index]") {
+    constexpr std::size_t kQueries = 2'000'000;
+
+    for (std::size_t n : {std::size_t{1} << 12, std::size_t{1} << 20, std::size_t{1} << 26}) {
+        std::mt19937_64 rng(n);
+        customvector::vector<std::uint64_t> sorted;
+        sorted.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            sorted.push_back(rng());
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        customvector::vector<std::uint64_t> queries;
+        queries.reserve(kQueries);
+        for (std::size_t i = 0; i < kQueries; ++i) {
+            queries.push_back(rng());
+        }
+
+        const auto build_start = std::chrono::steady_clock::now();
+        customvector::static_search_index<std::uint64_t> index(sorted);
+        const double build_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+        auto time_ns_per_query = [&](auto&& body) {
+            std::size_t checksum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            body(checksum);
+            const double ns =
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kQueries;
+            return std::pair{ns, checksum};
+        };
+
+        const auto [std_ns, std_sum] = time_ns_per_query([&](std::size_t& sum) {
+            for (auto q : queries) {
+                sum += static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+            }
+        });
+        const auto [branchless_ns, branchless_sum] = time_ns_per_query([&](std::size_t& sum) {
+            for (auto q : queries) {
+                sum += customvector::branchless_lower_bound(sorted.data(), n, q, std::less<std::uint64_t>());
+            }
+        });
+        const auto [tree_ns, tree_sum] = time_ns_per_query([&](std::size_t& sum) {
+            for (auto q : queries) {
+                sum += index.lower_bound(q);
+            }
+        });
+        customvector::vector<std::size_t> ranks;
+        ranks.reserve(kQueries);
+        for (std::size_t i = 0; i < kQueries; ++i) {
+            ranks.push_back(0);
+        }
+        const auto [batch_ns, batch_sum] = time_ns_per_query([&](std::size_t& sum) {
+            index.lower_bound(std::span<const std::uint64_t>(queries.data(), kQueries),
+                              std::span<std::size_t>(ranks.data(), kQueries));
+            for (auto rank : ranks) {
+                sum += rank;
+            }
+        });
+
+        REQUIRE(branchless_sum == std_sum);
+        REQUIRE(tree_sum == std_sum);
+        REQUIRE(batch_sum == std_sum);
+
+        std::cout << "\n" << n << " keys (" << n * sizeof(std::uint64_t) / 1024 << " KiB), index "
+                  << index.bytes() / 1024 << " KiB, height " << index.height() << ", built in " << std::fixed
+                  << std::setprecision(1) << build_ms << " ms\n"
+                  << std::setprecision(2)
+                  << "  std::lower_bound              " << std::setw(7) << std_ns << " ns/query\n"
+                  << "  branchless_lower_bound        " << std::setw(7) << branchless_ns << " ns/query\n"
+                  << "  static_search_index           " << std::setw(7) << tree_ns << " ns/query\n"
+                  << "  static_search_index (batch)   " << std::setw(7) << batch_ns << " ns/query\n";
+    }
+}
@@ -0,0 +1,107 @@
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include "search_index.hpp"
+using customvector::static_search_index;
+using customvector::vector;
+
+namespace {
+    template <typename Key>
+    void require_matches_lower_bound(const vector<Key>& sorted, const vector<Key>& queries) {
+        static_search_index<Key> index(sorted);
+        REQUIRE(index.size() == sorted.size());
+
+        vector<std::size_t> ranks;
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            ranks.push_back(0);
+        }
+        index.lower_bound(std::span<const Key>(queries.data(), queries.size()),
+                          std::span<std::size_t>(ranks.data(), ranks.size()));
+
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            const auto expected = static_cast<std::size_t>(
+                std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin());
+            REQUIRE(index.lower_bound(queries[i]) == expected);
+            REQUIRE(ranks[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("static_search_index matches std::lower_bound at every size", "[search_index]") {
+    std::mt19937_64 rng(3);
+    for (std::size_t n : {0u, 1u, 7u, 8u, 9u, 72u, 73u, 640u, 5000u, 100000u}) {
+        vector<std::uint64_t> sorted;
+        for (std::size_t i = 0; i < n; ++i) {
+            sorted.push_back(rng() % (4 * n + 1));
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        vector<std::uint64_t> queries;
+        for (std::size_t i = 0; i < 2000; ++i) {
+            queries.push_back(rng() % (4 * n + 3));
+        }
+        queries.push_back(0);
+        queries.push_back(std::numeric_limits<std::uint64_t>::max());
+        require_matches_lower_bound(sorted, queries);
+    }
+}
+
+TEST_CASE("static_search_index handles duplicates, narrow and signed keys", "[search_index]") {
+    SECTION("long runs of equal int32 keys") {
+        vector<std::int32_t> sorted;
+        for (int i = 0; i < 3000; ++i) {
+            sorted.push_back(i / 100 - 15);
+        }
+        vector<std::int32_t> queries;
+        for (int q = -20; q <= 20; ++q) {
+            queries.push_back(q);
+        }
+        require_matches_lower_bound(sorted, queries);
+    }
+
+    SECTION("double keys including the padding value") {
+        vector<double> sorted;
+        for (int i = 0; i < 1000; ++i) {
+            sorted.push_back(i * 0.5);
+        }
+        sorted.push_back(std::numeric_limits<double>::max());
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        vector<double> queries;
+        for (double q : {-inf, -1.0, 0.0, 0.25, 250.0, 499.5, 600.0, std::numeric_limits<double>::max(), inf}) {
+            queries.push_back(q);
+        }
+        require_matches_lower_bound(sorted, queries);
+
+        // 100 keys leave padding separators above the leaves, which a +inf
+        // query used to count as smaller
+        vector<double> small;
+        for (int i = 0; i < 100; ++i) {
+            small.push_back(i);
+        }
+        require_matches_lower_bound(small, queries);
+
+        // Infinite keys at both ends, at a size with partial nodes
+        vector<double> infinite;
+        infinite.push_back(-inf);
+        for (int i = 0; i < 640; ++i) {
+            infinite.push_back(i);
+        }
+        infinite.push_back(inf);
+        infinite.push_back(inf);
+        require_matches_lower_bound(infinite, queries);
+    }
+}
+
+TEST_CASE("static_search_index rejects unsorted keys", "[search_index]") {
+    vector<int> keys;
+    keys.push_back(2);
+    keys.push_back(1);
+    REQUIRE_THROWS_AS(static_search_index<int>(keys), std::invalid_argument);
+
+    vector<double> with_nan;
+    with_nan.push_back(1.0);
+    with_nan.push_back(std::numeric_limits<double>::quiet_NaN());
+    REQUIRE_THROWS_AS(static_search_index<double>(with_nan), std::invalid_argument);
+}
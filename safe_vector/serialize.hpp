@@ -0,0 +1,243 @@
+#ifndef CUSTOMVECTOR_SERIALIZE_HPP
+#define CUSTOMVECTOR_SERIALIZE_HPP
+
+#include "vector.hpp"
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace customvector {
+    using std::invalid_argument;
+
+    // Wire format of a vector of trivially copyable elements: a 32-byte
+    // header in the writer's byte order, then the elements' bytes as they
+    // are in memory. The payload starts 32 bytes into the message, so a
+    // message received into a suitably aligned buffer (page-aligned mmap,
+    // ::operator new, a 32-byte-aligned ring slot) can be used in place.
+    struct wire_header {
+        static constexpr uint32_t kMagic = 0x43564543; // "CVEC" in little endian
+        static constexpr uint16_t kVersion = 1;
+
+        uint32_t magic;
+        uint16_t version;
+        uint16_t element_size;
+        uint32_t element_align;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t payload_bytes;
+    };
+    static_assert(sizeof(wire_header) == 32 && std::is_trivially_copyable_v<wire_header>);
+
+    inline constexpr size_t kWireHeaderBytes = sizeof(wire_header);
+
+    // Default cap on the payload deserialize and read_vector will allocate
+    // for, so a corrupt or hostile header cannot request arbitrary memory
+    inline constexpr size_t kDefaultMaxWireBytes = size_t{1} << 30;
+
+    // Elements whose bytes are their value, aligned no more strictly than
+    // ::operator new (and so than the payload offset)
+    template <typename T>
+    concept WireElement = std::is_trivially_copyable_v<T> && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ &&
+                          sizeof(T) <= UINT16_MAX;
+
+    template <WireElement T>
+    [[nodiscard]] wire_header make_wire_header(const vector<T>& items) noexcept {
+        return wire_header{wire_header::kMagic, wire_header::kVersion, static_cast<uint16_t>(sizeof(T)),
+                           static_cast<uint32_t>(alignof(T)), 0, items.size(), items.size() * sizeof(T)};
+    }
+
+    template <WireElement T>
+    [[nodiscard]] size_t serialized_size(const vector<T>& items) noexcept {
+        return kWireHeaderBytes + items.size() * sizeof(T);
+    }
+
+    // Header and payload as two iovecs for writev or sendmsg. Nothing is
+    // copied; both must outlive the write.
+    template <WireElement T>
+    [[nodiscard]] std::array<iovec, 2> wire_iovecs(const wire_header& header, const vector<T>& items) noexcept {
+        return {iovec{const_cast<wire_header*>(&header), kWireHeaderBytes},
+                iovec{const_cast<T*>(items.data()), items.size() * sizeof(T)}};
+    }
+
+    // Writes header and payload to out; returns the bytes written
+    template <WireElement T>
+    size_t serialize(const vector<T>& items, std::span<std::byte> out) {
+        const size_t total = serialized_size(items);
+        if (out.size() < total) {
+            throw invalid_argument("customvector::serialize - output buffer too small");
+        }
+        const wire_header header = make_wire_header(items);
+        std::memcpy(out.data(), &header, kWireHeaderBytes);
+        if (!items.empty()) {
+            std::memcpy(out.data() + kWireHeaderBytes, items.data(), header.payload_bytes);
+        }
+        return total;
+    }
+
+    namespace wire_detail {
+        template <WireElement T>
+        wire_header check_header(const void* bytes, const char* caller, size_t max_bytes) {
+            wire_header header;
+            std::memcpy(&header, bytes, kWireHeaderBytes);
+            auto fail = [caller](const char* what) {
+                throw invalid_argument(std::string("customvector::") + caller + " - " + what);
+            };
+            if (header.magic == std::byteswap(wire_header::kMagic)) {
+                fail("written with the other byte order");
+            }
+            if (header.magic != wire_header::kMagic) {
+                fail("not a serialized vector");
+            }
+            if (header.version != wire_header::kVersion) {
+                fail("unsupported format version");
+            }
+            if (header.element_size != sizeof(T) || header.element_align != alignof(T)) {
+                fail("element type differs");
+            }
+            if (header.count > SIZE_MAX / sizeof(T) || header.payload_bytes != header.count * sizeof(T)) {
+                fail("corrupt element count");
+            }
+            if (header.payload_bytes > max_bytes) {
+                fail("payload exceeds max_bytes");
+            }
+            return header;
+        }
+
+        // Storage of ::operator new, as vector::adopt expects with no
+        // release function
+        template <WireElement T>
+        vector<T> adopt_new(T* data, size_t count) {
+            return vector<T>::adopt(data, count, count, buffer_release{});
+        }
+
+        template <WireElement T>
+        T* allocate(size_t count) {
+            return static_cast<T*>(::operator new(count > 0 ? count * sizeof(T) : sizeof(T)));
+        }
+    }
+
+    // Copies a serialized vector out of buffer with one memcpy. Payloads
+    // over max_bytes are rejected before anything is allocated.
+    template <WireElement T>
+    [[nodiscard]] vector<T> deserialize(std::span<const std::byte> buffer, size_t max_bytes = kDefaultMaxWireBytes) {
+        if (buffer.size() < kWireHeaderBytes) {
+            throw invalid_argument("customvector::deserialize - buffer shorter than the header");
+        }
+        const wire_header header = wire_detail::check_header<T>(buffer.data(), "deserialize", max_bytes);
+        if (header.payload_bytes > buffer.size() - kWireHeaderBytes) {
+            throw invalid_argument("customvector::deserialize - payload truncated");
+        }
+        T* data = wire_detail::allocate<T>(header.count);
+        std::memcpy(data, buffer.data() + kWireHeaderBytes, header.payload_bytes);
+        return wire_detail::adopt_new(data, header.count);
+    }
+
+    // Turns a received message into a vector without copying: the vector's
+    // elements are the payload inside buffer, and release frees the whole
+    // buffer when the vector is done with it (release is not called if
+    // this throws). buffer.data() + 32 must be aligned for T.
+    template <WireElement T>
+    [[nodiscard]] vector<T> deserialize_in_place(std::span<std::byte> buffer, buffer_release release) {
+        if (buffer.size() < kWireHeaderBytes) {
+            throw invalid_argument("customvector::deserialize_in_place - buffer shorter than the header");
+        }
+        // Nothing is allocated, and the payload must fit in buffer anyway
+        const wire_header header = wire_detail::check_header<T>(buffer.data(), "deserialize_in_place", SIZE_MAX);
+        if (header.payload_bytes > buffer.size() - kWireHeaderBytes) {
+            throw invalid_argument("customvector::deserialize_in_place - payload truncated");
+        }
+        auto* payload = std::launder(reinterpret_cast<T*>(buffer.data() + kWireHeaderBytes));
+        return vector<T>::adopt(payload, header.count, (buffer.size() - kWireHeaderBytes) / sizeof(T), release);
+    }
+
+    // writev of header and payload straight from the vector's storage,
+    // resuming after short writes and EINTR
+    template <WireElement T>
+    void write_vector(int fd, const vector<T>& items) {
+        const wire_header header = make_wire_header(items);
+        auto iovecs = wire_iovecs(header, items);
+        iovec* pending = iovecs.data();
+        int remaining = 2;
+        while (remaining > 0) {
+            const ssize_t written = ::writev(fd, pending, remaining);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "customvector::write_vector - writev failed");
+            }
+            auto left = static_cast<size_t>(written);
+            while (remaining > 0 && left >= pending->iov_len) {
+                left -= pending->iov_len;
+                ++pending;
+                --remaining;
+            }
+            if (remaining > 0) {
+                pending->iov_base = static_cast<std::byte*>(pending->iov_base) + left;
+                pending->iov_len -= left;
+            }
+        }
+    }
+
+    namespace wire_detail {
+        // False on end of stream before the first byte
+        inline bool read_fully(int fd, void* into, size_t bytes) {
+            auto* cursor = static_cast<std::byte*>(into);
+            size_t done = 0;
+            while (done < bytes) {
+                const ssize_t got = ::read(fd, cursor + done, bytes - done);
+                if (got < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "customvector::read_vector - read failed");
+                }
+                if (got == 0) {
+                    if (done == 0) {
+                        return false;
+                    }
+                    throw std::runtime_error("customvector::read_vector - stream ended inside a vector");
+                }
+                done += static_cast<size_t>(got);
+            }
+            return true;
+        }
+    }
+
+    // Reads one vector written by write_vector. The payload is read
+    // directly into the new vector's storage, with no staging copy. A
+    // header announcing more than max_bytes is rejected before allocating.
+    template <WireElement T>
+    [[nodiscard]] vector<T> read_vector(int fd, size_t max_bytes = kDefaultMaxWireBytes) {
+        std::byte raw[kWireHeaderBytes];
+        if (!wire_detail::read_fully(fd, raw, kWireHeaderBytes)) {
+            throw std::runtime_error("customvector::read_vector - stream ended before a vector");
+        }
+        const wire_header header = wire_detail::check_header<T>(raw, "read_vector", max_bytes);
+        T* data = wire_detail::allocate<T>(header.count);
+        try {
+            if (header.payload_bytes > 0 && !wire_detail::read_fully(fd, data, header.payload_bytes)) {
+                throw std::runtime_error("customvector::read_vector - stream ended inside a vector");
+            }
+        } catch (...) {
+            ::operator delete(data);
+            throw;
+        }
+        return wire_detail::adopt_new(data, header.count);
+    }
+}
+
+#endif // CUSTOMVECTOR_SERIALIZE_HPP
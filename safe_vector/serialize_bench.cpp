@@ -0,0 +1,172 @@
+#include "serialize.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    struct Tick {
+        std::uint64_t timestamp;
+        double price;
+        std::int32_t quantity;
+        std::uint32_t venue;
+    };
+
+    // The per-element path this replaces: every field appended to a byte
+    // stream and parsed back one at a time
+    template <typename Field>
+    void append_field(customvector::vector<std::byte>& out, const Field& field) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&field);
+        for (std::size_t i = 0; i < sizeof(Field); ++i) {
+            out.push_back(bytes[i]);
+        }
+    }
+
+    template <typename Field>
+    Field read_field(const std::byte*& cursor) {
+        Field field;
+        std::memcpy(&field, cursor, sizeof(Field));
+        cursor += sizeof(Field);
+        return field;
+    }
+}
+
+// 1M 24-byte records (24 MB): per-element serialization against one header
+// plus the record array, to memory and over a Unix socket.
+TEST_CASE("Vector serialization: per element vs zero copy", "[benchmark][serialize]") {
+    constexpr std::size_t kRecords = 1'000'000;
+    customvector::vector<Tick> ticks;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        ticks.push_back(Tick{1'700'000'000 + i, 100.0 + static_cast<double>(i % 1000) / 8,
+                             static_cast<std::int32_t>(i % 50), static_cast<std::uint32_t>(i % 7)});
+    }
+
+    auto best_ms = [](auto&& body) {
+        double best = 0;
+        for (int rep = 0; rep < 5; ++rep) {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = rep == 0 ? ms : std::min(best, ms);
+        }
+        return best;
+    };
+
+    customvector::vector<std::byte> stream;
+    const double encode_elementwise_ms = best_ms([&] {
+        stream.clear();
+        append_field(stream, static_cast<std::uint64_t>(ticks.size()));
+        for (const Tick& tick : ticks) {
+            append_field(stream, tick.timestamp);
+            append_field(stream, tick.price);
+            append_field(stream, tick.quantity);
+            append_field(stream, tick.venue);
+        }
+    });
+
+    customvector::vector<std::byte> message;
+    for (std::size_t i = 0; i < customvector::serialized_size(ticks); ++i) {
+        message.push_back(std::byte{0});
+    }
+    const std::span<std::byte> bytes(message.data(), message.size());
+    const double encode_ms = best_ms([&] { customvector::serialize(ticks, bytes); });
+
+    std::size_t decoded_count = 0;
+    const double decode_elementwise_ms = best_ms([&] {
+        const std::byte* cursor = stream.data();
+        const auto count = read_field<std::uint64_t>(cursor);
+        customvector::vector<Tick> decoded;
+        decoded.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            Tick tick;
+            tick.timestamp = read_field<std::uint64_t>(cursor);
+            tick.price = read_field<double>(cursor);
+            tick.quantity = read_field<std::int32_t>(cursor);
+            tick.venue = read_field<std::uint32_t>(cursor);
+            decoded.push_back(tick);
+        }
+        decoded_count = decoded.size();
+    });
+    REQUIRE(decoded_count == kRecords);
+
+    const double decode_ms = best_ms([&] { decoded_count = customvector::deserialize<Tick>(bytes).size(); });
+    REQUIRE(decoded_count == kRecords);
+    const double in_place_ms = best_ms([&] {
+        decoded_count = customvector::deserialize_in_place<Tick>(bytes, {+[](void*) noexcept {}, nullptr}).size();
+    });
+    REQUIRE(decoded_count == kRecords);
+
+    // Socket transfer, sender and receiver on two threads
+    auto transfer_ms = [&](auto&& send, auto&& receive) {
+        return best_ms([&] {
+            int fds[2];
+            REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+            std::thread sender([&] {
+                send(fds[0]);
+                ::close(fds[0]);
+            });
+            receive(fds[1]);
+            sender.join();
+            ::close(fds[1]);
+        });
+    };
+    const double socket_elementwise_ms = transfer_ms(
+        [&](int fd) {
+            customvector::vector<std::byte> out;
+            append_field(out, static_cast<std::uint64_t>(ticks.size()));
+            for (const Tick& tick : ticks) {
+                append_field(out, tick.timestamp);
+                append_field(out, tick.price);
+                append_field(out, tick.quantity);
+                append_field(out, tick.venue);
+            }
+            for (std::size_t sent = 0; sent < out.size();) {
+                sent += static_cast<std::size_t>(::write(fd, out.data() + sent, out.size() - sent));
+            }
+        },
+        [&](int fd) {
+            customvector::vector<std::byte> in;
+            std::byte chunk[65536];
+            for (ssize_t got; (got = ::read(fd, chunk, sizeof(chunk))) > 0;) {
+                for (ssize_t i = 0; i < got; ++i) {
+                    in.push_back(chunk[i]);
+                }
+            }
+            const std::byte* cursor = in.data();
+            const auto count = read_field<std::uint64_t>(cursor);
+            customvector::vector<Tick> decoded;
+            decoded.reserve(count);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                Tick tick;
+                tick.timestamp = read_field<std::uint64_t>(cursor);
+                tick.price = read_field<double>(cursor);
+                tick.quantity = read_field<std::int32_t>(cursor);
+                tick.venue = read_field<std::uint32_t>(cursor);
+                decoded.push_back(tick);
+            }
+            decoded_count = decoded.size();
+        });
+    REQUIRE(decoded_count == kRecords);
+    const double socket_ms = transfer_ms([&](int fd) { customvector::write_vector(fd, ticks); },
+                                         [&](int fd) { decoded_count = customvector::read_vector<Tick>(fd).size(); });
+    REQUIRE(decoded_count == kRecords);
+
+    std::cout << "\n" << kRecords << " x " << sizeof(Tick) << "-byte records (" << kRecords * sizeof(Tick) / 1'000'000
+              << " MB)\n"
+              << std::fixed << std::setprecision(2)
+              << "  encode              per element " << std::setw(8) << encode_elementwise_ms
+              << " ms   serialize            " << std::setw(8) << encode_ms << " ms\n"
+              << "  decode              per element " << std::setw(8) << decode_elementwise_ms
+              << " ms   deserialize          " << std::setw(8) << decode_ms << " ms\n"
+              << "                                               deserialize_in_place " << std::setw(8)
+              << in_place_ms << " ms\n"
+              << "  socket round trip   per element " << std::setw(8) << socket_elementwise_ms
+              << " ms   write/read_vector    " << std::setw(8) << socket_ms << " ms\n";
+}
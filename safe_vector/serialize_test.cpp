@@ -0,0 +1,162 @@
+#include <catch_amalgamated.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "serialize.hpp"
+using customvector::vector;
+
+namespace {
+    struct Tick {
+        std::uint64_t timestamp;
+        double price;
+        std::int32_t quantity;
+        std::uint32_t venue;
+    };
+
+    vector<Tick> make_ticks(std::size_t n) {
+        vector<Tick> ticks;
+        for (std::size_t i = 0; i < n; ++i) {
+            ticks.push_back(Tick{1'700'000'000 + i, 100.0 + static_cast<double>(i) / 8, static_cast<std::int32_t>(i % 50),
+                                 static_cast<std::uint32_t>(i % 7)});
+        }
+        return ticks;
+    }
+
+    bool same_ticks(const vector<Tick>& a, const vector<Tick>& b) {
+        return a.size() == b.size() && (a.size() == 0 || std::memcmp(a.data(), b.data(), a.size() * sizeof(Tick)) == 0);
+    }
+}
+
+TEST_CASE("serialize and deserialize round-trip through a buffer", "[serialize]") {
+    for (std::size_t n : {0u, 1u, 1000u}) {
+        const auto ticks = make_ticks(n);
+        vector<std::byte> buffer;
+        for (std::size_t i = 0; i < customvector::serialized_size(ticks); ++i) {
+            buffer.push_back(std::byte{0});
+        }
+        const std::span<std::byte> bytes(buffer.data(), buffer.size());
+        REQUIRE(customvector::serialize(ticks, bytes) == buffer.size());
+
+        const auto copy = customvector::deserialize<Tick>(bytes);
+        REQUIRE(same_ticks(copy, ticks));
+
+        REQUIRE_THROWS_AS(customvector::serialize(ticks, bytes.first(bytes.size() - 1)), std::invalid_argument);
+        REQUIRE_THROWS_AS(customvector::deserialize<Tick>(bytes.first(bytes.size() - 1)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("deserialize rejects foreign or corrupt headers", "[serialize]") {
+    const auto ticks = make_ticks(10);
+    vector<std::byte> buffer;
+    for (std::size_t i = 0; i < customvector::serialized_size(ticks); ++i) {
+        buffer.push_back(std::byte{0});
+    }
+    const std::span<std::byte> bytes(buffer.data(), buffer.size());
+    customvector::serialize(ticks, bytes);
+    customvector::wire_header header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    auto require_rejected = [&](customvector::wire_header changed) {
+        std::memcpy(buffer.data(), &changed, sizeof(changed));
+        REQUIRE_THROWS_AS(customvector::deserialize<Tick>(bytes), std::invalid_argument);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+    };
+
+    auto swapped = header;
+    swapped.magic = std::byteswap(header.magic);
+    require_rejected(swapped);
+    auto wrong_magic = header;
+    wrong_magic.magic = 0;
+    require_rejected(wrong_magic);
+    auto wrong_version = header;
+    wrong_version.version = 2;
+    require_rejected(wrong_version);
+    auto overflowing = header;
+    overflowing.count = SIZE_MAX / 2;
+    require_rejected(overflowing);
+
+    REQUIRE_THROWS_AS(customvector::deserialize<std::uint64_t>(bytes), std::invalid_argument);
+    REQUIRE_THROWS_AS(customvector::deserialize<Tick>(bytes.first(8)), std::invalid_argument);
+
+    REQUIRE(customvector::deserialize<Tick>(bytes, 10 * sizeof(Tick)).size() == 10);
+    REQUIRE_THROWS_AS(customvector::deserialize<Tick>(bytes, 10 * sizeof(Tick) - 1), std::invalid_argument);
+}
+
+TEST_CASE("deserialize_in_place adopts an mmap'd message without copying", "[serialize]") {
+    const auto ticks = make_ticks(5000);
+    const std::size_t length = customvector::serialized_size(ticks);
+    void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(mapping != MAP_FAILED);
+    const std::span<std::byte> message(static_cast<std::byte*>(mapping), length);
+    customvector::serialize(ticks, message);
+
+    struct Mapping {
+        void* base;
+        std::size_t length;
+        bool* unmapped;
+    };
+    bool unmapped = false;
+    auto* owner = new Mapping{mapping, length, &unmapped};
+    auto unmap = +[](void* context) noexcept {
+        auto* m = static_cast<Mapping*>(context);
+        ::munmap(m->base, m->length);
+        *m->unmapped = true;
+        delete m;
+    };
+
+    {
+        auto received = customvector::deserialize_in_place<Tick>(message, {unmap, owner});
+        REQUIRE(reinterpret_cast<std::byte*>(received.data()) == message.data() + customvector::kWireHeaderBytes);
+        REQUIRE(same_ticks(received, ticks));
+        received[0].price = -1;
+        REQUIRE(received.at(0).price == -1);
+        REQUIRE_FALSE(unmapped);
+    }
+    REQUIRE(unmapped);
+}
+
+TEST_CASE("write_vector and read_vector move a vector over a socket", "[serialize]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    // Larger than the socket buffer, so writev returns short counts
+    const auto big = make_ticks(200'000);
+    const auto empty = make_ticks(0);
+    std::thread writer([&] {
+        customvector::write_vector(fds[0], big);
+        customvector::write_vector(fds[0], empty);
+        ::close(fds[0]);
+    });
+
+    const auto first = customvector::read_vector<Tick>(fds[1]);
+    const auto second = customvector::read_vector<Tick>(fds[1]);
+    writer.join();
+    REQUIRE(same_ticks(first, big));
+    REQUIRE(second.empty());
+    REQUIRE_THROWS_AS(customvector::read_vector<Tick>(fds[1]), std::runtime_error);
+    ::close(fds[1]);
+}
+
+TEST_CASE("read_vector rejects a header larger than max_bytes before allocating", "[serialize]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    // A well-formed header announcing 32 TiB, with no payload behind it
+    auto header = customvector::make_wire_header(make_ticks(0));
+    header.count = std::uint64_t{1} << 40;
+    header.payload_bytes = header.count * sizeof(Tick);
+    REQUIRE(::write(fds[0], &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+    REQUIRE_THROWS_AS(customvector::read_vector<Tick>(fds[1]), std::invalid_argument);
+
+    // A caller-chosen limit applies the same way
+    customvector::write_vector(fds[0], make_ticks(100));
+    REQUIRE_THROWS_AS(customvector::read_vector<Tick>(fds[1], 99 * sizeof(Tick)), std::invalid_argument);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
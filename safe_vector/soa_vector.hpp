@@ -0,0 +1,368 @@
+#ifndef CUSTOMVECTOR_SOA_VECTOR_HPP
+#define CUSTOMVECTOR_SOA_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace customvector {
+
+    template <typename... Fields>
+        requires(sizeof...(Fields) > 0) && (destructible<Fields> && ...)
+    class soa_vector;
+
+    // Proxy for row i of a soa_vector: get<I>() is a reference into column
+    // I. Assigning a row (or a tuple) writes through to the columns, as
+    // vector<bool>::reference does, and structured bindings name the
+    // column elements themselves: auto [id, price] = rows[i].
+    template <bool Const, typename... Fields>
+    class soa_row {
+        using Owner = std::conditional_t<Const, const soa_vector<Fields...>, soa_vector<Fields...>>;
+
+    public:
+        using value_type = std::tuple<Fields...>;
+
+        soa_row(Owner& owner, size_t index) noexcept : owner_(&owner), index_(index) {}
+        soa_row(const soa_row&) = default;
+
+        template <size_t I>
+        [[nodiscard]] auto& get() const noexcept {
+            return owner_->template column<I>()[index_];
+        }
+
+        operator value_type() const {
+            return [this]<size_t... I>(std::index_sequence<I...>) {
+                return value_type(get<I>()...);
+            }(std::index_sequence_for<Fields...>{});
+        }
+
+        const soa_row& operator=(const value_type& row) const
+            requires(!Const)
+        {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((get<I>() = std::get<I>(row)), ...);
+            }(std::index_sequence_for<Fields...>{});
+            return *this;
+        }
+
+        const soa_row& operator=(const soa_row& other) const
+            requires(!Const)
+        {
+            return *this = static_cast<value_type>(other);
+        }
+
+    private:
+        Owner* owner_;
+        size_t index_;
+    };
+
+    // Struct-of-arrays vector: each field lives in its own contiguous
+    // column, so a scan over one field reads only that field's bytes and
+    // can be vectorized over column<I>(). All columns share one allocation,
+    // each starting on a 64-byte boundary, and grow together: push_back
+    // appends one value to every column and a reallocation moves them all.
+    // Rows are accessed through soa_row proxies. The block comes from a
+    // std::pmr::memory_resource when given one, with vector's rules for
+    // copies and moves.
+    template <typename... Fields>
+        requires(sizeof...(Fields) > 0) && (destructible<Fields> && ...)
+    class soa_vector {
+    public:
+        using value_type = std::tuple<Fields...>;
+        using reference = soa_row<false, Fields...>;
+        using const_reference = soa_row<true, Fields...>;
+        template <size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        static constexpr size_t kColumns = sizeof...(Fields);
+        static constexpr size_t kColumnAlignment = 64;
+        static constexpr size_t kInitialCapacity = 8;
+        static_assert(((alignof(Fields) <= kColumnAlignment) && ...), "field alignment exceeds column alignment");
+
+        soa_vector() = default;
+
+        explicit soa_vector(std::pmr::memory_resource* resource) noexcept : resource_(resource) {}
+
+        soa_vector(const soa_vector& other) : soa_vector(other, nullptr) {}
+
+        soa_vector(const soa_vector& other, std::pmr::memory_resource* resource) : soa_vector(resource) {
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                push_back(other[i]);
+            }
+        }
+
+        soa_vector(soa_vector&& other) noexcept
+            : resource_(other.resource_),
+              block_(std::exchange(other.block_, nullptr)),
+              columns_(std::exchange(other.columns_, {})),
+              size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)) {}
+
+        soa_vector& operator=(const soa_vector& other) {
+            if (this != &other) {
+                soa_vector temp(other, resource_);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        soa_vector& operator=(soa_vector&& other) noexcept {
+            if (this != &other) {
+                soa_vector temp(std::move(other));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        ~soa_vector() {
+            clear();
+            deallocate(block_, capacity_);
+        }
+
+        void push_back(const Fields&... values) { emplace_back(values...); }
+
+        void push_back(const value_type& row) {
+            std::apply([this](const Fields&... values) { emplace_back(values...); }, row);
+        }
+
+        // One argument per column, each constructing that column's element
+        template <typename... Args>
+            requires(sizeof...(Args) == kColumns)
+        void emplace_back(Args&&... args) {
+            if (size_ == capacity_) {
+                reallocate(capacity_ == 0 ? kInitialCapacity : capacity_ * 2);
+            }
+            construct_row(size_, std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+            ++size_;
+        }
+
+        void pop_back() {
+            if (size_ == 0) {
+                throw out_of_range("customvector::soa_vector::pop_back - vector is empty");
+            }
+            --size_;
+            destroy_rows(size_, size_ + 1);
+        }
+
+        void clear() noexcept {
+            destroy_rows(0, size_);
+            size_ = 0;
+        }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity > capacity_) {
+                reallocate(new_capacity);
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        // The first size() elements of field I, contiguous and 64-byte aligned
+        template <size_t I>
+        [[nodiscard]] std::span<field_type<I>> column() noexcept {
+            return {std::get<I>(columns_), size_};
+        }
+
+        template <size_t I>
+        [[nodiscard]] std::span<const field_type<I>> column() const noexcept {
+            return {std::get<I>(columns_), size_};
+        }
+
+        [[nodiscard]] reference operator[](size_t index) noexcept { return reference(*this, index); }
+        [[nodiscard]] const_reference operator[](size_t index) const noexcept { return const_reference(*this, index); }
+
+        [[nodiscard]] reference at(size_t index) {
+            check_index(index);
+            return (*this)[index];
+        }
+
+        [[nodiscard]] const_reference at(size_t index) const {
+            check_index(index);
+            return (*this)[index];
+        }
+
+        // The resource storage comes from; new_delete_resource() for the global heap
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+            return resource_ ? resource_ : std::pmr::new_delete_resource();
+        }
+
+        void swap(soa_vector& other) noexcept {
+            std::swap(resource_, other.resource_);
+            std::swap(block_, other.block_);
+            std::swap(columns_, other.columns_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+    private:
+        using Columns = std::tuple<Fields*...>;
+
+        std::pmr::memory_resource* resource_ = nullptr;  // null: ::operator new
+        void* block_ = nullptr;
+        Columns columns_{};
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+
+        void check_index(size_t index) const {
+            if (index >= size_) {
+                throw out_of_range("customvector::soa_vector::at - index out of bounds");
+            }
+        }
+
+        static constexpr size_t align_up(size_t bytes) noexcept {
+            return (bytes + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+        }
+
+        // Column I starts at offsets[I]; returns the block size
+        static size_t layout(size_t capacity, size_t (&offsets)[kColumns]) noexcept {
+            size_t bytes = 0;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((offsets[I] = bytes, bytes = align_up(bytes + capacity * sizeof(field_type<I>))), ...);
+            }(std::index_sequence_for<Fields...>{});
+            return bytes;
+        }
+
+        // Carves one block into columns for capacity rows each
+        std::pair<void*, Columns> allocate(size_t capacity) {
+            size_t offsets[kColumns];
+            const size_t bytes = layout(capacity, offsets);
+            void* block = resource_ ? resource_->allocate(bytes, kColumnAlignment)
+                                    : ::operator new(bytes, std::align_val_t{kColumnAlignment});
+            auto* base = static_cast<unsigned char*>(block);
+            return {block, [&]<size_t... I>(std::index_sequence<I...>) {
+                        return Columns(reinterpret_cast<field_type<I>*>(base + offsets[I])...);
+                    }(std::index_sequence_for<Fields...>{})};
+        }
+
+        void deallocate(void* block, size_t capacity) noexcept {
+            if (!block) {
+                return;
+            }
+            if (resource_) {
+                size_t offsets[kColumns];
+                resource_->deallocate(block, layout(capacity, offsets), kColumnAlignment);
+            } else {
+                ::operator delete(block, std::align_val_t{kColumnAlignment});
+            }
+        }
+
+        // Constructs every field of row, undoing the fields already built
+        // if a later one throws
+        template <size_t... I, typename... Args>
+        void construct_row(size_t row, std::index_sequence<I...>, Args&&... args) {
+            size_t built = 0;
+            try {
+                ((new (std::get<I>(columns_) + row) field_type<I>(std::forward<Args>(args)), ++built), ...);
+            } catch (...) {
+                ((I < built ? std::destroy_at(std::get<I>(columns_) + row) : void()), ...);
+                throw;
+            }
+        }
+
+        void destroy_rows(size_t first, size_t last) noexcept {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (destroy_column<I>(first, last), ...);
+            }(std::index_sequence_for<Fields...>{});
+        }
+
+        template <size_t I>
+        void destroy_column(size_t first, size_t last) noexcept {
+            if constexpr (!std::is_trivially_destructible_v<field_type<I>>) {
+                std::destroy(std::get<I>(columns_) + first, std::get<I>(columns_) + last);
+            }
+        }
+
+        // Moves column I into fresh storage; on a throw, the partially
+        // filled column is destroyed and the exception propagates
+        template <size_t I>
+        void move_column(Columns& fresh) {
+            using F = field_type<I>;
+            F* source = std::get<I>(columns_);
+            F* target = std::get<I>(fresh);
+            if constexpr (std::is_trivially_copyable_v<F>) {
+                if (size_ > 0) {
+                    std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), size_ * sizeof(F));
+                }
+            } else {
+                size_t built = 0;
+                try {
+                    for (; built < size_; ++built) {
+                        new (target + built) F(std::move_if_noexcept(source[built]));
+                    }
+                } catch (...) {
+                    std::destroy_n(target, built);
+                    throw;
+                }
+            }
+        }
+
+        // Columns that move_if_noexcept copies can throw part-way; the rest
+        // are memcpy'd or moved with nothrow moves
+        template <size_t I>
+        static constexpr bool moves_nothrow =
+            std::is_trivially_copyable_v<field_type<I>> || std::is_nothrow_move_constructible_v<field_type<I>>;
+
+        // The columns that may throw are filled first, while every original
+        // is still intact, so a throw leaves the vector as it was; the
+        // nothrow moves follow once nothing can fail
+        void reallocate(size_t new_capacity) {
+            auto [block, fresh] = allocate(new_capacity);
+            bool filled[kColumns] = {};
+            try {
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    ((moves_nothrow<I> ? void() : (move_column<I>(fresh), void(filled[I] = true))), ...);
+                }(std::index_sequence_for<Fields...>{});
+            } catch (...) {
+                std::swap(columns_, fresh);
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    ((filled[I] ? destroy_column<I>(0, size_) : void()), ...);
+                }(std::index_sequence_for<Fields...>{});
+                std::swap(columns_, fresh);
+                deallocate(block, new_capacity);
+                throw;
+            }
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((moves_nothrow<I> ? move_column<I>(fresh) : void()), ...);
+            }(std::index_sequence_for<Fields...>{});
+            destroy_rows(0, size_);
+            deallocate(block_, capacity_);
+            block_ = block;
+            columns_ = fresh;
+            capacity_ = new_capacity;
+        }
+    };
+
+    // Copies the given members of each record into a soa_vector, one column
+    // per member: to_soa(records, &Trade::id, &Trade::price)
+    template <typename Record, typename... Members>
+    [[nodiscard]] soa_vector<Members...> to_soa(const vector<Record>& records, Members Record::*... members) {
+        soa_vector<Members...> columns;
+        columns.reserve(records.size());
+        for (const Record& record : records) {
+            columns.emplace_back(record.*members...);
+        }
+        return columns;
+    }
+}
+
+template <bool Const, typename... Fields>
+struct std::tuple_size<customvector::soa_row<Const, Fields...>>
+    : std::integral_constant<std::size_t, sizeof...(Fields)> {};
+
+template <std::size_t I, bool Const, typename... Fields>
+struct std::tuple_element<I, customvector::soa_row<Const, Fields...>> {
+    using type = std::conditional_t<Const, const std::tuple_element_t<I, std::tuple<Fields...>>,
+                                    std::tuple_element_t<I, std::tuple<Fields...>>>;
+};
+
+#endif // CUSTOMVECTOR_SOA_VECTOR_HPP
@@ -0,0 +1,136 @@
+#include "soa_vector.hpp"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+
+namespace {
+    // One 64-byte record per cache line, of which a typical query reads 8-16 bytes
+    struct Quote {
+        std::uint64_t id;
+        std::uint64_t timestamp;
+        double bid;
+        double ask;
+        double last;
+        std::int32_t size;
+        std::uint32_t flags;
+        char venue[16];
+    };
+    static_assert(sizeof(Quote) == 64);
+
+    using QuoteColumns = customvector::soa_vector<std::uint64_t, std::uint64_t, double, double, double, std::int32_t,
+                                                  std::uint32_t>;
+}
+
+// Scans of one or two fields and random whole-row reads over the same data,
+// held as customvector::vector<Quote> (AoS) and as a soa_vector with one
+// column per numeric field. Each pair must produce the same checksum.
+TEST_CASE("Column scans and row access: soa_vector vs array of structs", "[benchmark][soa_vector]") {
+    constexpr std::size_t kRowReads = 2'000'000;
+
+    for (std::size_t n : {std::size_t{1} << 14, std::size_t{1} << 22}) {
+        std::mt19937_64 rng(n);
+        customvector::vector<Quote> quotes;
+        quotes.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double mid = 100.0 + static_cast<double>(rng() % 10000) / 100.0;
+            quotes.push_back(Quote{i, 1'700'000'000'000 + i, mid - 0.01, mid + 0.01, mid,
+                                   static_cast<std::int32_t>(rng() % 2000) - 1000, static_cast<std::uint32_t>(rng()),
+                                   "XNAS"});
+        }
+
+        const auto build_start = std::chrono::steady_clock::now();
+        QuoteColumns columns = customvector::to_soa(quotes, &Quote::id, &Quote::timestamp, &Quote::bid, &Quote::ask,
+                                                    &Quote::last, &Quote::size, &Quote::flags);
+        const double build_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+        customvector::vector<std::size_t> rows;
+        rows.reserve(kRowReads);
+        for (std::size_t i = 0; i < kRowReads; ++i) {
+            rows.push_back(rng() % n);
+        }
+
+        // Best of a few repetitions, in ns per element visited
+        auto time_ns = [](std::size_t elements, auto&& body) {
+            double best = 0;
+            double result = 0;
+            for (int rep = 0; rep < 5; ++rep) {
+                const auto start = std::chrono::steady_clock::now();
+                result = body();
+                const double ns =
+                    std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    static_cast<double>(elements);
+                best = rep == 0 ? ns : std::min(best, ns);
+            }
+            return std::pair{best, result};
+        };
+
+        const auto [aos_sum_ns, aos_sum] = time_ns(n, [&] {
+            double sum = 0;
+            for (const Quote& q : quotes) {
+                sum += q.last;
+            }
+            return sum;
+        });
+        const auto [soa_sum_ns, soa_sum] = time_ns(n, [&] {
+            double sum = 0;
+            for (double last : columns.column<4>()) {
+                sum += last;
+            }
+            return sum;
+        });
+
+        const auto [aos_filter_ns, aos_filter] = time_ns(n, [&] {
+            double notional = 0;
+            for (const Quote& q : quotes) {
+                notional += q.size > 0 ? q.last * q.size : 0.0;
+            }
+            return notional;
+        });
+        const auto [soa_filter_ns, soa_filter] = time_ns(n, [&] {
+            const auto last = columns.column<4>();
+            const auto size = columns.column<5>();
+            double notional = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                notional += size[i] > 0 ? last[i] * size[i] : 0.0;
+            }
+            return notional;
+        });
+
+        const auto [aos_row_ns, aos_rows] = time_ns(kRowReads, [&] {
+            double total = 0;
+            for (std::size_t row : rows) {
+                const Quote& q = quotes[row];
+                total += static_cast<double>(q.id + q.timestamp + q.flags) + q.bid + q.ask + q.last + q.size;
+            }
+            return total;
+        });
+        const auto [soa_row_ns, soa_rows] = time_ns(kRowReads, [&] {
+            double total = 0;
+            for (std::size_t row : rows) {
+                const auto [id, timestamp, bid, ask, last, size, flags] = std::as_const(columns)[row];
+                total += static_cast<double>(id + timestamp + flags) + bid + ask + last + size;
+            }
+            return total;
+        });
+
+        REQUIRE(soa_sum == aos_sum);
+        REQUIRE(soa_filter == aos_filter);
+        REQUIRE(soa_rows == aos_rows);
+
+        std::cout << "\n" << n << " quotes (" << n * sizeof(Quote) / 1024 << " KiB as AoS), to_soa in " << std::fixed
+                  << std::setprecision(1) << build_ms << " ms\n"
+                  << std::setprecision(3)
+                  << "  sum of one field          AoS " << std::setw(7) << aos_sum_ns << " ns/row   SoA "
+                  << std::setw(7) << soa_sum_ns << " ns/row\n"
+                  << "  filtered two-field sum    AoS " << std::setw(7) << aos_filter_ns << " ns/row   SoA "
+                  << std::setw(7) << soa_filter_ns << " ns/row\n"
+                  << "  random whole-row reads    AoS " << std::setw(7) << aos_row_ns << " ns/row   SoA "
+                  << std::setw(7) << soa_row_ns << " ns/row\n";
+    }
+}
@@ -0,0 +1,230 @@
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include "soa_vector.hpp"
+using customvector::soa_vector;
+
+namespace {
+    struct Trade {
+        std::uint64_t id;
+        double price;
+        std::int32_t quantity;
+        char venue[20];
+    };
+
+    // Throws on the copy that brings the live count to the limit
+    struct Fragile {
+        static inline int live = 0;
+        static inline int limit = 1000;
+        int value;
+
+        explicit Fragile(int v) : value(v) { ++live; }
+        Fragile(const Fragile& other) : value(other.value) {
+            if (live + 1 >= limit) {
+                throw std::runtime_error("copy limit");
+            }
+            ++live;
+        }
+        ~Fragile() { --live; }
+    };
+
+    // Checks that every block goes back with the size and alignment it was
+    // allocated with
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations = 0;
+        std::size_t outstanding_bytes = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            outstanding_bytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            outstanding_bytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+}
+
+TEST_CASE("soa_vector push_back fills every column", "[soa_vector]") {
+    soa_vector<int, double, std::string> rows;
+    REQUIRE(rows.empty());
+    for (int i = 0; i < 100; ++i) {
+        rows.push_back(i, i * 0.5, std::to_string(i));
+    }
+
+    REQUIRE(rows.size() == 100);
+    REQUIRE(rows.capacity() >= 100);
+    REQUIRE(rows.column<0>().size() == 100);
+    REQUIRE(std::accumulate(rows.column<0>().begin(), rows.column<0>().end(), 0) == 4950);
+    REQUIRE(rows.column<1>()[10] == 5.0);
+    REQUIRE(rows.column<2>()[99] == "99");
+
+    // Each column starts on its own cache line
+    REQUIRE(reinterpret_cast<std::uintptr_t>(rows.column<0>().data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(rows.column<1>().data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(rows.column<2>().data()) % 64 == 0);
+
+    rows.pop_back();
+    REQUIRE(rows.size() == 99);
+    rows.clear();
+    REQUIRE(rows.empty());
+    REQUIRE_THROWS_AS(rows.pop_back(), std::out_of_range);
+}
+
+TEST_CASE("soa_vector row proxies read and write through to the columns", "[soa_vector]") {
+    soa_vector<int, std::string> rows;
+    rows.push_back(1, "one");
+    rows.push_back(std::tuple<int, std::string>(2, "two"));
+    rows.emplace_back(3, "xxx");
+
+    auto [number, name] = rows[1];
+    REQUIRE(number == 2);
+    number = 20;
+    name += "!";
+    REQUIRE(rows.column<0>()[1] == 20);
+    REQUIRE(rows.column<1>()[1] == "two!");
+    REQUIRE(rows[2].get<1>() == "xxx");
+
+    rows[0] = rows[1];
+    REQUIRE(rows.column<0>()[0] == 20);
+    REQUIRE(rows.column<0>()[1] == 20);
+    rows[1] = std::tuple<int, std::string>(5, "five");
+    REQUIRE(rows.column<1>()[0] == "two!");
+
+    const auto& view = rows;
+    const std::tuple<int, std::string> copy = view.at(1);
+    REQUIRE(copy == std::tuple<int, std::string>(5, "five"));
+    REQUIRE_THROWS_AS(view.at(3), std::out_of_range);
+    REQUIRE_THROWS_AS(rows.at(3), std::out_of_range);
+}
+
+TEST_CASE("soa_vector copies, moves and grows with non-trivial fields", "[soa_vector]") {
+    soa_vector<std::string, std::uint64_t> original;
+    for (int i = 0; i < 1000; ++i) {
+        original.push_back(std::string(30, static_cast<char>('a' + i % 26)), static_cast<std::uint64_t>(i));
+    }
+
+    soa_vector<std::string, std::uint64_t> copy(original);
+    copy.column<1>()[0] = 42;
+    REQUIRE(original.column<1>()[0] == 0);
+    REQUIRE(copy.column<0>()[999] == original.column<0>()[999]);
+
+    soa_vector<std::string, std::uint64_t> moved(std::move(copy));
+    REQUIRE(moved.size() == 1000);
+    REQUIRE(moved.column<1>()[0] == 42);
+
+    copy = moved;
+    moved = std::move(original);
+    REQUIRE(copy.column<1>()[0] == 42);
+    REQUIRE(moved.column<1>()[0] == 0);
+}
+
+TEST_CASE("soa_vector leaves no partial row when a field constructor throws", "[soa_vector]") {
+    Fragile::live = 0;
+    Fragile::limit = 1000;
+    {
+        soa_vector<std::string, Fragile> rows;
+        const Fragile seed(7);
+        for (int i = 0; i < 10; ++i) {
+            rows.push_back("row", seed);
+        }
+
+        Fragile::limit = Fragile::live + 1;
+        REQUIRE_THROWS_AS(rows.push_back("bad", seed), std::runtime_error);
+        REQUIRE(rows.size() == 10);
+        REQUIRE(rows.column<0>().size() == 10);
+
+        // A reallocation that fails part-way keeps the old rows
+        Fragile::limit = Fragile::live + 5;
+        REQUIRE_THROWS_AS(rows.reserve(64), std::runtime_error);
+        REQUIRE(rows.size() == 10);
+        REQUIRE(rows.column<1>()[9].value == 7);
+        REQUIRE(Fragile::live == 11);
+    }
+    REQUIRE(Fragile::live == 0);
+}
+
+TEST_CASE("soa_vector keeps nothrow-moved columns when a later column's copy throws", "[soa_vector]") {
+    // std::string moves nothrow and comes first, so a reallocation that
+    // moved it before copying Fragile would leave the old strings empty
+    Fragile::live = 0;
+    Fragile::limit = 1000;
+    {
+        soa_vector<std::string, Fragile> rows;
+        rows.reserve(8);
+        for (int i = 0; i < 8; ++i) {
+            rows.push_back("a string too long for the small buffer " + std::to_string(i), Fragile(i));
+        }
+
+        Fragile::limit = Fragile::live + 4;
+        REQUIRE_THROWS_AS(rows.reserve(64), std::runtime_error);
+        REQUIRE(rows.size() == 8);
+        REQUIRE(rows.capacity() == 8);
+        REQUIRE(Fragile::live == 8);
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(rows.column<0>()[i] == "a string too long for the small buffer " + std::to_string(i));
+            REQUIRE(rows.column<1>()[i].value == i);
+        }
+
+        Fragile::limit = 1000;
+        rows.reserve(64);
+        REQUIRE(rows.capacity() >= 64);
+        REQUIRE(rows.column<0>()[7] == "a string too long for the small buffer 7");
+        REQUIRE(rows.column<1>()[7].value == 7);
+    }
+    REQUIRE(Fragile::live == 0);
+}
+
+TEST_CASE("to_soa splits records into member columns", "[soa_vector]") {
+    customvector::vector<Trade> trades;
+    for (int i = 0; i < 50; ++i) {
+        trades.push_back(Trade{static_cast<std::uint64_t>(i), i * 1.25, -i, "XNYS"});
+    }
+
+    auto columns = customvector::to_soa(trades, &Trade::id, &Trade::price, &Trade::quantity);
+    static_assert(std::is_same_v<decltype(columns), soa_vector<std::uint64_t, double, std::int32_t>>);
+    REQUIRE(columns.size() == 50);
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        const auto [id, price, quantity] = columns[i];
+        REQUIRE(id == trades[i].id);
+        REQUIRE(price == trades[i].price);
+        REQUIRE(quantity == trades[i].quantity);
+    }
+}
+
+TEST_CASE("soa_vector allocates from a memory resource", "[soa_vector][resource]") {
+    CountingResource resource;
+    {
+        soa_vector<std::uint64_t, double, std::string> rows(&resource);
+        REQUIRE(rows.resource() == &resource);
+        for (int i = 0; i < 100; ++i) {
+            rows.emplace_back(i, i * 0.5, std::to_string(i));
+        }
+        REQUIRE(resource.allocations > 1);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rows.column<2>().data()) % 64 == 0);
+
+        // As with vector: copies use the heap unless given a resource,
+        // copy-assignment keeps the target's resource, moves take the source's
+        soa_vector<std::uint64_t, double, std::string> heap_copy(rows);
+        REQUIRE(heap_copy.resource() == std::pmr::new_delete_resource());
+        soa_vector<std::uint64_t, double, std::string> copy(rows, &resource);
+        REQUIRE(copy.resource() == &resource);
+        REQUIRE(copy[99].get<2>() == "99");
+
+        heap_copy = copy;
+        REQUIRE(heap_copy.resource() == std::pmr::new_delete_resource());
+        heap_copy = std::move(copy);
+        REQUIRE(heap_copy.resource() == &resource);
+        REQUIRE(heap_copy[42].get<0>() == 42);
+    }
+    REQUIRE(resource.outstanding_bytes == 0);
+}
@@ -1,6 +1,11 @@
+#ifndef CUSTOMVECTOR_VECTOR_HPP
+#define CUSTOMVECTOR_VECTOR_HPP
+
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <memory_resource>
 #include <new>
 #include <stdexcept>
 #include <type_traits>
@@ -12,6 +17,14 @@ namespace customvector {
     using std::out_of_range;
     using std::size_t;
 
+    // How a vector gives back a buffer it did not allocate (see adopt):
+    // fn(context) runs once, when the vector frees or outgrows the buffer.
+    // A null fn means the buffer came from the vector's own allocator.
+    struct buffer_release {
+        void (*fn)(void* context) noexcept = nullptr;
+        void* context = nullptr;
+    };
+
     template <typename Element>
         requires destructible<Element>
     class vector {
@@ -23,8 +36,18 @@ namespace customvector {
         vector()
             : data_(allocate(kInitialCapacity)), size_(0), capacity_(kInitialCapacity) {}
 
+        // Takes storage from resource (e.g. an arena::MonotonicArena shared by
+        // a request's containers) instead of ::operator new. The resource
+        // must outlive the vector; copies allocate from the global heap
+        // unless given a resource of their own.
+        explicit vector(std::pmr::memory_resource* resource)
+            : resource_(resource), data_(allocate(kInitialCapacity)), size_(0), capacity_(kInitialCapacity) {}
+
         vector(const vector& other)
-            : data_(allocate(other.capacity_)), size_(0), capacity_(other.capacity_) {
+            : vector(other, nullptr) {}
+
+        vector(const vector& other, std::pmr::memory_resource* resource)
+            : resource_(resource), data_(allocate(other.capacity_)), size_(0), capacity_(other.capacity_) {
             try {
                 for (size_t i = 0; i < other.size_; ++i) {
                     new (data_ + i) Element(other.data_[i]);
@@ -32,23 +55,43 @@ namespace customvector {
                 }
             } catch (...) {
                 destroy_range(data_, size_);
-                ::operator delete(data_);
+                deallocate(data_, capacity_);
                 throw;
             }
         }
 
+        // Moves take the storage together with the resource it came from
         vector(vector&& other) noexcept
-            : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+            : resource_(other.resource_), data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+              release_(other.release_) {
             other.data_ = nullptr;
             other.size_ = 0;
             other.capacity_ = 0;
+            other.release_ = {};
+        }
+
+        // Takes over capacity elements' worth of storage at data, of which
+        // the first size are live elements, without copying: e.g. a payload
+        // received into an mmap'd region or a ring slot. release hands the
+        // buffer back when the vector frees it or grows out of it; until
+        // then the caller must not touch it.
+        [[nodiscard]] static vector adopt(Element* data, size_t size, size_t capacity, buffer_release release)
+            requires is_trivially_copyable
+        {
+            if (size > capacity) {
+                throw std::invalid_argument("customvector::vector::adopt - size exceeds capacity");
+            }
+            if (reinterpret_cast<std::uintptr_t>(data) % alignof(Element) != 0) {
+                throw std::invalid_argument("customvector::vector::adopt - buffer is misaligned");
+            }
+            return vector(data, size, capacity, release);
         }
 
         vector& operator=(const vector& other) {
             if (this == &other) {
                 return *this;
             }
-            vector temp(other);
+            vector temp(other, resource_);
             swap(temp);
             return *this;
         }
@@ -58,19 +101,22 @@ namespace customvector {
                 return *this;
             }
             clear();
-            ::operator delete(data_);
+            release_storage();
+            resource_ = other.resource_;
             data_ = other.data_;
             size_ = other.size_;
             capacity_ = other.capacity_;
+            release_ = other.release_;
             other.data_ = nullptr;
             other.size_ = 0;
             other.capacity_ = 0;
+            other.release_ = {};
             return *this;
         }
 
         ~vector() {
             clear();
-            ::operator delete(data_);
+            release_storage();
         }
 
         void push_back(const Element& element) {
@@ -122,6 +168,24 @@ namespace customvector {
             ++size_;
         }
 
+        void erase(size_t index) {
+            if (index >= size_) {
+                throw out_of_range("customvector::vector::erase - index out of bounds");
+            }
+
+            if constexpr (is_trivially_copyable) {
+                std::memmove(static_cast<void*>(data_ + index),
+                             static_cast<void*>(data_ + index + 1),
+                             (size_ - index - 1) * sizeof(Element));
+            } else {
+                for (size_t i = index; i + 1 < size_; ++i) {
+                    data_[i] = std::move(data_[i + 1]);
+                }
+            }
+            data_[size_ - 1].~Element();
+            --size_;
+        }
+
         [[nodiscard]] constexpr const Element& at(size_t index) const {
             if (index >= size_) {
                 throw out_of_range("customvector::vector::at - index out of bounds");
@@ -176,6 +240,11 @@ namespace customvector {
             return data_;
         }
 
+        // The resource storage comes from; new_delete_resource() for the global heap
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+            return resource_ ? resource_ : std::pmr::new_delete_resource();
+        }
+
         // Clear all elements (public)
         void clear() noexcept {
             destroy_range(data_, size_);
@@ -195,7 +264,7 @@ namespace customvector {
             }
             if (size_ == 0) {
                 destroy_range(data_, size_);
-                ::operator delete(data_);
+                release_storage();
                 data_ = nullptr;
                 capacity_ = 0;
                 return;
@@ -236,6 +305,9 @@ namespace customvector {
         }
 
     private:
+        vector(Element* data, size_t size, size_t capacity, buffer_release release) noexcept
+            : data_(data), size_(size), capacity_(capacity), release_(release) {}
+
         void ensure_capacity_for_append() {
             if (size_ == capacity_) {
                 size_t nextCapacity;
@@ -267,22 +339,44 @@ namespace customvector {
                 }
             } catch (...) {
                 destroy_range(newData, constructed);
-                ::operator delete(newData);
+                deallocate(newData, newCap);
                 throw;
             }
             destroy_range(data_, size_);
-            ::operator delete(data_);
+            release_storage();
             data_ = newData;
             capacity_ = newCap;
         }
 
-        static Element* allocate(size_t count) {
+        Element* allocate(size_t count) const {
             if (count == 0) {
                 return nullptr;
             }
+            if (resource_) {
+                return static_cast<Element*>(resource_->allocate(count * sizeof(Element), alignof(Element)));
+            }
             return static_cast<Element*>(::operator new(count * sizeof(Element)));
         }
 
+        void deallocate(Element* data, size_t count) const noexcept {
+            if (!data) return;
+            if (resource_) {
+                resource_->deallocate(data, count * sizeof(Element), alignof(Element));
+            } else {
+                ::operator delete(data);
+            }
+        }
+
+        // Frees data_ the way it was obtained; the next buffer is our own
+        void release_storage() noexcept {
+            if (release_.fn) {
+                release_.fn(release_.context);
+            } else {
+                deallocate(data_, capacity_);
+            }
+            release_ = {};
+        }
+
         static void destroy_range(Element* data, size_t count) noexcept {
             if (!data) return;
             for (size_t i = count; i > 0; --i) {
@@ -291,13 +385,19 @@ namespace customvector {
         }
 
         void swap(vector& other) noexcept {
+            std::swap(resource_, other.resource_);
             std::swap(data_, other.data_);
             std::swap(size_, other.size_);
             std::swap(capacity_, other.capacity_);
+            std::swap(release_, other.release_);
         }
 
+        std::pmr::memory_resource* resource_ = nullptr;  // null: ::operator new
         Element* data_;
         size_t size_;
         size_t capacity_;
+        buffer_release release_{};
     };
 }
+
+#endif // CUSTOMVECTOR_VECTOR_HPP
@@ -1,4 +1,5 @@
 #include "vector.hpp"
+#include "arena.h"
 #include <catch_amalgamated.hpp>
 #include <algorithm>
 #include <array>
@@ -210,3 +211,43 @@ TEST_CASE("Vector high volume operations", "[benchmark][volume]") {
         return vec.size();
     };
 }
+
+// Request-scoped allocation: each request builds 64 short-lived vectors of
+// 1-16 ints (token lists, small result sets) and drops them. With an arena reset per request the growth
+// reallocations are pointer bumps and nothing is freed one by one.
+
+TEST_CASE("Vector request-scoped allocation", "[benchmark][resource]") {
+    constexpr int kVectors = 64;
+
+    auto request = [](auto make_vector) {
+        size_t total = 0;
+        for (int v = 0; v < kVectors; ++v) {
+            auto vec = make_vector();
+            for (int i = 0; i < 1 + v % 16; ++i) {
+                vec.push_back(i);
+            }
+            total += vec.size();
+        }
+        return total;
+    };
+
+    BENCHMARK("custom::vector, global heap") {
+        return request([] { return customvector::vector<int>(); });
+    };
+
+    arena::MonotonicArena monotonic;
+    BENCHMARK("custom::vector, MonotonicArena reset per request") {
+        const size_t total = request([&] { return customvector::vector<int>(&monotonic); });
+        monotonic.reset();
+        return total;
+    };
+
+    arena::SizeClassPool pool;
+    BENCHMARK("custom::vector, SizeClassPool") {
+        return request([&] { return customvector::vector<int>(&pool); });
+    };
+
+    BENCHMARK("std::vector, global heap") {
+        return request([] { return std::vector<int>(); });
+    };
+}
@@ -1,6 +1,7 @@
 #include <catch_amalgamated.hpp>
 #include <string>
 #include "vector.hpp"
+#include "arena.h"
 using customvector::vector;
 
 TEST_CASE("push_back grows capacity and stores values", "[vector]") {
@@ -177,6 +178,25 @@ TEST_CASE("insert adds elements at specified positions", "[vector]") {
     REQUIRE_THROWS_AS(values.insert(values.size() + 1, 99), std::out_of_range);
 }
 
+TEST_CASE("erase removes elements and shifts the tail down", "[vector]") {
+    vector<std::string> words;
+    for (const char* word : {"alpha", "beta", "gamma", "delta"}) {
+        words.push_back(word);
+    }
+
+    words.erase(1);
+    REQUIRE(words.size() == 3);
+    REQUIRE(words.at(0) == "alpha");
+    REQUIRE(words.at(1) == "gamma");
+    REQUIRE(words.at(2) == "delta");
+
+    words.erase(words.size() - 1);
+    REQUIRE(words.size() == 2);
+    REQUIRE(words.at(1) == "gamma");
+
+    REQUIRE_THROWS_AS(words.erase(2), std::out_of_range);
+}
+
 namespace {
     struct MoveOnly {
         explicit MoveOnly(int v) : value(v) {}
@@ -200,3 +220,76 @@ TEST_CASE("emplace constructs elements in place", "[vector][emplace]") {
     REQUIRE(values.at(0).value == 7);
     REQUIRE(values.at(1).value == 42);
 }
+
+TEST_CASE("adopt takes over an external buffer and releases it once", "[vector][adopt]") {
+    static int releases = 0;
+    releases = 0;
+    alignas(int) static int storage[4] = {1, 2, 3, 0};
+    auto release = +[](void* context) noexcept {
+        REQUIRE(context == storage);
+        ++releases;
+    };
+
+    {
+        auto adopted = vector<int>::adopt(storage, 3, 4, {release, storage});
+        REQUIRE(adopted.data() == storage);
+        REQUIRE(adopted.size() == 3);
+        adopted.push_back(4);
+        REQUIRE(storage[3] == 4);
+
+        // Outgrowing the buffer moves into owned storage and releases it
+        adopted.push_back(5);
+        REQUIRE(releases == 1);
+        REQUIRE(adopted.data() != storage);
+        REQUIRE(adopted.at(3) == 4);
+    }
+    REQUIRE(releases == 1);
+
+    {
+        auto adopted = vector<int>::adopt(storage, 2, 4, {release, storage});
+        vector<int> moved(std::move(adopted));
+        vector<int> copy(moved);
+        REQUIRE(copy.data() != storage);
+        REQUIRE(releases == 1);
+    }
+    REQUIRE(releases == 2);
+
+    REQUIRE_THROWS_AS(vector<int>::adopt(storage, 5, 4, {}), std::invalid_argument);
+    auto* misaligned = reinterpret_cast<int*>(reinterpret_cast<char*>(storage) + 1);
+    REQUIRE_THROWS_AS(vector<int>::adopt(misaligned, 0, 1, {}), std::invalid_argument);
+}
+
+TEST_CASE("vector allocates from a memory resource", "[vector][resource]") {
+    arena::MonotonicArena arena;
+    {
+        vector<std::string> names(&arena);
+        REQUIRE(names.resource() == &arena);
+        for (int i = 0; i < 100; ++i) {
+            names.push_back("name-" + std::to_string(i));
+        }
+        REQUIRE(arena.bytes_used() >= names.capacity() * sizeof(std::string));
+
+        // A plain copy goes to the heap; a copy given the arena stays in it
+        vector<std::string> heap_copy(names);
+        REQUIRE(heap_copy.resource() == std::pmr::new_delete_resource());
+        vector<std::string> arena_copy(names, &arena);
+        REQUIRE(arena_copy.resource() == &arena);
+        REQUIRE(arena_copy.at(99) == "name-99");
+
+        // Copy-assignment keeps the target's resource, moves take the source's
+        heap_copy = arena_copy;
+        REQUIRE(heap_copy.resource() == std::pmr::new_delete_resource());
+        REQUIRE(heap_copy.at(42) == "name-42");
+        vector<std::string> moved(std::move(arena_copy));
+        REQUIRE(moved.resource() == &arena);
+        heap_copy = std::move(moved);
+        REQUIRE(heap_copy.resource() == &arena);
+        REQUIRE(heap_copy.size() == 100);
+
+        names.shrinkToFit();
+        REQUIRE(names.capacity() == 100);
+        REQUIRE(names.resource() == &arena);
+    }
+    arena.reset();
+    REQUIRE(arena.bytes_used() == 0);
+}
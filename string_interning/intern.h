@@ -0,0 +1,409 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace intern {
+
+// ============================================================================
+// String Interning
+// ============================================================================
+//
+// A Pool stores each distinct string once and hands out Symbols: a pointer
+// to the arena copy, a dense 32-bit id and the string's 32-bit hash, 16
+// bytes in all. Two Symbols are equal exactly when they point at the same
+// copy, so a table keyed by Symbol compares one word and never rehashes
+// the text; std::hash<Symbol> returns the stored hash.
+//
+// The pool is split into 16 shards by the top bits of the hash. A shard
+// owns a bump arena for the text and a Robin Hood index of 8-byte slots
+// (hash << 32 | id + 1); writers take the shard's mutex, readers take no
+// lock. As in ConcurrentRobinHoodTable, writers bump a sequence counter
+// around displacement and a reader whose probe overlapped one retries.
+// When an index grows, the old array stays alive until the pool is
+// destroyed, since a reader may still be walking it; the arrays given up
+// this way add up to less than the live one.
+//
+// Strings are never removed: a Symbol, its text and its id stay valid for
+// the lifetime of the pool.
+
+#if defined(__APPLE__) && defined(__aarch64__)
+inline constexpr size_t CACHE_LINE_SIZE = 128;
+#else
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+// 32-bit string hash shared by the pool and Symbol's consumers
+inline uint32_t hash_text(std::string_view text) noexcept {
+    const uint64_t h = std::hash<std::string_view>{}(text);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+class Pool;
+
+class Symbol {
+public:
+    // The empty handle: an empty view, and unequal to every interned
+    // string (including an interned "")
+    Symbol() = default;
+
+    [[nodiscard]] uint32_t id() const noexcept { return id_; }
+    [[nodiscard]] uint32_t hash() const noexcept { return hash_; }
+
+    [[nodiscard]] size_t size() const noexcept {
+        if (data_ == nullptr) return 0;
+        uint32_t size;
+        std::memcpy(&size, data_ - sizeof(uint32_t), sizeof(uint32_t));
+        return size;
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept { return {c_str(), size()}; }
+
+    // The arena copy is NUL-terminated
+    [[nodiscard]] const char* c_str() const noexcept { return data_ == nullptr ? "" : data_; }
+
+    friend bool operator==(Symbol a, Symbol b) noexcept { return a.data_ == b.data_; }
+
+private:
+    friend class Pool;
+    Symbol(const char* data, uint32_t id, uint32_t hash) noexcept : data_(data), id_(id), hash_(hash) {}
+
+    const char* data_ = nullptr;
+    uint32_t id_ = 0;
+    uint32_t hash_ = 0;
+};
+
+static_assert(sizeof(Symbol) == 16);
+
+class Pool {
+public:
+    static constexpr size_t SHARDS = 16;
+    // Ids run from 0 to MAX_SYMBOLS - 1, so id + 1 fits a slot's low word
+    static constexpr uint32_t MAX_SYMBOLS = UINT32_MAX;
+
+    Pool() = default;
+    ~Pool();
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // The Symbol for text, adding it if it is new. Safe to call from any
+    // thread; a string already present is found without taking a lock.
+    [[nodiscard]] Symbol intern(std::string_view text);
+
+    // The Symbol for text if it has been interned; never adds
+    [[nodiscard]] std::optional<Symbol> find(std::string_view text) const noexcept {
+        const uint32_t hash = hash_text(text);
+        const uint32_t id = lookup(shard_of(hash), text, hash);
+        if (id == NONE) return std::nullopt;
+        return symbol_at(id);
+    }
+
+    // The Symbol with a given id. The id must come from a Symbol of this
+    // pool (or be below size() once every intern() call has returned).
+    [[nodiscard]] Symbol operator[](uint32_t id) const noexcept { return symbol_at(id); }
+
+    [[nodiscard]] Symbol at(uint32_t id) const {
+        if (id >= size()) {
+            throw std::out_of_range("intern::Pool::at - id out of range");
+        }
+        return symbol_at(id);
+    }
+
+    // Includes strings being added by other threads right now
+    [[nodiscard]] size_t size() const noexcept { return next_id_.load(std::memory_order_acquire); }
+
+    // Arena blocks, index arrays (live and outgrown) and the id directory
+    [[nodiscard]] size_t memory_bytes() const;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr unsigned SHARD_SHIFT = 28;
+    static constexpr size_t INITIAL_SLOTS = 64;
+    static constexpr size_t ARENA_FIRST_BLOCK = 4 * 1024;
+    static constexpr size_t ARENA_BLOCK = 64 * 1024;
+    // Directory segment s holds DIRECTORY_BASE << s symbols; 23 segments
+    // cover every 32-bit id
+    static constexpr size_t DIRECTORY_BASE = 1024;
+    static constexpr size_t DIRECTORY_SEGMENTS = 23;
+
+    // Each record is a 4-byte length, the bytes and a NUL, 4-byte aligned.
+    // Strings too long for a quarter block get a block of their own, so
+    // the current block is not abandoned half empty.
+    class Arena {
+    public:
+        const char* store(std::string_view text) {
+            const size_t record = (sizeof(uint32_t) + text.size() + 1 + 3) & ~size_t{3};
+            char* place;
+            if (record > ARENA_BLOCK / 4) {
+                place = new_block(record);
+            } else {
+                if (record > static_cast<size_t>(end_ - cursor_)) {
+                    // Blocks double from 4 KiB, so a small pool stays small
+                    const size_t block = std::max(std::clamp(bytes_, ARENA_FIRST_BLOCK, ARENA_BLOCK), record);
+                    cursor_ = new_block(block);
+                    end_ = cursor_ + block;
+                }
+                place = cursor_;
+                cursor_ += record;
+            }
+            const auto size = static_cast<uint32_t>(text.size());
+            std::memcpy(place, &size, sizeof(uint32_t));
+            char* data = place + sizeof(uint32_t);
+            std::memcpy(data, text.data(), text.size());
+            data[text.size()] = '\0';
+            return data;
+        }
+
+        size_t bytes() const noexcept { return bytes_; }
+
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        char* cursor_ = nullptr;
+        char* end_ = nullptr;
+        size_t bytes_ = 0;
+
+        char* new_block(size_t size) {
+            auto block = std::make_unique_for_overwrite<char[]>(size);
+            char* start = block.get();
+            blocks_.push_back(std::move(block));
+            bytes_ += size;
+            return start;
+        }
+    };
+
+    // Slot: hash << 32 | (id + 1), or 0 when empty. The home bucket comes
+    // from the low bits of the hash; the shard already used the top bits.
+    struct Index {
+        explicit Index(size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<uint64_t>[capacity]{}) {}
+
+        size_t mask;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        size_t size = 0;
+
+        size_t capacity() const noexcept { return mask + 1; }
+        size_t distance_at(uint64_t slot, size_t idx) const noexcept {
+            return (idx - static_cast<size_t>(slot >> 32)) & mask;
+        }
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> version{0};
+        std::atomic<Index*> index{nullptr};
+        // Writers only from here on
+        mutable std::mutex write_mutex;
+        Arena arena;
+        std::vector<std::unique_ptr<Index>> indexes;
+    };
+
+    std::array<Shard, SHARDS> shards_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> next_id_{0};
+    std::array<std::atomic<Symbol*>, DIRECTORY_SEGMENTS> directory_{};
+
+    static size_t segment_of(uint32_t id) noexcept {
+        return static_cast<size_t>(std::bit_width(id / DIRECTORY_BASE + 1)) - 1;
+    }
+    static size_t segment_first(size_t segment) noexcept { return ((size_t{1} << segment) - 1) * DIRECTORY_BASE; }
+
+    Shard& shard_of(uint32_t hash) noexcept { return shards_[hash >> SHARD_SHIFT]; }
+    const Shard& shard_of(uint32_t hash) const noexcept { return shards_[hash >> SHARD_SHIFT]; }
+
+    Symbol symbol_at(uint32_t id) const noexcept {
+        const size_t segment = segment_of(id);
+        return directory_[segment].load(std::memory_order_acquire)[id - segment_first(segment)];
+    }
+
+    uint32_t probe(const Index& index, std::string_view text, uint32_t hash) const noexcept;
+    uint32_t lookup(const Shard& shard, std::string_view text, uint32_t hash) const noexcept;
+    uint32_t reserve_id();
+    void publish(Symbol symbol);
+    Index& grow(Shard& shard);
+    static void insert(Index& index, uint64_t slot) noexcept;
+
+    static void begin_write(Shard& shard) noexcept {
+        shard.version.store(shard.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    static void end_write(Shard& shard) noexcept {
+        shard.version.store(shard.version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+inline Pool::~Pool() {
+    for (auto& segment : directory_) delete[] segment.load(std::memory_order_relaxed);
+}
+
+// A slot value may be seen mid-displacement, but every value ever stored is
+// a published (hash, id), so the directory lookup is always valid; the walk
+// is bounded so the caller's version check can reject a torn run
+inline uint32_t Pool::probe(const Index& index, std::string_view text, uint32_t hash) const noexcept {
+    size_t idx = hash & index.mask;
+    for (size_t distance = 0; distance <= index.mask; ++distance) {
+        const uint64_t slot = index.slots[idx].load(std::memory_order_acquire);
+        if (slot == 0 || distance > index.distance_at(slot, idx)) {
+            return NONE;
+        }
+        if (static_cast<uint32_t>(slot >> 32) == hash) {
+            const auto id = static_cast<uint32_t>(slot) - 1;
+            if (symbol_at(id).view() == text) return id;
+        }
+        idx = (idx + 1) & index.mask;
+    }
+    return NONE;
+}
+
+inline uint32_t Pool::lookup(const Shard& shard, std::string_view text, uint32_t hash) const noexcept {
+    while (true) {
+        const uint64_t before = shard.version.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        const Index* index = shard.index.load(std::memory_order_acquire);
+        const uint32_t id = index == nullptr ? NONE : probe(*index, text, hash);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.version.load(std::memory_order_relaxed) == before) {
+            return id;
+        }
+    }
+}
+
+inline Symbol Pool::intern(std::string_view text) {
+    const uint32_t hash = hash_text(text);
+    Shard& shard = shard_of(hash);
+    if (const uint32_t id = lookup(shard, text, hash); id != NONE) {
+        return symbol_at(id);
+    }
+
+    std::lock_guard lock(shard.write_mutex);
+    Index* index = shard.index.load(std::memory_order_relaxed);
+    if (index != nullptr) {
+        if (const uint32_t id = probe(*index, text, hash); id != NONE) return symbol_at(id);
+    }
+    if (text.size() > UINT32_MAX - 8) {
+        throw std::length_error("intern::Pool::intern - string too long");
+    }
+    // Grow first, so a failed allocation leaves the index as it was
+    if (index == nullptr || (index->size + 1) * 8 > index->capacity() * 7) {
+        index = &grow(shard);
+    }
+    const char* data = shard.arena.store(text);
+    const Symbol symbol(data, reserve_id(), hash);
+    publish(symbol);
+
+    begin_write(shard);
+    insert(*index, static_cast<uint64_t>(hash) << 32 | (static_cast<uint64_t>(symbol.id()) + 1));
+    end_write(shard);
+    return symbol;
+}
+
+inline uint32_t Pool::reserve_id() {
+    uint32_t id = next_id_.load(std::memory_order_relaxed);
+    do {
+        if (id == MAX_SYMBOLS) {
+            throw std::length_error("intern::Pool::intern - out of 32-bit ids");
+        }
+    } while (!next_id_.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+    return id;
+}
+
+// Shards allocate directory segments concurrently; the loser of the race
+// frees its copy. Entries are written once, before the slot that leads to
+// them is stored with release.
+inline void Pool::publish(Symbol symbol) {
+    const size_t segment = segment_of(symbol.id());
+    Symbol* entries = directory_[segment].load(std::memory_order_acquire);
+    if (entries == nullptr) {
+        auto* fresh = new Symbol[DIRECTORY_BASE << segment];
+        if (directory_[segment].compare_exchange_strong(entries, fresh, std::memory_order_acq_rel)) {
+            entries = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    entries[symbol.id() - segment_first(segment)] = symbol;
+}
+
+// Fills a fresh array off to the side and swaps it in with one store, so
+// readers need no retry; the old array stays readable
+inline Pool::Index& Pool::grow(Shard& shard) {
+    Index* old = shard.index.load(std::memory_order_relaxed);
+    auto fresh = std::make_unique<Index>(old == nullptr ? INITIAL_SLOTS : old->capacity() * 2);
+    if (old != nullptr) {
+        for (size_t i = 0; i < old->capacity(); ++i) {
+            const uint64_t slot = old->slots[i].load(std::memory_order_relaxed);
+            if (slot != 0) insert(*fresh, slot);
+        }
+    }
+    Index* index = fresh.get();
+    shard.indexes.push_back(std::move(fresh));
+    shard.index.store(index, std::memory_order_release);
+    return *index;
+}
+
+inline void Pool::insert(Index& index, uint64_t slot) noexcept {
+    size_t idx = static_cast<size_t>(slot >> 32) & index.mask;
+    size_t distance = 0;
+    while (true) {
+        const uint64_t resident = index.slots[idx].load(std::memory_order_relaxed);
+        if (resident == 0) {
+            index.slots[idx].store(slot, std::memory_order_release);
+            break;
+        }
+        const size_t resident_distance = index.distance_at(resident, idx);
+        if (distance > resident_distance) {
+            index.slots[idx].store(slot, std::memory_order_release);
+            slot = resident;
+            distance = resident_distance;
+        }
+        idx = (idx + 1) & index.mask;
+        ++distance;
+    }
+    ++index.size;
+}
+
+inline size_t Pool::memory_bytes() const {
+    size_t bytes = sizeof(Pool);
+    for (const Shard& shard : shards_) {
+        std::lock_guard lock(shard.write_mutex);
+        bytes += shard.arena.bytes();
+        for (const auto& index : shard.indexes) bytes += index->capacity() * sizeof(uint64_t);
+    }
+    for (size_t segment = 0; segment < DIRECTORY_SEGMENTS; ++segment) {
+        if (directory_[segment].load(std::memory_order_acquire) != nullptr) {
+            bytes += (DIRECTORY_BASE << segment) * sizeof(Symbol);
+        }
+    }
+    return bytes;
+}
+
+// Process-wide pool, for caches that should share one set of symbols
+inline Pool& default_pool() {
+    static auto* pool = new Pool;
+    return *pool;
+}
+
+} // namespace intern
+
+template<>
+struct std::hash<intern::Symbol> {
+    size_t operator()(intern::Symbol symbol) const noexcept { return symbol.hash(); }
+};
+
+#endif // INTERN_H
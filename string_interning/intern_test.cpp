@@ -0,0 +1,194 @@
+#include "intern.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace intern;
+
+namespace {
+
+std::string key_name(size_t i) {
+    return "/api/v2/accounts/" + std::to_string(i * 7919 % 1000003) + "/positions";
+}
+
+} // namespace
+
+TEST_CASE("Interning returns one Symbol per distinct string", "[intern]") {
+    Pool pool;
+    const Symbol a = pool.intern("AAPL");
+    const Symbol b = pool.intern("MSFT");
+    const Symbol again = pool.intern(std::string("AAPL"));
+
+    REQUIRE(a == again);
+    REQUIRE(a != b);
+    REQUIRE(a.id() == 0);
+    REQUIRE(b.id() == 1);
+    REQUIRE(a.view() == "AAPL");
+    REQUIRE(std::string(b.c_str()) == "MSFT");
+    REQUIRE(a.hash() == hash_text("AAPL"));
+    REQUIRE(std::hash<Symbol>{}(a) == a.hash());
+    REQUIRE(pool.size() == 2);
+
+    REQUIRE(pool[1] == b);
+    REQUIRE(pool.at(0) == a);
+    REQUIRE_THROWS_AS(pool.at(2), std::out_of_range);
+}
+
+TEST_CASE("find never adds", "[intern]") {
+    Pool pool;
+    REQUIRE_FALSE(pool.find("absent").has_value());
+    REQUIRE(pool.size() == 0);
+
+    const Symbol s = pool.intern("present");
+    REQUIRE(pool.find("present") == s);
+    REQUIRE_FALSE(pool.find("presen").has_value());
+    REQUIRE(pool.size() == 1);
+}
+
+TEST_CASE("Empty, embedded-NUL and long strings", "[intern]") {
+    Pool pool;
+    const Symbol empty = pool.intern("");
+    REQUIRE(empty.view().empty());
+    REQUIRE(empty != Symbol{});
+    REQUIRE(Symbol{}.view().empty());
+    REQUIRE(std::string(Symbol{}.c_str()).empty());
+
+    const std::string with_nul("a\0b", 3);
+    const Symbol nul = pool.intern(with_nul);
+    REQUIRE(nul.size() == 3);
+    REQUIRE(nul.view() == with_nul);
+    REQUIRE(nul != pool.intern("a"));
+
+    const std::string long_text(100'000, 'x');
+    const Symbol big = pool.intern(long_text);
+    REQUIRE(big.view() == long_text);
+    REQUIRE(pool.intern(long_text) == big);
+}
+
+TEST_CASE("Symbols stay valid while the index grows", "[intern]") {
+    Pool pool;
+    constexpr size_t kStrings = 100'000;
+    std::vector<Symbol> symbols;
+    for (size_t i = 0; i < kStrings; ++i) {
+        symbols.push_back(pool.intern(key_name(i)));
+        REQUIRE(symbols.back().id() == i);
+    }
+    REQUIRE(pool.size() == kStrings);
+    for (size_t i = 0; i < kStrings; ++i) {
+        const std::string name = key_name(i);
+        REQUIRE(symbols[i].view() == name);
+        REQUIRE(pool.intern(name) == symbols[i]);
+        REQUIRE(pool[static_cast<uint32_t>(i)] == symbols[i]);
+    }
+
+    std::unordered_set<Symbol> set(symbols.begin(), symbols.end());
+    REQUIRE(set.size() == kStrings);
+}
+
+TEST_CASE("Concurrent writers agree on every Symbol", "[intern]") {
+    Pool pool;
+    constexpr size_t kThreads = 4;
+    constexpr size_t kStrings = 20'000;
+    std::vector<std::vector<Symbol>> seen(kThreads, std::vector<Symbol>(kStrings));
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            // Every thread interns the same strings, starting at different points
+            for (size_t n = 0; n < kStrings; ++n) {
+                const size_t i = (n + t * kStrings / kThreads) % kStrings;
+                seen[t][i] = pool.intern(key_name(i));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(pool.size() == kStrings);
+    std::vector<bool> ids(kStrings, false);
+    for (size_t i = 0; i < kStrings; ++i) {
+        for (size_t t = 1; t < kThreads; ++t) REQUIRE(seen[t][i] == seen[0][i]);
+        REQUIRE(seen[0][i].view() == key_name(i));
+        REQUIRE(seen[0][i].id() < kStrings);
+        ids[seen[0][i].id()] = true;
+    }
+    REQUIRE(std::all_of(ids.begin(), ids.end(), [](bool used) { return used; }));
+}
+
+TEST_CASE("Readers never miss a published string during inserts", "[intern]") {
+    Pool pool;
+    constexpr size_t kStrings = 50'000;
+    std::atomic<size_t> published{0};
+    std::atomic<bool> done{false};
+    std::atomic<size_t> misses{0};
+
+    std::thread reader([&] {
+        size_t i = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            const size_t limit = published.load(std::memory_order_acquire);
+            if (limit == 0) continue;
+            i = (i + 7) % limit;
+            auto found = pool.find(key_name(i));
+            if (!found || found->view() != key_name(i)) misses.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (size_t i = 0; i < kStrings; ++i) {
+        (void)pool.intern(key_name(i));
+        published.store(i + 1, std::memory_order_release);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    REQUIRE(misses.load() == 0);
+}
+
+TEST_CASE("String interning costs", "[benchmark]") {
+    constexpr size_t kStrings = 1'000'000;
+    std::vector<std::string> names;
+    names.reserve(kStrings);
+    size_t text_bytes = 0;
+    for (size_t i = 0; i < kStrings; ++i) {
+        names.push_back(key_name(i));
+        text_bytes += names.back().size();
+    }
+
+    auto ns_per = [](auto start, size_t count) {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    };
+
+    Pool pool;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& name : names) (void)pool.intern(name);
+    const double miss_ns = ns_per(start, kStrings);
+
+    uint64_t sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& name : names) sink += pool.intern(name).id();
+    const double hit_ns = ns_per(start, kStrings);
+
+    std::unordered_set<std::string> strings;
+    start = std::chrono::steady_clock::now();
+    for (const auto& name : names) strings.insert(name);
+    const double set_insert_ns = ns_per(start, kStrings);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& name : names) sink += strings.find(name)->size();
+    const double set_find_ns = ns_per(start, kStrings);
+    REQUIRE(sink > 0);
+
+    std::cout << "\nString interning, " << kStrings << " strings of " << std::fixed << std::setprecision(1)
+              << static_cast<double>(text_bytes) / kStrings << " bytes on average\n";
+    std::cout << "                        Pool   unordered_set<string>\n";
+    std::cout << "  insert (ns)     " << std::setw(12) << miss_ns << std::setw(12) << set_insert_ns << "\n";
+    std::cout << "  find (ns)       " << std::setw(12) << hit_ns << std::setw(12) << set_find_ns << "\n";
+    std::cout << "  bytes/string    " << std::setw(12)
+              << static_cast<double>(pool.memory_bytes()) / kStrings << "\n";
+}